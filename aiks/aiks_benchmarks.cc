@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "impeller/aiks/canvas.h"
+#include "impeller/geometry/path_builder.h"
+
+// Every heap allocation made by the benchmarks is counted.
+static std::atomic_size_t gHeapAllocations = 0u;
+
+void* operator new(size_t size) {
+  gHeapAllocations.fetch_add(1u, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size == 0u ? 1u : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+  std::free(ptr);
+}
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// Records a picture of rectangles, circles and clips with a mix of paints and
+/// transformations, like a list of widgets. Reports the draws recorded per
+/// second and how many heap allocations each draw still makes.
+///
+static void BM_CanvasRecording(benchmark::State& state) {
+  const auto draw_count = static_cast<size_t>(state.range(0));
+  size_t heap_allocations = 0u;
+  size_t arena_allocations = 0u;
+  size_t arena_bytes = 0u;
+  for (auto _ : state) {
+    const auto heap_allocations_before = gHeapAllocations.load();
+
+    Canvas canvas;
+    Paint paint;
+    for (size_t i = 0; i < draw_count; i++) {
+      canvas.Save();
+      canvas.Translate({static_cast<Scalar>(i % 16u) * 16, 0});
+      paint.color = i % 2u == 0u ? Color::Red() : Color::Blue();
+      paint.style = i % 3u == 0u ? Paint::Style::kStroke : Paint::Style::kFill;
+      paint.stroke_width = 2.0f;
+      switch (i % 4u) {
+        case 0u:
+          canvas.ClipPath(
+              PathBuilder{}.AddRoundedRect(Rect(0, 0, 16, 16), 4).TakePath());
+          canvas.DrawRect(Rect(0, 0, 16, 16), paint);
+          break;
+        case 1u:
+          canvas.DrawCircle({8, 8}, 8, paint);
+          break;
+        default:
+          canvas.DrawRect(Rect(0, 0, 16, 16), paint);
+          break;
+      }
+      canvas.Restore();
+    }
+    auto picture = canvas.EndRecordingAsPicture();
+
+    heap_allocations = gHeapAllocations.load() - heap_allocations_before;
+    arena_allocations = picture.arena->GetAllocationCount();
+    arena_bytes = picture.arena->GetBytesAllocated();
+    benchmark::DoNotOptimize(picture);
+  }
+  state.SetItemsProcessed(state.iterations() * draw_count);
+
+  state.counters["heap_allocations_per_draw"] =
+      static_cast<double>(heap_allocations) / draw_count;
+  state.counters["arena_allocations_per_draw"] =
+      static_cast<double>(arena_allocations) / draw_count;
+  state.counters["arena_bytes_per_draw"] =
+      static_cast<double>(arena_bytes) / draw_count;
+}
+
+BENCHMARK(BM_CanvasRecording)->Arg(100)->Arg(1000)->Arg(10000);
+
+}  // namespace impeller
@@ -4,7 +4,9 @@
 
 #include "impeller/aiks/aiks_context.h"
 
+#include "impeller/aiks/baked_picture.h"
 #include "impeller/aiks/picture.h"
+#include "impeller/renderer/render_pass.h"
 
 namespace impeller {
 
@@ -40,4 +42,45 @@ bool AiksContext::Render(const Picture& picture, RenderPass& parent_pass) {
   return true;
 }
 
+bool AiksContext::Render(const Picture& picture,
+                         const Picture& previous,
+                         RenderPass& parent_pass) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  const auto& attachments = parent_pass.GetRenderTarget().GetColorAttachments();
+  const auto color0 = attachments.find(0u);
+  if (color0 == attachments.end() ||
+      color0->second.load_action != LoadAction::kLoad) {
+    return Render(picture, parent_pass);
+  }
+
+  if (!picture.pass) {
+    return true;
+  }
+
+  const auto damage =
+      picture.ComputeDamage(previous, parent_pass.GetRenderTargetSize());
+  if (damage.empty()) {
+    return true;
+  }
+  return picture.pass->Render(*content_context_, parent_pass, damage);
+}
+
+std::shared_ptr<BakedPicture> AiksContext::Bake(const Picture& picture,
+                                                const RenderTarget& target) {
+  if (!IsValid()) {
+    return nullptr;
+  }
+  return BakedPicture::Make(*content_context_, picture, target);
+}
+
+void AiksContext::EndFrame() {
+  if (!IsValid()) {
+    return;
+  }
+  content_context_->EndFrame();
+}
+
 }  // namespace impeller
@@ -13,7 +13,9 @@
 namespace impeller {
 
 struct Picture;
+class BakedPicture;
 class RenderPass;
+class RenderTarget;
 
 class AiksContext {
  public:
@@ -25,6 +27,37 @@ class AiksContext {
 
   bool Render(const Picture& picture, RenderPass& parent_pass);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Render the picture, repainting only the regions in which it
+  ///             differs from the previous picture.
+  ///
+  ///             The parent pass must load the contents the previous picture
+  ///             rendered into its render target. If its color attachment is
+  ///             not loaded, the picture is rendered in full instead. Frames
+  ///             that were not complete (see `FrameStats::IsComplete`) may
+  ///             lack parts of their picture and must be rendered in full.
+  ///
+  bool Render(const Picture& picture,
+              const Picture& previous,
+              RenderPass& parent_pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Compile the picture into commands that can be rendered again
+  ///             without walking its passes and entities.
+  ///
+  /// @see        `BakedPicture`
+  ///
+  std::shared_ptr<BakedPicture> Bake(const Picture& picture,
+                                     const RenderTarget& target);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame. Call it exactly once per frame, after
+  ///             all pictures of the frame were rendered.
+  ///
+  /// @see        `ContentContext::EndFrame`
+  ///
+  void EndFrame();
+
  private:
   std::shared_ptr<Context> context_;
   std::unique_ptr<ContentContext> content_context_;
@@ -25,7 +25,11 @@ bool AiksPlayground::OpenPlaygroundHere(const Picture& picture) {
 
   return Playground::OpenPlaygroundHere(
       [&renderer, &picture](RenderPass& pass) -> bool {
-        return renderer.Render(picture, pass);
+        if (!renderer.Render(picture, pass)) {
+          return false;
+        }
+        renderer.EndFrame();
+        return true;
       });
 }
 
@@ -3,11 +3,18 @@
 // found in the LICENSE file.
 
 #include "flutter/testing/testing.h"
+#include "impeller/aiks/aiks_context.h"
 #include "impeller/aiks/aiks_playground.h"
+#include "impeller/aiks/baked_picture.h"
 #include "impeller/aiks/canvas.h"
 #include "impeller/aiks/image.h"
+#include "impeller/entity/native_shaders_sw.h"
 #include "impeller/geometry/geometry_unittests.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/backend/software/context_sw.h"
+#include "impeller/renderer/backend/software/texture_sw.h"
+#include "impeller/renderer/renderer.h"
+#include "impeller/renderer/surface.h"
 
 namespace impeller {
 namespace testing {
@@ -39,6 +46,532 @@ TEST_F(AiksTest, CanvasCanPushPopCTM) {
                      Matrix::MakeTranslation({100.0, 100.0, 0.0}));
 }
 
+TEST_F(AiksTest, CanvasDropsEntitiesOutsideClip) {
+  Canvas canvas;
+  Paint paint;
+  canvas.Translate(Size{100, 100});
+  canvas.ClipPath(PathBuilder{}.AddRect(Rect(0, 0, 50, 50)).TakePath());
+  // Inside, straddling and outside the clip.
+  canvas.DrawRect(Rect(10, 10, 10, 10), paint);
+  canvas.DrawRect(Rect(40, 40, 20, 20), paint);
+  canvas.DrawRect(Rect(60, 0, 10, 10), paint);
+  canvas.Save();
+  canvas.ClipPath(PathBuilder{}.AddRect(Rect(100, 100, 10, 10)).TakePath());
+  // Nothing is visible through disjoint clips.
+  canvas.DrawRect(Rect(10, 10, 10, 10), paint);
+  ASSERT_TRUE(canvas.Restore());
+  canvas.DrawRect(Rect(20, 20, 10, 10), paint);
+
+  auto picture = canvas.EndRecordingAsPicture();
+  // Three of the five draws. The rectangular clips become scissors.
+  ASSERT_EQ(picture.pass->GetEntities().size(), 3u);
+}
+
+TEST_F(AiksTest, RectClipsBecomeScissors) {
+  Canvas canvas;
+  Paint paint;
+  canvas.Translate(Size{10.2, 10});
+  canvas.Scale(Vector3{2, 2});
+  canvas.ClipPath(PathBuilder{}.AddRect(Rect(0, 0, 50, 50)).TakePath());
+  canvas.ClipPath(PathBuilder{}.AddRect(Rect(25, 0, 50, 25)).TakePath());
+  canvas.DrawRect(Rect(0, 0, 100, 100), paint);
+  canvas.Rotate(Degrees{45});
+  // Rotated rectangles still need the stencil.
+  const auto large = Rect(-1000, -1000, 2000, 2000);
+  canvas.ClipPath(PathBuilder{}.AddRect(large).TakePath());
+  canvas.DrawRect(large, paint);
+
+  auto picture = canvas.EndRecordingAsPicture();
+  const auto& entities = picture.pass->GetEntities();
+  ASSERT_EQ(entities.size(), 3u);
+  const auto expected_scissor = IRect::MakeLTRB(70, 20, 120, 70);
+  for (const auto& entity : entities) {
+    ASSERT_TRUE(entity.GetScissor().has_value());
+    ASSERT_EQ(entity.GetScissor().value(), expected_scissor);
+  }
+  ASSERT_EQ(entities[0].GetStencilDepth(), 0u);
+  ASSERT_EQ(entities[2].GetStencilDepth(), 1u);
+}
+
+TEST_F(AiksTest, DrawingAPictureRecordsAReference) {
+  Canvas canvas;
+  Paint paint;
+  for (size_t i = 0; i < 3u; i++) {
+    canvas.DrawRect(Rect(10.0f * i, 0, 10, 10), paint);
+  }
+  const auto picture = canvas.EndRecordingAsPicture();
+
+  canvas.Translate({100, 0});
+  canvas.DrawPicture(picture);
+  canvas.Translate({0, 100});
+  canvas.DrawPicture(picture);
+  const auto drawn = canvas.EndRecordingAsPicture();
+
+  // Each draw is a single entity that shares the pass of the picture.
+  const auto& entities = drawn.pass->GetEntities();
+  ASSERT_EQ(entities.size(), 2u);
+  for (const auto& entity : entities) {
+    auto contents =
+        std::static_pointer_cast<EntityPassContents>(entity.GetContents());
+    ASSERT_EQ(contents->GetPass(), picture.pass);
+  }
+  ASSERT_RECT_NEAR(entities[1].GetTransformedCoverage().value(),
+                   Rect(100, 100, 30, 10));
+
+  // The picture itself is left untouched.
+  for (const auto& entity : picture.pass->GetEntities()) {
+    ASSERT_TRUE(entity.GetTransformation().IsIdentity());
+  }
+}
+
+TEST_F(AiksTest, DrawsWithEqualPaintsShareContents) {
+  Canvas canvas;
+  Paint red;
+  red.color = Color::Red();
+  Paint blue;
+  blue.color = Color::Blue();
+  Paint red_stroke = red;
+  red_stroke.style = Paint::Style::kStroke;
+  red_stroke.stroke_width = 2.0;
+
+  canvas.DrawRect(Rect(0, 0, 10, 10), red);
+  canvas.DrawRect(Rect(10, 0, 10, 10), blue);
+  canvas.DrawCircle({5, 5}, 5, red_stroke);
+  // Fills ignore the stroke width.
+  red.stroke_width = 4.0;
+  canvas.DrawRect(Rect(20, 0, 10, 10), red);
+  canvas.DrawRect(Rect(30, 0, 10, 10), blue);
+
+  auto picture = canvas.EndRecordingAsPicture();
+  const auto& entities = picture.pass->GetEntities();
+  ASSERT_EQ(entities.size(), 5u);
+  ASSERT_EQ(entities[0].GetContents(), entities[3].GetContents());
+  ASSERT_EQ(entities[1].GetContents(), entities[4].GetContents());
+  ASSERT_NE(entities[0].GetContents(), entities[1].GetContents());
+  ASSERT_NE(entities[0].GetContents(), entities[2].GetContents());
+}
+
+TEST_F(AiksTest, IdenticalPicturesHaveNoDamage) {
+  auto record = [] {
+    Canvas canvas;
+    Paint paint;
+    paint.color = Color::Red();
+    canvas.DrawRect(Rect(10, 10, 20, 20), paint);
+    Paint layer;
+    layer.color = Color::Black().WithAlpha(0.5);
+    canvas.SaveLayer(layer);
+    canvas.ClipPath(PathBuilder{}.AddCircle({50, 50}, 20).TakePath());
+    canvas.DrawRect(Rect(40, 40, 20, 20), paint);
+    canvas.Restore();
+    return canvas.EndRecordingAsPicture();
+  };
+  ASSERT_TRUE(record().ComputeDamage(record(), {100, 100}).empty());
+}
+
+TEST_F(AiksTest, ChangedEntitiesAreDamaged) {
+  auto record = [](Color color, Point origin) {
+    Canvas canvas;
+    Paint paint;
+    paint.color = Color::Red();
+    canvas.DrawRect(Rect(0, 0, 10, 10), paint);
+    paint.color = color;
+    canvas.DrawRect(Rect(origin.x, origin.y, 10, 10), paint);
+    paint.color = Color::Blue();
+    canvas.DrawRect(Rect(80, 80, 10, 10), paint);
+    return canvas.EndRecordingAsPicture();
+  };
+  const auto previous = record(Color::Green(), {20, 20});
+
+  // Recolored in place.
+  auto damage =
+      record(Color::Blue(), {20, 20}).ComputeDamage(previous, {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(20, 20, 10, 10));
+
+  // Moved. Both the old and the new bounds are damaged.
+  damage =
+      record(Color::Green(), {50, 20}).ComputeDamage(previous, {100, 100});
+  ASSERT_EQ(damage.size(), 2u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(50, 20, 10, 10));
+  ASSERT_EQ(damage[1], IRect::MakeXYWH(20, 20, 10, 10));
+
+  // Overlapping damage is merged.
+  damage =
+      record(Color::Green(), {25, 20}).ComputeDamage(previous, {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(20, 20, 15, 10));
+}
+
+TEST_F(AiksTest, TexturesModifiedInPlaceAreDamaged) {
+  auto texture = CreateTextureForFixture("kalimba.jpg");
+  ASSERT_TRUE(texture);
+  auto image = std::make_shared<Image>(texture);
+  auto record = [&image] {
+    Canvas canvas;
+    canvas.DrawImageRect(image, IRect::MakeSize(image->GetSize()),
+                         Rect::MakeXYWH(20, 20, 10, 10), Paint{});
+    return canvas.EndRecordingAsPicture();
+  };
+  const auto previous = record();
+  ASSERT_TRUE(record().ComputeDamage(previous, {100, 100}).empty());
+
+  std::vector<uint8_t> contents(
+      texture->GetTextureDescriptor().GetSizeOfBaseMipLevel(), 0xFF);
+  ASSERT_TRUE(texture->SetContents(contents.data(), contents.size()));
+
+  // Recorded after the texture was modified.
+  auto damage = record().ComputeDamage(previous, {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(20, 20, 10, 10));
+
+  // Redrawn without being recorded again.
+  damage = previous.ComputeDamage(previous, {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(20, 20, 10, 10));
+}
+
+TEST_F(AiksTest, InsertedAndRemovedEntitiesAreDamaged) {
+  auto record = [](bool insert) {
+    Canvas canvas;
+    Paint paint;
+    canvas.DrawRect(Rect(0, 0, 10, 10), paint);
+    if (insert) {
+      canvas.DrawRect(Rect(40, 40, 10, 10), paint);
+    }
+    canvas.DrawRect(Rect(80, 80, 10, 10), paint);
+    return canvas.EndRecordingAsPicture();
+  };
+  const auto expected = IRect::MakeXYWH(40, 40, 10, 10);
+
+  auto damage = record(true).ComputeDamage(record(false), {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], expected);
+
+  damage = record(false).ComputeDamage(record(true), {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], expected);
+}
+
+TEST_F(AiksTest, ChangedClipsDamageEverything) {
+  auto record = [](Scalar radius) {
+    Canvas canvas;
+    canvas.ClipPath(PathBuilder{}.AddCircle({50, 50}, radius).TakePath());
+    canvas.DrawRect(Rect(0, 0, 100, 100), Paint{});
+    return canvas.EndRecordingAsPicture();
+  };
+  auto damage = record(20).ComputeDamage(record(30), {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(0, 0, 100, 100));
+}
+
+TEST_F(AiksTest, ChangedLayersAreDamaged) {
+  auto record = [](Scalar opacity, Color color) {
+    Canvas canvas;
+    Paint paint;
+    canvas.DrawRect(Rect(0, 0, 10, 10), paint);
+    Paint layer;
+    layer.color = Color::Black().WithAlpha(opacity);
+    canvas.SaveLayer(layer);
+    canvas.DrawRect(Rect(40, 40, 10, 10), paint);
+    paint.color = color;
+    canvas.DrawRect(Rect(60, 60, 10, 10), paint);
+    canvas.Restore();
+    return canvas.EndRecordingAsPicture();
+  };
+
+  // The entities of opaque layers are drawn into the parent pass. Only the
+  // changed entity is damaged.
+  auto damage = record(1.0, Color::Blue())
+                    .ComputeDamage(record(1.0, Color::Red()), {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(60, 60, 10, 10));
+
+  // Other layers are drawn into the parent pass at once.
+  damage = record(0.5, Color::Blue())
+               .ComputeDamage(record(0.5, Color::Red()), {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(40, 40, 30, 30));
+
+  // So is any change to how the layer is drawn.
+  damage = record(0.25, Color::Red())
+               .ComputeDamage(record(0.5, Color::Red()), {100, 100});
+  ASSERT_EQ(damage.size(), 1u);
+  ASSERT_EQ(damage[0], IRect::MakeXYWH(40, 40, 30, 30));
+}
+
+class TestSurface final : public Surface {
+ public:
+  TestSurface(RenderTarget target) : Surface(std::move(target)) {}
+
+  // |Surface|
+  bool Present() const override { return true; }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Renders pictures with the software backend into a small
+///             offscreen target so that tests can check the frame stats and
+///             the rendered pixels without a playground window.
+///
+class AiksSWTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    context_ = ContextSW::Create(GetEntityNativeShadersSW(), 0u);
+    ASSERT_TRUE(context_ && context_->IsValid());
+    aiks_context_ = std::make_unique<AiksContext>(context_);
+    ASSERT_TRUE(aiks_context_->IsValid());
+    renderer_ = std::make_unique<Renderer>(context_);
+    ASSERT_TRUE(renderer_->IsValid());
+    target_ = CreateTarget();
+    ASSERT_TRUE(target_.IsValid());
+  }
+
+  AiksContext& GetAiksContext() const { return *aiks_context_; }
+
+  const RenderTarget& GetTarget() const { return target_; }
+
+  RenderTarget CreateTarget() const {
+    return RenderTarget::CreateOffscreen(*context_, {16, 16});
+  }
+
+  FrameStats GetLastFrameStats() const {
+    return renderer_->GetLastFrameStats();
+  }
+
+  bool Render(const RenderTarget& target,
+              const Renderer::RenderCallback& callback) const {
+    return renderer_->Render(std::make_unique<TestSurface>(target), callback);
+  }
+
+  bool Render(const Picture& picture, const RenderTarget& target) const {
+    return Render(target, [&](RenderPass& pass) {
+      return aiks_context_->Render(picture, pass);
+    });
+  }
+
+  bool Render(const Picture& picture) const {
+    return Render(picture, target_);
+  }
+
+  static Color ReadPixel(const RenderTarget& target, int64_t x, int64_t y) {
+    return TextureSW::Cast(*target.GetRenderTargetTexture()).ReadPixel(x, y);
+  }
+
+  Color ReadPixel(int64_t x, int64_t y) const {
+    return ReadPixel(target_, x, y);
+  }
+
+ private:
+  std::shared_ptr<Context> context_;
+  std::unique_ptr<AiksContext> aiks_context_;
+  std::unique_ptr<Renderer> renderer_;
+  RenderTarget target_;
+};
+
+using AiksContextTest = AiksSWTest;
+
+TEST_F(AiksContextTest, OnlyTheDamageIsRepainted) {
+  auto record = [](Color color, Rect rect) {
+    Canvas canvas;
+    Paint paint;
+    paint.color = Color::Green();
+    canvas.DrawRect(Rect(8, 8, 8, 8), paint);
+    paint.color = color;
+    canvas.DrawRect(rect, paint);
+    return canvas.EndRecordingAsPicture();
+  };
+  const auto previous = record(Color::Red(), Rect(0, 0, 8, 8));
+  ASSERT_TRUE(Render(previous));
+
+  // The next frame starts with the contents of the previous one.
+  auto color0 = GetTarget().GetColorAttachments().at(0u);
+  color0.load_action = LoadAction::kLoad;
+  auto load_target = GetTarget();
+  load_target.SetColorAttachment(color0, 0u);
+
+  const auto picture = record(Color::Blue(), Rect(0, 0, 8, 4));
+  ASSERT_TRUE(Render(load_target, [&](RenderPass& pass) {
+    return GetAiksContext().Render(picture, previous, pass);
+  }));
+
+  // The damaged region is cleared and the changed rectangle is drawn again.
+  // The unchanged rectangle is outside of the damage.
+  const auto stats = GetLastFrameStats();
+  ASSERT_EQ(stats.draw_calls, 2u);
+  ASSERT_EQ(stats.entities_culled, 1u);
+  ASSERT_EQ(ReadPixel(2, 2), Color::Blue());
+  ASSERT_EQ(ReadPixel(2, 6), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(12, 12), Color::Green());
+}
+
+TEST_F(AiksContextTest, PicturesAreRenderedWhereTheyAreDrawn) {
+  Canvas canvas;
+  Paint paint;
+  paint.color = Color::Red();
+  canvas.ClipPath(PathBuilder{}.AddRect(Rect(0, 0, 4, 8)).TakePath());
+  canvas.DrawRect(Rect(0, 0, 8, 8), paint);
+  const auto picture = canvas.EndRecordingAsPicture();
+
+  canvas.DrawPicture(picture);
+  canvas.Translate({8, 8});
+  canvas.DrawPicture(picture);
+  ASSERT_TRUE(Render(canvas.EndRecordingAsPicture()));
+
+  // The scissor of the picture moves along with it.
+  ASSERT_EQ(GetLastFrameStats().draw_calls, 2u);
+  ASSERT_EQ(ReadPixel(2, 2), Color::Red());
+  ASSERT_EQ(ReadPixel(6, 2), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(10, 10), Color::Red());
+  ASSERT_EQ(ReadPixel(14, 10), Color::BlackTransparent());
+}
+
+TEST_F(AiksContextTest, LayersOfPicturesAreRenderedWhereTheyAreDrawn) {
+  // The rectangles overlap. So the layer is rendered offscreen.
+  Canvas canvas;
+  Paint layer_paint;
+  layer_paint.color = Color::Black().WithAlpha(0.5);
+  canvas.SaveLayer(layer_paint);
+  Paint paint;
+  paint.color = Color::Red();
+  canvas.DrawRect(Rect(0, 0, 4, 4), paint);
+  canvas.DrawRect(Rect(2, 2, 4, 4), paint);
+  canvas.Restore();
+  const auto picture = canvas.EndRecordingAsPicture();
+
+  canvas.Translate({8, 8});
+  canvas.DrawPicture(picture);
+  ASSERT_TRUE(Render(canvas.EndRecordingAsPicture()));
+
+  // The layer is only translated once, when it is composited.
+  const auto stats = GetLastFrameStats();
+  ASSERT_EQ(stats.offscreen_subpasses, 1u);
+  // The offscreen pass of the picture is submitted along with the ones of the
+  // pass drawing it.
+  ASSERT_EQ(stats.command_buffers_submitted, 2u);
+  ASSERT_EQ(ReadPixel(2, 2), Color::BlackTransparent());
+  ASSERT_NE(ReadPixel(9, 9), Color::BlackTransparent());
+  ASSERT_NE(ReadPixel(13, 13), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(15, 15), Color::BlackTransparent());
+}
+
+TEST_F(AiksContextTest, TranslucentLayersWithoutOverlapsAreFolded) {
+  auto record = [](bool overlap) {
+    Canvas canvas;
+    Paint layer_paint;
+    layer_paint.color = Color::Black().WithAlpha(0.5);
+    canvas.SaveLayer(layer_paint);
+    Paint paint;
+    paint.color = Color::Red();
+    canvas.DrawRect(Rect(0, 0, 4, 4), paint);
+    canvas.DrawRect(Rect(8, 8, 4, 4), paint);
+    if (overlap) {
+      canvas.DrawRect(Rect(10, 10, 4, 4), paint);
+    }
+    canvas.Restore();
+    return canvas.EndRecordingAsPicture();
+  };
+
+  ASSERT_TRUE(Render(record(false)));
+  auto stats = GetLastFrameStats();
+  ASSERT_EQ(stats.subpasses_folded, 1u);
+  ASSERT_EQ(stats.offscreen_subpasses, 0u);
+
+  // Overlapping entities still need a render target of their own.
+  const auto offscreen_target = CreateTarget();
+  ASSERT_TRUE(Render(record(true), offscreen_target));
+  stats = GetLastFrameStats();
+  ASSERT_EQ(stats.subpasses_folded, 0u);
+  ASSERT_EQ(stats.offscreen_subpasses, 1u);
+
+  // Where nothing overlaps, both look the same.
+  const auto folded = ReadPixel(2, 2);
+  const auto composited = ReadPixel(offscreen_target, 2, 2);
+  ASSERT_NEAR(folded.red, composited.red, 0.01);
+  ASSERT_NEAR(folded.alpha, composited.alpha, 0.01);
+  ASSERT_NEAR(folded.alpha, 0.5, 0.01);
+}
+
+TEST_F(AiksContextTest, LayersWithStencilClipsAreNotFolded) {
+  Canvas canvas;
+  Paint layer_paint;
+  layer_paint.color = Color::Black().WithAlpha(0.5);
+  canvas.SaveLayer(layer_paint);
+  canvas.ClipPath(
+      PathBuilder{}.AddRoundedRect(Rect(0, 0, 8, 8), 4).TakePath());
+  Paint paint;
+  paint.color = Color::Red();
+  canvas.DrawRect(Rect(0, 0, 8, 8), paint);
+  canvas.Restore();
+  // Must not be clipped by the clip of the layer.
+  paint.color = Color::Blue();
+  canvas.DrawRect(Rect(2, 2, 4, 4), paint);
+  ASSERT_TRUE(Render(canvas.EndRecordingAsPicture()));
+
+  ASSERT_EQ(GetLastFrameStats().subpasses_folded, 0u);
+  ASSERT_EQ(ReadPixel(4, 4), Color::Blue());
+  ASSERT_EQ(ReadPixel(0, 0), Color::BlackTransparent());
+}
+
+TEST_F(AiksContextTest, FoldedLayersKeepTheClipsOfTheirParent) {
+  // Rounded rectangles are clipped with the stencil instead of a scissor.
+  Canvas canvas;
+  canvas.ClipPath(
+      PathBuilder{}.AddRoundedRect(Rect(0, 0, 8, 8), 4).TakePath());
+  Paint layer_paint;
+  layer_paint.color = Color::Black().WithAlpha(0.5);
+  canvas.SaveLayer(layer_paint);
+  Paint paint;
+  paint.color = Color::Red();
+  canvas.DrawRect(Rect(0, 0, 16, 16), paint);
+  canvas.Restore();
+  ASSERT_TRUE(Render(canvas.EndRecordingAsPicture()));
+
+  ASSERT_EQ(GetLastFrameStats().subpasses_folded, 1u);
+  ASSERT_NE(ReadPixel(4, 4), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(0, 0), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(12, 12), Color::BlackTransparent());
+}
+
+TEST_F(AiksContextTest, FoldedLayersKeepTheirScissor) {
+  Canvas canvas;
+  canvas.ClipPath(PathBuilder{}.AddRect(Rect(0, 0, 8, 16)).TakePath());
+  Paint layer_paint;
+  layer_paint.color = Color::Black().WithAlpha(0.5);
+  canvas.SaveLayer(layer_paint);
+  Paint paint;
+  paint.color = Color::Red();
+  canvas.DrawRect(Rect(0, 0, 16, 16), paint);
+  canvas.Restore();
+  ASSERT_TRUE(Render(canvas.EndRecordingAsPicture()));
+
+  ASSERT_EQ(GetLastFrameStats().subpasses_folded, 1u);
+  ASSERT_NEAR(ReadPixel(4, 8).alpha, 0.5, 0.01);
+  ASSERT_EQ(ReadPixel(12, 8), Color::BlackTransparent());
+}
+
+TEST_F(AiksContextTest, BakedPicturesAreReplayedWithTheirTransformation) {
+  Canvas canvas;
+  Paint paint;
+  paint.color = Color::Red();
+  canvas.ClipPath(PathBuilder{}.AddRect(Rect(0, 0, 4, 8)).TakePath());
+  canvas.DrawRect(Rect(0, 0, 8, 8), paint);
+  const auto baked =
+      GetAiksContext().Bake(canvas.EndRecordingAsPicture(), GetTarget());
+  ASSERT_TRUE(baked);
+  ASSERT_EQ(baked->GetCommandCount(), 1u);
+
+  ASSERT_TRUE(Render(GetTarget(), [&](RenderPass& pass) {
+    return baked->Render(pass) &&
+           baked->Render(pass, Matrix::MakeTranslation({8, 8, 0}));
+  }));
+
+  // The scissor of the clip moves along with the picture.
+  ASSERT_EQ(GetLastFrameStats().draw_calls, 2u);
+  ASSERT_EQ(ReadPixel(2, 2), Color::Red());
+  ASSERT_EQ(ReadPixel(6, 2), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(10, 10), Color::Red());
+  ASSERT_EQ(ReadPixel(14, 10), Color::BlackTransparent());
+}
+
 TEST_F(AiksTest, CanRenderColoredRect) {
   Canvas canvas;
   Paint paint;
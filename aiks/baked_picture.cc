@@ -0,0 +1,222 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/aiks/baked_picture.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "impeller/aiks/picture.h"
+#include "impeller/base/validation.h"
+#include "impeller/entity/content_context.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A render pass that collects the commands added to it instead of
+///             encoding them. Its transients outlive it.
+///
+class BakingRenderPass final : public RenderPass {
+ public:
+  explicit BakingRenderPass(RenderTarget target)
+      : RenderPass(std::move(target)), transients_(HostBuffer::Create()) {
+    transients_->SetLabel("Baked Picture");
+  }
+
+  // |RenderPass|
+  ~BakingRenderPass() override = default;
+
+  std::vector<Command>& GetCommands() { return commands_; }
+
+  const std::shared_ptr<HostBuffer>& GetTransients() const {
+    return transients_;
+  }
+
+  // |RenderPass|
+  bool IsValid() const override { return true; }
+
+  // |RenderPass|
+  void SetLabel(std::string label) override {}
+
+  // |RenderPass|
+  HostBuffer& GetTransientsBuffer() override { return *transients_; }
+
+ private:
+  std::shared_ptr<HostBuffer> transients_;
+  std::vector<Command> commands_;
+
+  // |RenderPass|
+  bool OnAddCommand(Command command) override {
+    commands_.emplace_back(std::move(command));
+    return true;
+  }
+
+  // |RenderPass|
+  bool OnEncodeCommands(Allocator& transients_allocator) const override {
+    // The commands are replayed into other passes instead.
+    return false;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BakingRenderPass);
+};
+
+static void RebindBuffer(BufferView& view,
+                         const std::shared_ptr<HostBuffer>& host_buffer,
+                         const std::shared_ptr<const DeviceBuffer>& buffer) {
+  if (view.buffer == host_buffer) {
+    view.buffer = buffer;
+  }
+}
+
+static std::optional<size_t> GetMVPBinding(const Command& command) {
+  if (!command.mvp_binding.has_value()) {
+    return std::nullopt;
+  }
+  const auto& buffers = command.vertex_bindings.buffers;
+  auto found = buffers.find(command.mvp_binding.value());
+  if (found == buffers.end() ||
+      found->second.range.length < sizeof(Matrix)) {
+    return std::nullopt;
+  }
+  return command.mvp_binding;
+}
+
+std::shared_ptr<BakedPicture> BakedPicture::Make(ContentContext& renderer,
+                                                 const Picture& picture,
+                                                 const RenderTarget& target) {
+  BakingRenderPass pass(target);
+  if (picture.pass && !picture.pass->Render(renderer, pass)) {
+    VALIDATION_LOG << "Could not render the picture to bake.";
+    return nullptr;
+  }
+  if (!pass.GetStats().IsComplete()) {
+    VALIDATION_LOG << "The baked picture would be missing some of its draws.";
+    return nullptr;
+  }
+
+  const auto& host_buffer = pass.GetTransients();
+  std::shared_ptr<const DeviceBuffer> device_buffer;
+  if (host_buffer->GetLength() > 0u) {
+    // Uploaded once. The commands are rebound to the device buffer so that
+    // rendering them doesn't upload anything.
+    device_buffer = static_cast<const Buffer&>(*host_buffer)
+                        .GetDeviceBuffer(
+                            *renderer.GetContext()->GetPermanentsAllocator());
+    if (!device_buffer) {
+      VALIDATION_LOG << "Could not upload the baked picture.";
+      return nullptr;
+    }
+  }
+
+  std::vector<BakedCommand> commands;
+  commands.reserve(pass.GetCommands().size());
+  for (auto& command : pass.GetCommands()) {
+    auto frame_info_binding = GetMVPBinding(command);
+    if (!frame_info_binding.has_value()) {
+      VALIDATION_LOG << "Command " << command.label
+                     << " has no model view projection matrix to transform.";
+      return nullptr;
+    }
+    for (auto& [binding, view] : command.vertex_bindings.buffers) {
+      RebindBuffer(view, host_buffer, device_buffer);
+    }
+    for (auto& [binding, view] : command.fragment_bindings.buffers) {
+      RebindBuffer(view, host_buffer, device_buffer);
+    }
+    RebindBuffer(command.index_buffer, host_buffer, device_buffer);
+    commands.push_back({std::move(command), frame_info_binding.value()});
+  }
+
+  return std::shared_ptr<BakedPicture>(
+      new BakedPicture(target.GetRenderTargetSize(), host_buffer,
+                       std::move(device_buffer), std::move(commands)));
+}
+
+BakedPicture::BakedPicture(ISize size,
+                           std::shared_ptr<HostBuffer> host_buffer,
+                           std::shared_ptr<const DeviceBuffer> device_buffer,
+                           std::vector<BakedCommand> commands)
+    : size_(size),
+      host_buffer_(std::move(host_buffer)),
+      device_buffer_(std::move(device_buffer)),
+      commands_(std::move(commands)) {}
+
+BakedPicture::~BakedPicture() = default;
+
+ISize BakedPicture::GetSize() const {
+  return size_;
+}
+
+size_t BakedPicture::GetCommandCount() const {
+  return commands_.size();
+}
+
+static std::optional<IRect> TransformScissor(
+    const std::optional<IRect>& scissor,
+    const Matrix& xformation) {
+  if (!scissor.has_value()) {
+    return std::nullopt;
+  }
+  auto bounds = xformation.TransformBounds(Rect(scissor.value()));
+  if (!bounds.has_value()) {
+    return std::nullopt;
+  }
+  const auto ltrb = bounds->GetLTRB();
+  return IRect::MakeLTRB(std::floor(ltrb[0]), std::floor(ltrb[1]),
+                         std::ceil(ltrb[2]), std::ceil(ltrb[3]));
+}
+
+bool BakedPicture::Render(RenderPass& pass,
+                          const Matrix& transformation) const {
+  const auto target_size = pass.GetRenderTargetSize();
+  if (transformation.IsIdentity() && target_size == size_) {
+    // The baked uniforms are already correct. Nothing is uploaded.
+    for (const auto& baked : commands_) {
+      if (!pass.AddCommand(baked.command)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The commands were baked with the MVP matrices of the bake target. Undo its
+  // orthographic projection, apply the transformation and project into this
+  // target instead. Scissors are in pixels and only need the transformation.
+  const auto mvp_xformation = Matrix::MakeOrthographic(target_size) *
+                              transformation *
+                              Matrix::MakeOrthographic(size_).Invert();
+  auto& transients = pass.GetTransientsBuffer();
+  for (const auto& baked : commands_) {
+    auto command = baked.command;
+    auto& frame_info =
+        command.vertex_bindings.buffers[baked.frame_info_binding];
+    auto view = transients.Emplace(
+        host_buffer_->GetBuffer() + frame_info.range.offset,  // buffer
+        frame_info.range.length,                              // length
+        DefaultUniformAlignment()                             // align
+    );
+    if (!view) {
+      return false;
+    }
+
+    auto mvp_data = transients.GetBuffer() + view.range.offset;
+    Matrix mvp;
+    std::memcpy(&mvp, mvp_data, sizeof(Matrix));
+    mvp = mvp_xformation * mvp;
+    std::memcpy(mvp_data, &mvp, sizeof(Matrix));
+    frame_info = std::move(view);
+
+    command.scissor = TransformScissor(command.scissor, transformation);
+    if (!pass.AddCommand(std::move(command))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace impeller
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/renderer/command.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+class ContentContext;
+class DeviceBuffer;
+class HostBuffer;
+class RenderPass;
+struct Picture;
+
+//------------------------------------------------------------------------------
+/// @brief      A picture compiled into a flat list of commands whose vertices
+///             and uniforms live in a single device buffer.
+///
+///             Baking renders the picture once. Rendering the baked picture
+///             only re-issues its commands, with the uniforms of the vertex
+///             stages patched for the transformation the picture is drawn
+///             with. Offscreen layers are rasterized at bake time and are not
+///             re-rendered.
+///
+class BakedPicture {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Compile a picture for rendering into render targets like the
+  ///             given one. Only the size and formats of the target are used.
+  ///
+  /// @return     The baked picture or null if the picture could not be
+  ///             rendered in full.
+  ///
+  static std::shared_ptr<BakedPicture> Make(ContentContext& renderer,
+                                            const Picture& picture,
+                                            const RenderTarget& target);
+
+  ~BakedPicture();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add the commands of the picture to a render pass.
+  ///
+  /// @param[in]  transformation  Applied to the picture before the
+  ///                             transformations it was recorded with, in the
+  ///                             coordinate space of the render target.
+  ///
+  bool Render(RenderPass& pass, const Matrix& transformation = {}) const;
+
+  ISize GetSize() const;
+
+  size_t GetCommandCount() const;
+
+ private:
+  struct BakedCommand {
+    Command command;
+    // The vertex stage binding of the frame info uniform block. Every entity
+    // vertex shader declares it first and starts it with the MVP matrix.
+    size_t frame_info_binding = 0u;
+  };
+
+  const ISize size_;
+  std::shared_ptr<HostBuffer> host_buffer_;
+  std::shared_ptr<const DeviceBuffer> device_buffer_;
+  std::vector<BakedCommand> commands_;
+
+  BakedPicture(ISize size,
+               std::shared_ptr<HostBuffer> host_buffer,
+               std::shared_ptr<const DeviceBuffer> device_buffer,
+               std::vector<BakedCommand> commands);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BakedPicture);
+};
+
+}  // namespace impeller
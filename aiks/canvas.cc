@@ -5,6 +5,7 @@
 #include "impeller/aiks/canvas.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "flutter/fml/logging.h"
 #include "impeller/aiks/paint_pass_delegate.h"
@@ -19,6 +20,7 @@ Canvas::Canvas() {
 Canvas::~Canvas() = default;
 
 void Canvas::Initialize() {
+  arena_ = std::make_shared<Arena>();
   base_pass_ = std::make_unique<EntityPass>();
   current_pass_ = base_pass_.get();
   xformation_stack_.emplace_back(CanvasStackEntry{});
@@ -27,6 +29,9 @@ void Canvas::Initialize() {
 }
 
 void Canvas::Reset() {
+  arena_ = nullptr;
+  paint_contents_.clear();
+  clip_contents_ = nullptr;
   base_pass_ = nullptr;
   current_pass_ = nullptr;
   xformation_stack_ = {};
@@ -96,11 +101,11 @@ void Canvas::RestoreToCount(size_t count) {
 void Canvas::DrawPath(Path path, Paint paint) {
   Entity entity;
   entity.SetTransformation(GetCurrentTransformation());
-  entity.SetPath(std::move(path));
+  entity.SetPath(MakeSharedInArena<Path>(arena_, std::move(path)));
   entity.SetStencilDepth(GetStencilDepth());
-  entity.SetContents(paint.CreateContentsForEntity());
+  entity.SetContents(GetContentsForPaint(paint));
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawRect(Rect rect, Paint paint) {
@@ -129,15 +134,49 @@ void Canvas::SaveLayer(Paint paint, std::optional<Rect> bounds) {
 }
 
 void Canvas::ClipPath(Path path) {
+  const auto& xformation = GetCurrentTransformation();
+  if (auto rect = path.GetRect();
+      rect.has_value() && xformation.IsTranslationScaleOnly()) {
+    // Axis aligned rectangles become a scissor instead of a stencil draw that
+    // has to be tessellated and rasterized.
+    auto bounds = xformation.TransformBounds(rect.value());
+    if (bounds.has_value()) {
+      // Pixels are inside the clip if their centers are.
+      const auto ltrb = bounds->GetLTRB();
+      const auto clip = IRect::MakeLTRB(
+          std::round(ltrb[0]), std::round(ltrb[1]), std::round(ltrb[2]),
+          std::round(ltrb[3]));
+      auto& scissor = xformation_stack_.back().scissor;
+      scissor = scissor.has_value()
+                    ? scissor->Intersection(clip).value_or(IRect::MakeSize({}))
+                    : clip;
+      IntersectClipBounds(Rect(scissor.value()));
+      return;
+    }
+  }
+
   IncrementStencilDepth();
 
   Entity entity;
-  entity.SetTransformation(GetCurrentTransformation());
-  entity.SetPath(std::move(path));
-  entity.SetContents(std::make_shared<ClipContents>());
+  entity.SetTransformation(xformation);
+  entity.SetPath(MakeSharedInArena<Path>(arena_, std::move(path)));
+  if (!clip_contents_) {
+    clip_contents_ = MakeSharedInArena<ClipContents>(arena_);
+  }
+  entity.SetContents(clip_contents_);
   entity.SetStencilDepth(GetStencilDepth());
+  entity.SetScissor(xformation_stack_.back().scissor);
   entity.SetAddsToCoverage(false);
 
+  // Clips don't add to the coverage of the entity. So use the path directly.
+  if (auto path_bounds = entity.GetPath().GetBoundingBox();
+      path_bounds.has_value()) {
+    if (auto bounds = xformation.TransformBounds(path_bounds.value());
+        bounds.has_value()) {
+      IntersectClipBounds(bounds.value());
+    }
+  }
+
   GetCurrentPass().AddEntity(std::move(entity));
 }
 
@@ -147,15 +186,15 @@ void Canvas::DrawPicture(Picture picture) {
   if (!picture.pass) {
     return;
   }
-  // Clone the base pass and account for the CTM updates.
-  auto pass = picture.pass->Clone();
-  pass->IterateAllEntities([&](auto& entity) -> bool {
-    entity.IncrementStencilDepth(GetStencilDepth());
-    entity.SetTransformation(GetCurrentTransformation() *
-                             entity.GetTransformation());
-    return true;
-  });
-  return;
+  // The pass of the picture is shared rather than copied. The current
+  // transformation and stencil depth are applied to it when it is rendered.
+  Entity entity;
+  entity.SetTransformation(GetCurrentTransformation());
+  entity.SetStencilDepth(GetStencilDepth());
+  entity.SetContents(
+      MakeSharedInArena<EntityPassContents>(arena_, std::move(picture.pass)));
+
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawImage(std::shared_ptr<Image> image,
@@ -186,21 +225,24 @@ void Canvas::DrawImageRect(std::shared_ptr<Image> image,
     return;
   }
 
-  auto contents = std::make_shared<TextureContents>();
+  auto contents = MakeSharedInArena<TextureContents>(arena_);
   contents->SetTexture(image->GetTexture());
+  contents->SetTextureUpload(image->GetUpload());
   contents->SetSourceRect(source);
 
   Entity entity;
-  entity.SetPath(PathBuilder{}.AddRect(dest).TakePath());
+  entity.SetPath(
+      MakeSharedInArena<Path>(arena_, PathBuilder{}.AddRect(dest).TakePath()));
   entity.SetContents(contents);
   entity.SetTransformation(GetCurrentTransformation());
 
-  GetCurrentPass().AddEntity(std::move(entity));
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 Picture Canvas::EndRecordingAsPicture() {
   Picture picture;
   picture.pass = std::move(base_pass_);
+  picture.arena = arena_;
 
   Reset();
   Initialize();
@@ -213,6 +255,46 @@ EntityPass& Canvas::GetCurrentPass() {
   return *current_pass_;
 }
 
+void Canvas::IntersectClipBounds(const Rect& bounds) {
+  auto& clip_bounds = xformation_stack_.back().clip_bounds;
+  if (!clip_bounds.has_value()) {
+    clip_bounds = bounds;
+    return;
+  }
+  // Nothing drawn after a clip that is disjoint from the current clip can be
+  // visible.
+  clip_bounds = clip_bounds->Intersection(bounds).value_or(Rect::MakeSize({}));
+}
+
+void Canvas::AddEntityToCurrentPass(Entity entity) {
+  const auto& clip_bounds = xformation_stack_.back().clip_bounds;
+  if (clip_bounds.has_value()) {
+    // Entities that can't be seen through the current clip are dropped
+    // instead of being recorded.
+    auto coverage = entity.GetTransformedCoverage();
+    if (coverage.has_value() &&
+        !coverage->IntersectsWithRect(clip_bounds.value())) {
+      return;
+    }
+  }
+  entity.SetScissor(xformation_stack_.back().scissor);
+  GetCurrentPass().AddEntity(std::move(entity));
+}
+
+const std::shared_ptr<Contents>& Canvas::GetContentsForPaint(
+    const Paint& paint) {
+  auto key = paint;
+  // Fills don't depend on the stroke width.
+  if (key.style == Paint::Style::kFill) {
+    key.stroke_width = 0.0;
+  }
+  auto& contents = paint_contents_[key];
+  if (!contents) {
+    contents = key.CreateContentsForEntity(arena_);
+  }
+  return contents;
+}
+
 void Canvas::IncrementStencilDepth() {
   ++xformation_stack_.back().stencil_depth;
 }
@@ -228,9 +310,12 @@ void Canvas::Save(bool create_subpass) {
     current_pass_ = GetCurrentPass().AddSubpass(std::make_unique<EntityPass>());
     current_pass_->SetTransformation(xformation_stack_.back().xformation);
     current_pass_->SetStencilDepth(xformation_stack_.back().stencil_depth);
+    current_pass_->SetScissor(xformation_stack_.back().scissor);
   } else {
     entry.xformation = xformation_stack_.back().xformation;
     entry.stencil_depth = xformation_stack_.back().stencil_depth;
+    entry.clip_bounds = xformation_stack_.back().clip_bounds;
+    entry.scissor = xformation_stack_.back().scissor;
   }
   xformation_stack_.emplace_back(std::move(entry));
 }
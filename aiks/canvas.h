@@ -7,12 +7,14 @@
 #include <deque>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/aiks/image.h"
 #include "impeller/aiks/paint.h"
 #include "impeller/aiks/picture.h"
+#include "impeller/base/arena.h"
 #include "impeller/entity/entity_pass.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path.h"
@@ -77,6 +79,14 @@ class Canvas {
   Picture EndRecordingAsPicture();
 
  private:
+  // The paths and contents of a recording are allocated from an arena of its
+  // own that is released once none of them are referenced anymore.
+  std::shared_ptr<Arena> arena_;
+  // Draws with equal paints share the same immutable contents within a
+  // recording.
+  std::unordered_map<Paint, std::shared_ptr<Contents>, Paint::Hash>
+      paint_contents_;
+  std::shared_ptr<Contents> clip_contents_;
   std::unique_ptr<EntityPass> base_pass_;
   EntityPass* current_pass_ = nullptr;
   std::deque<CanvasStackEntry> xformation_stack_;
@@ -87,6 +97,12 @@ class Canvas {
 
   EntityPass& GetCurrentPass();
 
+  void IntersectClipBounds(const Rect& bounds);
+
+  void AddEntityToCurrentPass(Entity entity);
+
+  const std::shared_ptr<Contents>& GetContentsForPaint(const Paint& paint);
+
   void IncrementStencilDepth();
 
   size_t GetStencilDepth() const;
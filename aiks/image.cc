@@ -8,6 +8,9 @@ namespace impeller {
 
 Image::Image(std::shared_ptr<Texture> texture) : texture_(std::move(texture)) {}
 
+Image::Image(std::shared_ptr<Texture> texture, std::shared_future<bool> upload)
+    : texture_(std::move(texture)), upload_(std::move(upload)) {}
+
 Image::~Image() = default;
 
 ISize Image::GetSize() const {
@@ -18,4 +21,8 @@ std::shared_ptr<Texture> Image::GetTexture() const {
   return texture_;
 }
 
+const std::shared_future<bool>& Image::GetUpload() const {
+  return upload_;
+}
+
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 
 #include "flutter/fml/macros.h"
@@ -15,14 +16,32 @@ class Image {
  public:
   Image(std::shared_ptr<Texture> texture);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create an image whose texture contents are still being
+  ///             uploaded.
+  ///
+  /// @param[in]  texture  The texture.
+  /// @param[in]  upload   The future of the upload of the texture contents,
+  ///                      usually obtained from a `TextureUploadQueue`.
+  ///
+  Image(std::shared_ptr<Texture> texture, std::shared_future<bool> upload);
+
   ~Image();
 
   ISize GetSize() const;
 
   std::shared_ptr<Texture> GetTexture() const;
 
+  //----------------------------------------------------------------------------
+  /// @return     The future of the upload of the texture contents. This is
+  ///             invalid if the contents were already resident when the image
+  ///             was created.
+  ///
+  const std::shared_future<bool>& GetUpload() const;
+
  private:
   const std::shared_ptr<Texture> texture_;
+  const std::shared_future<bool> upload_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Image);
 };
@@ -4,17 +4,20 @@
 
 #include "impeller/aiks/paint.h"
 
+#include "flutter/fml/hash_combine.h"
+
 namespace impeller {
 
-std::shared_ptr<Contents> Paint::CreateContentsForEntity() const {
+std::shared_ptr<Contents> Paint::CreateContentsForEntity(
+    const std::shared_ptr<Arena>& arena) const {
   switch (style) {
     case Style::kFill: {
-      auto solid_color = std::make_shared<SolidColorContents>();
+      auto solid_color = MakeSharedInArena<SolidColorContents>(arena);
       solid_color->SetColor(color);
       return solid_color;
     }
     case Style::kStroke: {
-      auto solid_stroke = std::make_shared<SolidStrokeContents>();
+      auto solid_stroke = MakeSharedInArena<SolidStrokeContents>(arena);
       solid_stroke->SetColor(color);
       solid_stroke->SetStrokeSize(stroke_width);
       return solid_stroke;
@@ -24,4 +27,14 @@ std::shared_ptr<Contents> Paint::CreateContentsForEntity() const {
   return nullptr;
 }
 
+std::size_t Paint::GetHash() const {
+  return fml::HashCombine(color.red, color.green, color.blue, color.alpha,
+                          stroke_width, style);
+}
+
+bool Paint::operator==(const Paint& other) const {
+  return color == other.color && stroke_width == other.stroke_width &&
+         style == other.style;
+}
+
 }  // namespace impeller
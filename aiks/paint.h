@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/arena.h"
 #include "impeller/entity/contents.h"
 #include "impeller/geometry/color.h"
 
@@ -22,7 +23,26 @@ struct Paint {
   Scalar stroke_width = 0.0;
   Style style = Style::kFill;
 
-  std::shared_ptr<Contents> CreateContentsForEntity() const;
+  //----------------------------------------------------------------------------
+  /// @brief      Create the contents that draw an entity with this paint.
+  ///
+  /// @param[in]  arena  The arena the contents are allocated from. They are
+  ///                    allocated on the heap if there is none.
+  ///
+  std::shared_ptr<Contents> CreateContentsForEntity(
+      const std::shared_ptr<Arena>& arena = nullptr) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of everything that affects the contents created for
+  ///             this paint.
+  ///
+  std::size_t GetHash() const;
+
+  bool operator==(const Paint& other) const;
+
+  struct Hash {
+    std::size_t operator()(const Paint& paint) const { return paint.GetHash(); }
+  };
 };
 
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/aiks/paint_pass_delegate.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "impeller/entity/contents.h"
 
 namespace impeller {
@@ -31,12 +32,30 @@ bool PaintPassDelegate::CanCollapseIntoParentPass() {
 
 // |EntityPassDelgate|
 std::shared_ptr<Contents> PaintPassDelegate::CreateContentsForSubpassTarget(
-    std::shared_ptr<Texture> target) {
+    std::shared_ptr<Texture> target,
+    IRect source_rect) {
   auto contents = std::make_shared<TextureContents>();
   contents->SetTexture(target);
-  contents->SetSourceRect(IRect::MakeSize(target->GetSize()));
+  contents->SetSourceRect(source_rect);
   contents->SetOpacity(paint_.color.alpha);
   return contents;
 }
 
+// |EntityPassDelgate|
+std::optional<Scalar> PaintPassDelegate::GetSubpassOpacity() {
+  // Subpass targets are composited with the opacity of the paint and nothing
+  // else.
+  return paint_.color.alpha;
+}
+
+// |EntityPassDelgate|
+std::size_t PaintPassDelegate::GetHash() const {
+  auto seed = paint_.GetHash();
+  if (coverage_.has_value()) {
+    fml::HashCombineSeed(seed, coverage_->origin.x, coverage_->origin.y,
+                         coverage_->size.width, coverage_->size.height);
+  }
+  return seed;
+}
+
 }  // namespace impeller
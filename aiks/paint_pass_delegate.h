@@ -30,7 +30,14 @@ class PaintPassDelegate final : public EntityPassDelegate {
 
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
-      std::shared_ptr<Texture> target) override;
+      std::shared_ptr<Texture> target,
+      IRect source_rect) override;
+
+  // |EntityPassDelgate|
+  std::optional<Scalar> GetSubpassOpacity() override;
+
+  // |EntityPassDelgate|
+  std::size_t GetHash() const override;
 
  private:
   const Paint paint_;
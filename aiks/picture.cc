@@ -8,6 +8,13 @@
 
 namespace impeller {
 
-//
+std::vector<IRect> Picture::ComputeDamage(const Picture& previous,
+                                          const ISize& size) const {
+  // A missing pass draws nothing.
+  const EntityPass empty;
+  const auto& current_pass = pass ? *pass : empty;
+  const auto& previous_pass = previous.pass ? *previous.pass : empty;
+  return current_pass.ComputeDamage(previous_pass, size);
+}
 
 }  // namespace impeller
@@ -6,15 +6,41 @@
 
 #include <deque>
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/arena.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass.h"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      The result of recording a canvas. Pictures are immutable. Copies
+///             share the same pass, and drawing a picture into a canvas only
+///             records a reference to it.
+///
 struct Picture {
-  std::unique_ptr<EntityPass> pass;
+  std::shared_ptr<const EntityPass> pass;
+
+  //----------------------------------------------------------------------------
+  /// The arena the paths and contents of the picture were allocated from. It
+  /// is released once the picture and every picture drawing it are gone.
+  ///
+  std::shared_ptr<Arena> arena;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the regions of a render target that differ between
+  ///             rendering the previous picture into it and rendering this one.
+  ///
+  /// @param[in]  previous  The picture last rendered into the render target.
+  /// @param[in]  size      The size of the render target.
+  ///
+  /// @return     Disjoint regions of the render target in pixels. Empty if both
+  ///             pictures render the same.
+  ///
+  std::vector<IRect> ComputeDamage(const Picture& previous,
+                                   const ISize& size) const;
 };
 
 }  // namespace impeller
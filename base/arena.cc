@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/base/arena.h"
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+Arena::Arena(size_t block_size) : block_size_(block_size) {}
+
+Arena::~Arena() = default;
+
+uint8_t* Arena::AllocateBlock(size_t size) {
+  const auto count =
+      (size + sizeof(std::max_align_t) - 1u) / sizeof(std::max_align_t);
+  // Left uninitialized. Every allocation is initialized by its user.
+  blocks_.emplace_back(new std::max_align_t[count]);
+  return reinterpret_cast<uint8_t*>(blocks_.back().get());
+}
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+  FML_DCHECK(alignment != 0u && (alignment & (alignment - 1u)) == 0u &&
+             alignment <= alignof(std::max_align_t));
+
+  allocation_count_++;
+
+  // Large allocations would waste most of a shared block.
+  if (size > block_size_ / 4u) {
+    bytes_allocated_ += size;
+    return AllocateBlock(size);
+  }
+
+  auto address = reinterpret_cast<uintptr_t>(cursor_);
+  auto padding = (alignment - (address & (alignment - 1u))) & (alignment - 1u);
+  if (cursor_ == nullptr ||
+      static_cast<size_t>(end_ - cursor_) < padding + size) {
+    cursor_ = AllocateBlock(block_size_);
+    end_ = cursor_ + block_size_;
+    padding = 0u;
+  }
+
+  auto result = cursor_ + padding;
+  cursor_ = result + size;
+  bytes_allocated_ += padding + size;
+  return result;
+}
+
+size_t Arena::GetAllocationCount() const {
+  return allocation_count_;
+}
+
+size_t Arena::GetBytesAllocated() const {
+  return bytes_allocated_;
+}
+
+size_t Arena::GetBlockCount() const {
+  return blocks_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A bump allocator for objects that are created together and die
+///             together, like the entities of a recording.
+///
+///             Memory is handed out from large blocks and is never returned to
+///             the arena. All of it is released at once when the arena is
+///             destroyed. Allocation is not thread safe.
+///
+class Arena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 16u * 1024u;
+
+  explicit Arena(size_t block_size = kDefaultBlockSize);
+
+  ~Arena();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocate memory that stays valid for the lifetime of the
+  ///             arena. Allocations larger than a quarter of the block size
+  ///             get a block of their own.
+  ///
+  /// @param[in]  size       The number of bytes.
+  /// @param[in]  alignment  A power of two no larger than that of
+  ///                        `std::max_align_t`.
+  ///
+  void* Allocate(size_t size, size_t alignment);
+
+  size_t GetAllocationCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of bytes handed out, including alignment padding.
+  ///
+  size_t GetBytesAllocated() const;
+
+  size_t GetBlockCount() const;
+
+ private:
+  const size_t block_size_;
+  std::vector<std::unique_ptr<std::max_align_t[]>> blocks_;
+  uint8_t* cursor_ = nullptr;
+  uint8_t* end_ = nullptr;
+  size_t allocation_count_ = 0u;
+  size_t bytes_allocated_ = 0u;
+
+  uint8_t* AllocateBlock(size_t size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A standard allocator that allocates from an arena. Every copy
+///             keeps the arena alive. So objects created with
+///             `std::allocate_shared` may safely outlive everything else that
+///             refers to the arena.
+///
+template <class T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(std::shared_ptr<Arena> arena)
+      : arena_(std::move(arena)) {}
+
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena_) {}
+
+  T* allocate(size_t count) {
+    return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, size_t count) {
+    // Arena memory is only released with the arena.
+  }
+
+  const std::shared_ptr<Arena>& GetArena() const { return arena_; }
+
+  template <class U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+
+  template <class U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <class U>
+  friend class ArenaAllocator;
+
+  std::shared_ptr<Arena> arena_;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Create a shared object in an arena, or on the heap if there is
+///             no arena.
+///
+template <class T, class... Args>
+std::shared_ptr<T> MakeSharedInArena(const std::shared_ptr<Arena>& arena,
+                                     Args&&... args) {
+  if (!arena) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                 std::forward<Args>(args)...);
+}
+
+}  // namespace impeller
@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/base/arena.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(ArenaTest, SmallAllocationsShareBlocks) {
+  Arena arena(1024u);
+  auto first = reinterpret_cast<uintptr_t>(arena.Allocate(3u, 1u));
+  auto second = reinterpret_cast<uintptr_t>(arena.Allocate(8u, 8u));
+  ASSERT_EQ(second % 8u, 0u);
+  ASSERT_EQ(second - first, 8u);
+  ASSERT_EQ(arena.GetBlockCount(), 1u);
+  ASSERT_EQ(arena.GetAllocationCount(), 2u);
+  ASSERT_EQ(arena.GetBytesAllocated(), 16u);
+
+  // Large allocations get a block of their own.
+  arena.Allocate(512u, 8u);
+  ASSERT_EQ(arena.GetBlockCount(), 2u);
+  arena.Allocate(8u, 8u);
+  ASSERT_EQ(arena.GetBlockCount(), 2u);
+
+  // A new block is started once the current one is full.
+  for (size_t i = 0; i < 128u; i++) {
+    arena.Allocate(8u, 8u);
+  }
+  ASSERT_EQ(arena.GetBlockCount(), 3u);
+}
+
+TEST(ArenaTest, SharedObjectsKeepTheArenaAlive) {
+  auto arena = std::make_shared<Arena>();
+  auto value = MakeSharedInArena<std::vector<int>>(arena, 4u, 1);
+  ASSERT_EQ(arena->GetAllocationCount(), 1u);
+  std::weak_ptr<Arena> weak_arena = arena;
+  arena.reset();
+  ASSERT_FALSE(weak_arena.expired());
+  ASSERT_EQ(value->size(), 4u);
+  value.reset();
+  ASSERT_TRUE(weak_arena.expired());
+
+  // Without an arena, objects are allocated on the heap.
+  ASSERT_NE(MakeSharedInArena<int>(nullptr, 1), nullptr);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -24,6 +24,10 @@ constexpr std::string_view kReflectionHeaderTemplate =
 
 namespace impeller {
 
+{% if has_native_shader_sw %}
+struct NativeShaderSW;
+
+{% endif %}
 struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader {
   // ===========================================================================
   // Stage Info ================================================================
@@ -112,12 +116,13 @@ struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader {
     {{stage_output.type.columns}}u       // number of columns
   };
 {% endfor %}
+{% endif %}
+
   static constexpr std::array<const ShaderStageIOSlot*, {{length(stage_outputs)}}> kAllShaderStageOutputs = {
 {% for stage_output in stage_outputs %}
     &kOutput{{camel_case(stage_output.name)}}, // {{stage_output.name}}
 {% endfor %}
   };
-{% endif %}
 
 {% for proto in bind_prototypes %}
   /// {{proto.docstring}}
@@ -133,7 +138,12 @@ std::move({{ arg.argument_name }}){% if not loop.is_last %}, {% endif %}
   }
 
 {% endfor %}
+{% if has_native_shader_sw %}
+  /// The host implementation of this shader for the software backend. Defined
+  /// by the C++ target of the shader library.
+  static const NativeShaderSW& GetNativeShaderSW();
 
+{% endif %}
 };  // struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader
 
 }  // namespace impeller
@@ -163,5 +173,124 @@ static_assert(offsetof(Shader::{{def.name}}, {{member.name}}) == {{member.offset
 }  // namespace impeller
 )~~";
 
+constexpr std::string_view kShaderCPPTemplate =
+    R"~~(// THIS FILE IS GENERATED BY impellerc.
+// DO NOT EDIT OR CHECK THIS INTO SOURCE CONTROL
+
+#include "{{header_file_name}}"
+
+#include <array>
+#include <stdint.h>
+
+#include "impeller/renderer/backend/software/shader_function_sw.h"  // nogncheck
+#include "spirv_cross/external_interface.h"
+#include "spirv_cross/internal_interface.hpp"
+
+// The shader generated by spirv_cross is placed in an anonymous namespace at
+// the end of this file so that multiple shaders may be linked into the same
+// binary. It defines macros for every resource name. So the adapter, which
+// refers to the same names in the reflected structs, must come first.
+namespace {
+const struct spirv_cross_interface* {{entrypoint}}_interface(void);
+}  // namespace
+
+namespace impeller {
+
+using Shader = {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader;
+
+static_assert({{varying_count}}u <= VaryingsSW::kMaxComponents,
+              "Too many varyings for the software backend.");
+
+//------------------------------------------------------------------------------
+/// spirv_cross shader instances hold pointers to the resources of the current
+/// invocation. Each rasterizer thread gets its own instance.
+///
+static spirv_cross_shader_t* GetShaderInstance() {
+  struct Instance {
+    spirv_cross_shader_t* shader = {{entrypoint}}_interface()->construct();
+
+    ~Instance() { {{entrypoint}}_interface()->destruct(shader); }
+  };
+  thread_local Instance instance;
+  return instance.shader;
+}
+
+static void BindUniforms(spirv_cross_shader_t* shader,
+                         const ShaderBindingsSW& bindings) {
+{% for uniform in uniform_buffers %}
+  { // {{uniform.name}}
+    auto data = const_cast<uint8_t*>(bindings.buffers[{{uniform.msl_res_0}}u]);
+    spirv_cross_set_resource(shader,                            //
+                             {{uniform.descriptor_set}}u,       // set
+                             {{uniform.binding}}u,              // binding
+                             reinterpret_cast<void**>(&data),   //
+                             sizeof(data)                       //
+    );
+  }
+{% endfor %}
+}
+
+{% if shader_stage == "vertex" %}
+static Vector4 InvokeShader(const ShaderBindingsSW& bindings,
+                            size_t vertex_index,
+                            VaryingsSW& varyings) {
+  auto shader = GetShaderInstance();
+  BindUniforms(shader, bindings);
+{% if length(stage_inputs) > 0 %}
+  auto& vertex = const_cast<Shader::PerVertexData&>(
+      bindings.GetVertex<Shader::PerVertexData>(vertex_index));
+{% for stage_input in stage_inputs %}
+  spirv_cross_set_stage_input(shader, {{stage_input.location}}u, &vertex.{{stage_input.name}}, sizeof(vertex.{{stage_input.name}}));
+{% endfor %}
+{% endif %}
+{% for varying in varyings %}
+  spirv_cross_set_stage_output(shader, {{varying.location}}u, &varyings.components[{{varying.varying_offset}}u], {{varying.component_count}}u * sizeof(Scalar)); // {{varying.name}}
+{% endfor %}
+  Vector4 position;
+  spirv_cross_set_builtin(shader, SPIRV_CROSS_BUILTIN_POSITION, &position, sizeof(position));
+  {{entrypoint}}_interface()->invoke(shader);
+  return position;
+}
+
+const NativeShaderSW& Shader::GetNativeShaderSW() {
+  static constexpr auto kShader = NativeShaderSW::Vertex(
+      Shader::kEntrypointName, InvokeShader, {{varying_count}}u);
+  return kShader;
+}
+{% else %}
+static Color InvokeShader(const ShaderBindingsSW& bindings,
+                          const VaryingsSW& varyings) {
+  auto shader = GetShaderInstance();
+  BindUniforms(shader, bindings);
+  auto& inputs = const_cast<VaryingsSW&>(varyings);
+{% for varying in varyings %}
+  spirv_cross_set_stage_input(shader, {{varying.location}}u, &inputs.components[{{varying.varying_offset}}u], {{varying.component_count}}u * sizeof(Scalar)); // {{varying.name}}
+{% endfor %}
+  Color color;
+{% if length(stage_outputs) > 0 %}
+  spirv_cross_set_stage_output(shader, {{stage_outputs.0.location}}u, &color, sizeof(color)); // {{stage_outputs.0.name}}
+{% endif %}
+  {{entrypoint}}_interface()->invoke(shader);
+  return color;
+}
+
+const NativeShaderSW& Shader::GetNativeShaderSW() {
+  static constexpr auto kShader =
+      NativeShaderSW::Fragment(Shader::kEntrypointName, InvokeShader);
+  return kShader;
+}
+{% endif %}
+
+}  // namespace impeller
+
+namespace {
+
+// clang-format off
+{{cpp_source}}
+// clang-format on
+
+}  // namespace
+)~~";
+
 }  // namespace compiler
 }  // namespace impeller
@@ -331,6 +331,7 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
     return;
   }
 
+  reflector_options.has_native_shader_sw = options_.generate_cpp;
   reflector_ = std::make_unique<Reflector>(std::move(reflector_options),
                                            parsed_ir, msl_compiler);
 
@@ -339,6 +340,28 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
     return;
   }
 
+  // C++ Generation.
+  if (options_.generate_cpp) {
+    if (!msl_compiler->get_shader_resources().sampled_images.empty()) {
+      COMPILER_ERROR << "Sampled images are not supported by the C++ target.";
+      return;
+    }
+
+    spirv_cross::CompilerCPP cpp_compiler(*parsed_ir);
+    cpp_compiler.rename_entry_point("main", options_.entry_point_name,
+                                    ToExecutionModel(options_.type));
+    // Multiple shaders are linked into the same binary. Give each interface a
+    // unique symbol name.
+    cpp_compiler.set_interface_name(options_.entry_point_name + "_interface");
+
+    cpp_source_ = reflector_->GenerateCPPShader(cpp_compiler.compile());
+
+    if (!cpp_source_) {
+      COMPILER_ERROR << "Could not generate C++ from SPIRV";
+      return;
+    }
+  }
+
   is_valid_ = true;
 }
 
@@ -368,6 +391,10 @@ std::unique_ptr<fml::Mapping> Compiler::GetMSLShaderSource() const {
       [string = msl_string_](auto, auto) mutable { string.reset(); });
 }
 
+std::shared_ptr<fml::Mapping> Compiler::GetCPPShaderSource() const {
+  return cpp_source_;
+}
+
 bool Compiler::IsValid() const {
   return is_valid_;
 }
@@ -13,6 +13,7 @@
 #include "flutter/impeller/compiler/include_dir.h"
 #include "flutter/impeller/compiler/reflector.h"
 #include "shaderc/shaderc.hpp"
+#include "third_party/spirv_cross/spirv_cpp.hpp"
 #include "third_party/spirv_cross/spirv_msl.hpp"
 #include "third_party/spirv_cross/spirv_parser.hpp"
 
@@ -45,6 +46,11 @@ class Compiler {
     std::vector<IncludeDir> include_dirs;
     std::string file_name = "main.glsl";
     std::string entry_point_name = "main";
+    //--------------------------------------------------------------------------
+    /// Whether to also generate C++ that the software backend can execute on
+    /// the host.
+    ///
+    bool generate_cpp = false;
 
     SourceOptions() = default;
 
@@ -64,6 +70,8 @@ class Compiler {
 
   std::unique_ptr<fml::Mapping> GetMSLShaderSource() const;
 
+  std::shared_ptr<fml::Mapping> GetCPPShaderSource() const;
+
   std::string GetErrorMessages() const;
 
   const std::vector<std::string>& GetIncludedFileNames() const;
@@ -77,6 +85,7 @@ class Compiler {
   SourceOptions options_;
   std::shared_ptr<shaderc::SpvCompilationResult> spv_result_;
   std::shared_ptr<std::string> msl_string_;
+  std::shared_ptr<fml::Mapping> cpp_source_;
   std::stringstream error_stream_;
   std::unique_ptr<Reflector> reflector_;
   std::vector<std::string> included_file_names_;
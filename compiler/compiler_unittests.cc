@@ -23,7 +23,8 @@ class CompilerTest : public ::testing::Test {
 
   ~CompilerTest() = default;
 
-  bool CanCompileFixture(const char* fixture_name) const {
+  bool CanCompileFixture(const char* fixture_name,
+                         bool generate_cpp = false) const {
     auto fixture = flutter::testing::OpenFixtureAsMapping(fixture_name);
     if (!fixture->GetMapping()) {
       VALIDATION_LOG << "Could not find shader in fixtures: " << fixture_name;
@@ -33,12 +34,17 @@ class CompilerTest : public ::testing::Test {
     compiler_options.target_platform = Compiler::TargetPlatform::kMacOS;
     compiler_options.working_directory = std::make_shared<fml::UniqueFD>(
         flutter::testing::OpenFixturesDirectory());
+    compiler_options.generate_cpp = generate_cpp;
     Reflector::Options reflector_options;
     Compiler compiler(*fixture.get(), compiler_options, reflector_options);
     if (!compiler.IsValid()) {
       VALIDATION_LOG << "Compilation failed: " << compiler.GetErrorMessages();
       return false;
     }
+    if (generate_cpp && !compiler.GetCPPShaderSource()) {
+      VALIDATION_LOG << "C++ shader source was not generated.";
+      return false;
+    }
     return true;
   }
 
@@ -63,6 +69,14 @@ TEST_F(CompilerTest, CanCompileSample) {
   ASSERT_TRUE(CanCompileFixture("sample.vert"));
 }
 
+TEST_F(CompilerTest, CanCompileFixtureToCPP) {
+  ASSERT_TRUE(CanCompileFixture("box_fade.vert", true));
+}
+
+TEST_F(CompilerTest, CPPTargetRejectsSampledImages) {
+  ASSERT_FALSE(CanCompileFixture("sample.vert", true));
+}
+
 }  // namespace testing
 }  // namespace compiler
 }  // namespace impeller
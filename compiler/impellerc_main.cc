@@ -45,6 +45,7 @@ bool Main(const fml::CommandLine& command_line) {
   options.entry_point_name = Compiler::EntryPointFromSourceName(
       switches.source_file_name,
       Compiler::SourceTypeFromFileName(switches.source_file_name));
+  options.generate_cpp = !switches.cpp_file_name.empty();
 
   Reflector::Options reflector_options;
   reflector_options.shader_name =
@@ -108,6 +109,16 @@ bool Main(const fml::CommandLine& command_line) {
     }
   }
 
+  if (!switches.cpp_file_name.empty()) {
+    if (!fml::WriteAtomically(*switches.working_directory,
+                              switches.cpp_file_name.c_str(),
+                              *compiler.GetCPPShaderSource())) {
+      std::cerr << "Could not write C++ shader to " << switches.cpp_file_name
+                << std::endl;
+      return false;
+    }
+  }
+
   if (!switches.depfile_path.empty()) {
     if (!fml::WriteAtomically(
             *switches.working_directory, switches.depfile_path.c_str(),
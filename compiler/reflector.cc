@@ -5,6 +5,7 @@
 #include "flutter/impeller/compiler/reflector.h"
 
 #include <atomic>
+#include <map>
 #include <optional>
 #include <set>
 #include <sstream>
@@ -162,6 +163,7 @@ std::optional<nlohmann::json> Reflector::GenerateTemplateArguments() const {
     root["shader_stage"] =
         ExecutionModelToString(entrypoints.front().execution_model);
     root["header_file_name"] = options_.header_file_name;
+    root["has_native_shader_sw"] = options_.has_native_shader_sw;
   }
 
   const auto shader_resources = compiler_->get_shader_resources();
@@ -247,15 +249,50 @@ std::optional<nlohmann::json> Reflector::GenerateTemplateArguments() const {
 }
 
 std::shared_ptr<fml::Mapping> Reflector::GenerateReflectionHeader() const {
-  return InflateTemplate(kReflectionHeaderTemplate);
+  return InflateTemplate(kReflectionHeaderTemplate, *template_arguments_);
 }
 
 std::shared_ptr<fml::Mapping> Reflector::GenerateReflectionCC() const {
-  return InflateTemplate(kReflectionCCTemplate);
+  return InflateTemplate(kReflectionCCTemplate, *template_arguments_);
+}
+
+std::shared_ptr<fml::Mapping> Reflector::GenerateCPPShader(
+    std::string cpp_source) const {
+  if (!is_valid_) {
+    return nullptr;
+  }
+
+  auto arguments = *template_arguments_;
+  arguments["cpp_source"] = std::move(cpp_source);
+
+  // Varyings are packed into consecutive components in location order. The
+  // outputs of a vertex stage have the same types and locations as the inputs
+  // of the fragment stage it is linked with so both stages agree on the
+  // layout.
+  const auto is_vertex = arguments["shader_stage"] == "vertex";
+  std::map<uint32_t, nlohmann::json> varyings_by_location;
+  for (const auto& varying :
+       arguments[is_vertex ? "stage_outputs" : "stage_inputs"]) {
+    varyings_by_location[varying["location"].get<uint32_t>()] = varying;
+  }
+  size_t varying_count = 0u;
+  auto& varyings = arguments["varyings"] = nlohmann::json::array_t{};
+  for (auto& [location, varying] : varyings_by_location) {
+    const auto component_count = varying["type"]["vec_size"].get<size_t>() *
+                                 varying["type"]["columns"].get<size_t>();
+    varying["varying_offset"] = varying_count;
+    varying["component_count"] = component_count;
+    varying_count += component_count;
+    varyings.emplace_back(std::move(varying));
+  }
+  arguments["varying_count"] = varying_count;
+
+  return InflateTemplate(kShaderCPPTemplate, arguments);
 }
 
 std::shared_ptr<fml::Mapping> Reflector::InflateTemplate(
-    const std::string_view& tmpl) const {
+    const std::string_view& tmpl,
+    const nlohmann::json& arguments) const {
   inja::Environment env;
   env.set_trim_blocks(true);
   env.set_lstrip_blocks(true);
@@ -269,7 +306,7 @@ std::shared_ptr<fml::Mapping> Reflector::InflateTemplate(
   });
 
   auto inflated_template =
-      std::make_shared<std::string>(env.render(tmpl, *template_arguments_));
+      std::make_shared<std::string>(env.render(tmpl, arguments));
 
   return std::make_shared<fml::NonOwnedMapping>(
       reinterpret_cast<const uint8_t*>(inflated_template->data()),
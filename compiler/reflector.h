@@ -28,6 +28,9 @@ class Reflector {
   struct Options {
     std::string shader_name;
     std::string header_file_name;
+    /// Whether the C++ shader is generated along with the reflection header,
+    /// in which case the header declares its accessor.
+    bool has_native_shader_sw = false;
   };
 
   Reflector(Options options,
@@ -44,6 +47,17 @@ class Reflector {
 
   std::shared_ptr<fml::Mapping> GetReflectionCC() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps C++ generated by `spirv_cross::CompilerCPP` in an
+  ///             adapter that exposes the shader to the software backend using
+  ///             the same structs as the reflection header.
+  ///
+  /// @param[in]  cpp_source  The C++ source generated by spirv_cross.
+  ///
+  /// @return     The translation unit to compile into the host binary.
+  ///
+  std::shared_ptr<fml::Mapping> GenerateCPPShader(std::string cpp_source) const;
+
  private:
   struct StructDefinition {
     std::string name;
@@ -79,7 +93,8 @@ class Reflector {
   std::shared_ptr<fml::Mapping> GenerateReflectionCC() const;
 
   std::shared_ptr<fml::Mapping> InflateTemplate(
-      const std::string_view& tmpl) const;
+      const std::string_view& tmpl,
+      const nlohmann::json& arguments) const;
 
   std::optional<nlohmann::json::object_t> ReflectResource(
       const spirv_cross::Resource& resource) const;
@@ -31,6 +31,7 @@ void Switches::PrintHelp(std::ostream& stream) {
   stream << "[optional] --reflection-header=<reflection_header_file>"
          << std::endl;
   stream << "[optional] --reflection-cc=<reflection_cc_file>" << std::endl;
+  stream << "[optional] --cpp=<cpp_output_file>" << std::endl;
   stream << "[optional,multiple] --include=<include_directory>" << std::endl;
   stream << "[optional] --depfile=<depfile_path>" << std::endl;
 }
@@ -72,6 +73,7 @@ Switches::Switches(const fml::CommandLine& command_line)
           command_line.GetOptionValueWithDefault("reflection-header", "")),
       reflection_cc_name(
           command_line.GetOptionValueWithDefault("reflection-cc", "")),
+      cpp_file_name(command_line.GetOptionValueWithDefault("cpp", "")),
       depfile_path(command_line.GetOptionValueWithDefault("depfile", "")) {
   if (!working_directory || !working_directory->is_valid()) {
     return;
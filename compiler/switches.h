@@ -26,6 +26,7 @@ struct Switches {
   std::string reflection_json_name;
   std::string reflection_header_name;
   std::string reflection_cc_name;
+  std::string cpp_file_name;
   std::string depfile_path;
 
   Switches();
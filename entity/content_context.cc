@@ -5,58 +5,210 @@
 #include "impeller/entity/content_context.h"
 
 #include <sstream>
+#include <thread>
+
+#include "impeller/base/strings.h"
+#include "impeller/base/validation.h"
 
 namespace impeller {
 
-ContentContext::ContentContext(std::shared_ptr<Context> context)
+static void ApplyBlendModeToColorAttachment(
+    ColorAttachmentDescriptor& color,
+    Entity::BlendMode blend_mode) {
+  color.blending_enabled = true;
+  switch (blend_mode) {
+    case Entity::BlendMode::kClear:
+      color.src_color_blend_factor = BlendFactor::kZero;
+      color.dst_color_blend_factor = BlendFactor::kZero;
+      color.src_alpha_blend_factor = BlendFactor::kZero;
+      color.dst_alpha_blend_factor = BlendFactor::kZero;
+      break;
+    case Entity::BlendMode::kSource:
+      color.blending_enabled = false;
+      break;
+    case Entity::BlendMode::kDestination:
+      color.src_color_blend_factor = BlendFactor::kZero;
+      color.dst_color_blend_factor = BlendFactor::kOne;
+      color.src_alpha_blend_factor = BlendFactor::kZero;
+      color.dst_alpha_blend_factor = BlendFactor::kOne;
+      break;
+    case Entity::BlendMode::kSourceOver:
+      color.src_color_blend_factor = BlendFactor::kSourceAlpha;
+      color.dst_color_blend_factor = BlendFactor::kOneMinusSourceAlpha;
+      color.src_alpha_blend_factor = BlendFactor::kSourceAlpha;
+      color.dst_alpha_blend_factor = BlendFactor::kOneMinusSourceAlpha;
+      break;
+    case Entity::BlendMode::kPlus:
+      color.src_color_blend_factor = BlendFactor::kSourceAlpha;
+      color.dst_color_blend_factor = BlendFactor::kOne;
+      color.src_alpha_blend_factor = BlendFactor::kSourceAlpha;
+      color.dst_alpha_blend_factor = BlendFactor::kOne;
+      break;
+  }
+  color.color_blend_op = BlendOperation::kAdd;
+  color.alpha_blend_op = BlendOperation::kAdd;
+}
+
+ContentContext::Options ContentContext::MakeClipOptions(Options options) {
+  // Write to the stencil buffer.
+  options.stencil_compare = CompareFunction::kGreaterEqual;
+  options.stencil_operation = StencilOperation::kSetToReferenceValue;
+  // Disable write to all color attachments.
+  options.color_write_mask = static_cast<uint64_t>(ColorWriteMask::kNone);
+  return options;
+}
+
+void ContentContext::ApplyOptionsToDescriptor(PipelineDescriptor& desc,
+                                              const Options& options) {
+  desc.SetSampleCount(options.sample_count);
+
+  auto color_attachments = desc.GetColorAttachmentDescriptors();
+  for (auto& color_attachment : color_attachments) {
+    ApplyBlendModeToColorAttachment(color_attachment.second,
+                                    options.blend_mode);
+    color_attachment.second.write_mask = options.color_write_mask;
+  }
+  desc.SetColorAttachmentDescriptors(std::move(color_attachments));
+
+  auto stencil = desc.GetFrontStencilAttachmentDescriptor();
+  if (stencil.has_value()) {
+    stencil->stencil_compare = options.stencil_compare;
+    stencil->depth_stencil_pass = options.stencil_operation;
+    desc.SetStencilAttachmentDescriptors(stencil.value());
+  }
+}
+
+ContentContext::ContentContext(std::shared_ptr<Context> context,
+                               const std::vector<Options>& expected_options)
     : context_(std::move(context)) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
 
-  // Pipelines whose default descriptors work fine for the entity framework.
-  gradient_fill_pipelines_[{}] =
-      std::make_unique<GradientFillPipeline>(*context_);
-  solid_fill_pipelines_[{}] = std::make_unique<SolidFillPipeline>(*context_);
-  texture_pipelines_[{}] = std::make_unique<TexturePipeline>(*context_);
-  solid_stroke_pipelines_[{}] =
-      std::make_unique<SolidStrokePipeline>(*context_);
-
-  // Pipelines that are variants of the base pipelines with custom descriptors.
-  if (auto solid_fill_pipeline = solid_fill_pipelines_[{}]->WaitAndGet()) {
-    auto clip_pipeline_descriptor = solid_fill_pipeline->GetDescriptor();
-    clip_pipeline_descriptor.SetLabel("Clip Pipeline");
-    // Write to the stencil buffer.
-    StencilAttachmentDescriptor stencil0;
-    stencil0.stencil_compare = CompareFunction::kGreaterEqual;
-    stencil0.depth_stencil_pass = StencilOperation::kSetToReferenceValue;
-    clip_pipeline_descriptor.SetStencilAttachmentDescriptors(stencil0);
-    // Disable write to all color attachments.
-    auto color_attachments =
-        clip_pipeline_descriptor.GetColorAttachmentDescriptors();
-    for (auto& color_attachment : color_attachments) {
-      color_attachment.second.write_mask =
-          static_cast<uint64_t>(ColorWriteMask::kNone);
+  auto gradient_fill_desc =
+      GradientFillPipeline::Builder::MakeDefaultPipelineDescriptor(*context_);
+  auto solid_fill_desc =
+      SolidFillPipeline::Builder::MakeDefaultPipelineDescriptor(*context_);
+  auto texture_desc =
+      TexturePipeline::Builder::MakeDefaultPipelineDescriptor(*context_);
+  auto solid_stroke_desc =
+      SolidStrokePipeline::Builder::MakeDefaultPipelineDescriptor(*context_);
+  if (!gradient_fill_desc.has_value() || !solid_fill_desc.has_value() ||
+      !texture_desc.has_value() || !solid_stroke_desc.has_value()) {
+    return;
+  }
+
+  texture_pool_ =
+      std::make_unique<TexturePool>(context_->GetPermanentsAllocator());
+  raster_cache_ = std::make_unique<RasterCache>();
+
+  // None of these wait for the pipelines to be created. The library builds
+  // them concurrently.
+  std::vector<PipelineFuture> futures;
+  CreatePipelines(gradient_fill_pipelines_, gradient_fill_desc.value(),
+                  expected_options, futures);
+  CreatePipelines(texture_pipelines_, texture_desc.value(), expected_options,
+                  futures);
+  CreatePipelines(solid_stroke_pipelines_, solid_stroke_desc.value(),
+                  expected_options, futures);
+  // Clips are drawn with solid fill variants. Create the ones that will be
+  // needed up front too.
+  auto solid_fill_options = expected_options;
+  solid_fill_options.push_back(MakeClipOptions({}));
+  for (const auto& opts : expected_options) {
+    solid_fill_options.push_back(MakeClipOptions(opts));
+  }
+  CreatePipelines(solid_fill_pipelines_, solid_fill_desc.value(),
+                  solid_fill_options, futures);
+
+  // The thread owns the futures and the promise. So neither the content
+  // context nor its destructor ever wait for the pipelines to be created.
+  std::promise<bool> ready;
+  pipelines_ready_ = ready.get_future().share();
+  std::thread([ready = std::move(ready),
+               futures = std::move(futures)]() mutable {
+    for (const auto& future : futures) {
+      if (!future.get()) {
+        ready.set_value(false);
+        return;
+      }
     }
-    clip_pipeline_descriptor.SetColorAttachmentDescriptors(
-        std::move(color_attachments));
-    clip_pipelines_[{}] = std::make_unique<ClipPipeline>(
-        *context_, std::move(clip_pipeline_descriptor));
-  } else {
+    ready.set_value(true);
+  }).detach();
+
+  // Nothing can be drawn without the prototypes. Wait for those alone, the
+  // variants continue to be created in the background.
+  if (!gradient_fill_pipelines_.variants[{}]->WaitAndGet() ||
+      !solid_fill_pipelines_.variants[{}]->WaitAndGet() ||
+      !texture_pipelines_.variants[{}]->WaitAndGet() ||
+      !solid_stroke_pipelines_.variants[{}]->WaitAndGet()) {
+    VALIDATION_LOG << "Could not create the prototype pipelines of the "
+                      "content context.";
     return;
   }
 
   is_valid_ = true;
 }
 
+template <class TypedPipeline>
+void ContentContext::CreatePipelines(
+    Pipelines<TypedPipeline>& pipelines,
+    const PipelineDescriptor& prototype_desc,
+    const std::vector<Options>& expected_options,
+    std::vector<PipelineFuture>& futures) {
+  pipelines.prototype_desc = prototype_desc;
+  ApplyOptionsToDescriptor(pipelines.prototype_desc, {});
+  auto prototype_future =
+      CreatePipelineFuture(*context_, pipelines.prototype_desc);
+  futures.push_back(prototype_future);
+  pipelines.variants[{}] =
+      std::make_unique<TypedPipeline>(std::move(prototype_future));
+
+  for (const auto& opts : expected_options) {
+    if (pipelines.variants.find(opts) != pipelines.variants.end()) {
+      continue;
+    }
+    futures.push_back(CreateVariant(pipelines, opts).GetFuture());
+  }
+}
+
 ContentContext::~ContentContext() = default;
 
 bool ContentContext::IsValid() const {
   return is_valid_;
 }
 
+std::shared_future<bool> ContentContext::GetPipelinesReady() const {
+  return pipelines_ready_;
+}
+
+void ContentContext::SetPipelineAcquisition(PipelineAcquisition acquisition) {
+  acquisition_ = acquisition;
+}
+
+ContentContext::PipelineAcquisition ContentContext::GetPipelineAcquisition()
+    const {
+  return acquisition_;
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
 
+TexturePool& ContentContext::GetTexturePool() const {
+  return *texture_pool_;
+}
+
+RasterCache& ContentContext::GetRasterCache() const {
+  return *raster_cache_;
+}
+
+void ContentContext::EndFrame() const {
+  // The offscreen targets of this frame are still referenced by the commands
+  // that draw them into their parent passes. They only become available for
+  // reuse once those are gone.
+  texture_pool_->EndFrame();
+  raster_cache_->EndFrame();
+}
+
 }  // namespace impeller
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
+#include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
@@ -17,7 +20,10 @@
 #include "flutter/impeller/entity/solid_stroke.vert.h"
 #include "flutter/impeller/entity/texture_fill.frag.h"
 #include "flutter/impeller/entity/texture_fill.vert.h"
+#include "impeller/entity/entity.h"
+#include "impeller/entity/raster_cache.h"
 #include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/texture_pool.h"
 
 namespace impeller {
 
@@ -29,34 +35,98 @@ using TexturePipeline =
     PipelineT<TextureFillVertexShader, TextureFillFragmentShader>;
 using SolidStrokePipeline =
     PipelineT<SolidStrokeVertexShader, SolidStrokeFragmentShader>;
-// Instead of requiring new shaders for clips,  the solid fill stages are used
-// to redirect writing to the stencil instead of color attachments.
-using ClipPipeline = PipelineT<SolidFillVertexShader, SolidFillFragmentShader>;
+// Instead of requiring new shaders for clips, a variant of the solid fill
+// pipeline redirects writing to the stencil instead of color attachments.
+using ClipPipeline = SolidFillPipeline;
 
 class ContentContext {
  public:
+  enum class PipelineAcquisition {
+    /// Block the calling thread until the pipeline has been created.
+    kWait,
+    /// Return null if the pipeline has not been created yet. Contents then
+    /// draw with a cheaper fallback pipeline or skip the draw. Either is
+    /// accounted for in the frame statistics of the pass.
+    kNoWait,
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The state pipeline variants differ in. Every pipeline is
+  ///             built from a single prototype and a variant is created for
+  ///             each combination of options it is requested with.
+  ///
   struct Options {
     SampleCount sample_count = SampleCount::kCount1;
+    Entity::BlendMode blend_mode = Entity::BlendMode::kSourceOver;
+    CompareFunction stencil_compare = CompareFunction::kLessEqual;
+    StencilOperation stencil_operation = StencilOperation::kKeep;
+    std::underlying_type_t<ColorWriteMask> color_write_mask =
+        static_cast<uint64_t>(ColorWriteMask::kAll);
 
     struct Hash {
       constexpr std::size_t operator()(const Options& o) const {
-        return fml::HashCombine(o.sample_count);
+        return fml::HashCombine(o.sample_count, o.blend_mode,
+                                o.stencil_compare, o.stencil_operation,
+                                o.color_write_mask);
       }
     };
 
     struct Equal {
       constexpr bool operator()(const Options& lhs, const Options& rhs) const {
-        return lhs.sample_count == rhs.sample_count;
+        return lhs.sample_count == rhs.sample_count &&
+               lhs.blend_mode == rhs.blend_mode &&
+               lhs.stencil_compare == rhs.stencil_compare &&
+               lhs.stencil_operation == rhs.stencil_operation &&
+               lhs.color_write_mask == rhs.color_write_mask;
       }
     };
   };
 
-  ContentContext(std::shared_ptr<Context> context);
+  //----------------------------------------------------------------------------
+  /// @brief      Create a content context and start building its pipelines.
+  ///
+  ///             Pipelines are created asynchronously by the pipeline library
+  ///             of the context. The constructor only waits for the prototype
+  ///             of each pipeline, and the content context is invalid if any
+  ///             of those could not be created. Variants of every pipeline
+  ///             for each of the expected options are requested up front so
+  ///             that the first frame to use them does not stall on pipeline
+  ///             creation. Variants for other options are still created
+  ///             lazily on first use. The pipeline getters may be called from
+  ///             multiple threads.
+  ///
+  /// @param[in]  context           The context.
+  /// @param[in]  expected_options  The options pipelines are expected to be
+  ///                               requested with. The default options are
+  ///                               always included.
+  ///
+  ContentContext(std::shared_ptr<Context> context,
+                 const std::vector<Options>& expected_options = {});
 
   ~ContentContext();
 
   bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a future that is realized once all the pipelines
+  ///             requested during construction have been created. The
+  ///             future is only valid if the content context is valid.
+  ///
+  /// @return     A future whose value is true if all pipelines were created
+  ///             successfully.
+  ///
+  std::shared_future<bool> GetPipelinesReady() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Set how the pipeline getters behave when the requested
+  ///             pipeline is still being created. By default, they wait for
+  ///             it. This must not be called while entities are being
+  ///             rendered.
+  ///
+  void SetPipelineAcquisition(PipelineAcquisition acquisition);
+
+  PipelineAcquisition GetPipelineAcquisition() const;
+
   std::shared_ptr<Pipeline> GetGradientFillPipeline(Options opts) const {
     return GetPipeline(gradient_fill_pipelines_, opts);
   }
@@ -73,59 +143,132 @@ class ContentContext {
     return GetPipeline(solid_stroke_pipelines_, opts);
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the solid fill pipeline variant that writes to the
+  ///             stencil instead of the color attachments. The stencil and
+  ///             color write mask of the options are overridden.
+  ///
   std::shared_ptr<Pipeline> GetClipPipeline(Options opts) const {
-    return GetPipeline(clip_pipelines_, opts);
+    return GetPipeline(solid_fill_pipelines_, MakeClipOptions(opts));
   }
 
   std::shared_ptr<Context> GetContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The pool the render targets of offscreen passes are recycled
+  ///             from. The pool is safe to use from multiple threads.
+  ///
+  TexturePool& GetTexturePool() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache the render targets of offscreen passes whose
+  ///             contents don't change are kept in across frames. Cached
+  ///             targets are released from the texture pool and only count
+  ///             against the budget of the cache. The cache is safe to use
+  ///             from multiple threads.
+  ///
+  RasterCache& GetRasterCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame. This ages the textures pooled for
+  ///             offscreen passes and the entries of the raster cache. Call it
+  ///             exactly once per frame, after everything in the frame was
+  ///             rendered, no matter how many passes or pictures the frame
+  ///             consists of.
+  ///
+  void EndFrame() const;
+
  private:
   std::shared_ptr<Context> context_;
+  std::unique_ptr<TexturePool> texture_pool_;
+  std::unique_ptr<RasterCache> raster_cache_;
 
   template <class T>
   using Variants = std::
       unordered_map<Options, std::unique_ptr<T>, Options::Hash, Options::Equal>;
 
-  // These are mutable because while the prototypes are created eagerly, any
-  // variants requested from that are lazily created and cached in the variants
-  // map.
-  mutable Variants<GradientFillPipeline> gradient_fill_pipelines_;
-  mutable Variants<SolidFillPipeline> solid_fill_pipelines_;
-  mutable Variants<TexturePipeline> texture_pipelines_;
-  mutable Variants<SolidStrokePipeline> solid_stroke_pipelines_;
-  mutable Variants<ClipPipeline> clip_pipelines_;
+  template <class T>
+  struct Pipelines {
+    // Variants are created from this descriptor instead of the descriptor of
+    // the prototype pipeline so that requesting one never has to wait for the
+    // prototype to be created.
+    PipelineDescriptor prototype_desc;
+    // Lookups only take a shared lock. The exclusive lock is only taken to
+    // insert a variant that did not exist yet. Variants are never removed and
+    // the typed pipelines are safe to use from multiple threads, so they may
+    // be used after the lock is released.
+    std::shared_mutex mutex;
+    Variants<T> variants;
+  };
+
+  // These are mutable because while the prototypes and the variants for the
+  // expected options are created eagerly, any other variants requested from
+  // that are lazily created and cached in the variants map. Each pipeline
+  // has its own lock so that lookups of different pipelines never contend.
+  mutable Pipelines<GradientFillPipeline> gradient_fill_pipelines_;
+  mutable Pipelines<SolidFillPipeline> solid_fill_pipelines_;
+  mutable Pipelines<TexturePipeline> texture_pipelines_;
+  mutable Pipelines<SolidStrokePipeline> solid_stroke_pipelines_;
+
+  std::shared_future<bool> pipelines_ready_;
+  PipelineAcquisition acquisition_ = PipelineAcquisition::kWait;
+
+  static Options MakeClipOptions(Options options);
 
   static void ApplyOptionsToDescriptor(PipelineDescriptor& desc,
-                                       const Options& options) {
-    desc.SetSampleCount(options.sample_count);
+                                       const Options& options);
+
+  template <class TypedPipeline>
+  void CreatePipelines(Pipelines<TypedPipeline>& pipelines,
+                       const PipelineDescriptor& prototype_desc,
+                       const std::vector<Options>& expected_options,
+                       std::vector<PipelineFuture>& futures);
+
+  template <class TypedPipeline>
+  TypedPipeline& CreateVariant(Pipelines<TypedPipeline>& pipelines,
+                               const Options& opts) const {
+    auto desc = pipelines.prototype_desc;
+    ApplyOptionsToDescriptor(desc, opts);
+    desc.SetLabel(SPrintF("%s V#%zu", desc.GetLabel().c_str(),
+                          pipelines.variants.size()));
+    auto variant = std::make_unique<TypedPipeline>(
+        CreatePipelineFuture(*context_, std::move(desc)));
+    auto& result = *variant;
+    pipelines.variants[opts] = std::move(variant);
+    return result;
   }
 
   template <class TypedPipeline>
-  std::shared_ptr<Pipeline> GetPipeline(Variants<TypedPipeline>& container,
+  std::shared_ptr<Pipeline> GetPipeline(Pipelines<TypedPipeline>& pipelines,
                                         Options opts) const {
     if (!IsValid()) {
       return nullptr;
     }
 
-    if (auto found = container.find(opts); found != container.end()) {
-      return found->second->WaitAndGet();
+    TypedPipeline* pipeline = nullptr;
+    {
+      std::shared_lock lock(pipelines.mutex);
+      if (auto found = pipelines.variants.find(opts);
+          found != pipelines.variants.end()) {
+        pipeline = found->second.get();
+      }
+    }
+    if (!pipeline) {
+      std::unique_lock lock(pipelines.mutex);
+      // Another thread may have created the variant in the meantime.
+      auto found = pipelines.variants.find(opts);
+      pipeline = found != pipelines.variants.end()
+                     ? found->second.get()
+                     : &CreateVariant(pipelines, opts);
     }
 
-    auto prototype = container.find({});
-
-    // The prototype must always be initialized in the constructor.
-    FML_CHECK(prototype != container.end());
-
-    auto variant_future = prototype->second->WaitAndGet()->CreateVariant(
-        [&opts, variants_count = container.size()](PipelineDescriptor& desc) {
-          ApplyOptionsToDescriptor(desc, opts);
-          desc.SetLabel(
-              SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
-        });
-    auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
-    auto variant_pipeline = variant->WaitAndGet();
-    container[opts] = std::move(variant);
-    return variant_pipeline;
+    switch (acquisition_) {
+      case PipelineAcquisition::kWait:
+        return pipeline->WaitAndGet();
+      case PipelineAcquisition::kNoWait:
+        return pipeline->GetIfReady();
+    }
+    FML_UNREACHABLE();
   }
 
   bool is_valid_ = false;
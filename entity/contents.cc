@@ -4,11 +4,16 @@
 
 #include "impeller/entity/contents.h"
 
+#include <chrono>
 #include <memory>
+#include <string_view>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "impeller/entity/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/entity_pass.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/render_pass.h"
@@ -19,12 +24,66 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Flattens and tessellates the path. The time taken is accounted
+///             for in the frame statistics of the pass.
+///
+static bool TessellatePath(RenderPass& pass,
+                           const Path& path,
+                           Tessellator::VertexCallback callback) {
+  const auto start = fml::TimePoint::Now();
+  const auto result = Tessellator{path.GetFillType()}.Tessellate(
+      path.CreatePolyline(), std::move(callback));
+  auto& stats = pass.GetStats();
+  stats.tessellation_time =
+      stats.tessellation_time + (fml::TimePoint::Now() - start);
+  return result;
+}
+
 static ContentContext::Options OptionsFromPass(const RenderPass& pass) {
   ContentContext::Options opts;
   opts.sample_count = pass.GetRenderTarget().GetSampleCount();
   return opts;
 }
 
+static ContentContext::Options OptionsFromPassAndEntity(
+    const RenderPass& pass,
+    const Entity& entity) {
+  auto opts = OptionsFromPass(pass);
+  opts.blend_mode = entity.GetBlendMode();
+  return opts;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Drops a draw whose pipeline is still being created or whose
+///             texture is still being uploaded. The frame is marked as
+///             incomplete instead of stalling.
+///
+static bool SkipDraw(RenderPass& pass) {
+  pass.GetStats().draws_skipped++;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Bind the frame info of the vertex shader and record its
+///             reflected binding on the command. The frame info of all entity
+///             shaders starts with the model view projection matrix.
+///
+template <class VS>
+static bool BindFrameInfo(Command& cmd, BufferView view) {
+  cmd.mvp_binding = VS::kResourceFrameInfo.binding;
+  return VS::BindFrameInfo(cmd, std::move(view));
+}
+
+static bool RenderSolidFill(const ContentContext& renderer,
+                            const Entity& entity,
+                            RenderPass& pass,
+                            Color color);
+
+static void HashCombineColor(std::size_t& seed, const Color& color) {
+  fml::HashCombineSeed(seed, color.red, color.green, color.blue, color.alpha);
+}
+
 /*******************************************************************************
  ******* Contents
  ******************************************************************************/
@@ -33,6 +92,33 @@ Contents::Contents() = default;
 
 Contents::~Contents() = default;
 
+std::optional<Rect> Contents::GetCoverage(const Entity& entity) const {
+  return entity.GetPath().GetBoundingBox();
+}
+
+bool Contents::IsOpaque() const {
+  return false;
+}
+
+bool Contents::CanInheritOpacity() const {
+  return false;
+}
+
+std::size_t Contents::GetHash() const {
+  return std::hash<const Contents*>{}(this);
+}
+
+bool Contents::HasModifiedTextures() const {
+  return false;
+}
+
+void Contents::CollectTextures(
+    std::vector<std::shared_ptr<const Texture>>& textures) const {}
+
+const EntityPass* Contents::GetReferencedPass() const {
+  return nullptr;
+}
+
 /*******************************************************************************
  ******* Linear Gradient Contents
  ******************************************************************************/
@@ -60,16 +146,55 @@ const std::vector<Color>& LinearGradientContents::GetColors() const {
   return colors_;
 }
 
+bool LinearGradientContents::IsOpaque() const {
+  return colors_.size() >= 2u && colors_[0].IsOpaque() &&
+         colors_[1].IsOpaque();
+}
+
+bool LinearGradientContents::CanInheritOpacity() const {
+  return true;
+}
+
+std::size_t LinearGradientContents::GetHash() const {
+  auto seed = fml::HashCombine(std::string_view{"LinearGradientContents"},
+                               start_point_.x, start_point_.y, end_point_.x,
+                               end_point_.y);
+  for (const auto& color : colors_) {
+    HashCombineColor(seed, color);
+  }
+  return seed;
+}
+
 bool LinearGradientContents::Render(const ContentContext& renderer,
                                     const Entity& entity,
                                     RenderPass& pass) const {
   using VS = GradientFillPipeline::VertexShader;
   using FS = GradientFillPipeline::FragmentShader;
 
+  const auto opacity = entity.GetOpacity();
+  const auto opts = OptionsFromPassAndEntity(pass, entity);
+  auto pipeline = renderer.GetGradientFillPipeline(opts);
+  if (!pipeline) {
+    // Without the fallback pipeline, the draw is only skipped.
+    if (!renderer.GetSolidFillPipeline(opts)) {
+      return SkipDraw(pass);
+    }
+    // Fill with the average of the end colors until the gradient pipeline is
+    // ready.
+    pass.GetStats().pipeline_fallbacks++;
+    const auto start = colors_[0].WithAlpha(colors_[0].alpha * opacity);
+    const auto end = colors_[1].WithAlpha(colors_[1].alpha * opacity);
+    return RenderSolidFill(renderer, entity, pass,
+                           {(start.red + end.red) * 0.5f,
+                            (start.green + end.green) * 0.5f,
+                            (start.blue + end.blue) * 0.5f,
+                            (start.alpha + end.alpha) * 0.5f});
+  }
+
   auto vertices_builder = VertexBufferBuilder<VS::PerVertexData>();
   {
-    auto result = Tessellator{entity.GetPath().GetFillType()}.Tessellate(
-        entity.GetPath().CreatePolyline(), [&vertices_builder](Point point) {
+    auto result = TessellatePath(
+        pass, entity.GetPath(), [&vertices_builder](Point point) {
           VS::PerVertexData vtx;
           vtx.vertices = point;
           vertices_builder.AppendVertex(vtx);
@@ -86,19 +211,22 @@ bool LinearGradientContents::Render(const ContentContext& renderer,
   FS::GradientInfo gradient_info;
   gradient_info.start_point = start_point_;
   gradient_info.end_point = end_point_;
-  gradient_info.start_color = colors_[0];
-  gradient_info.end_color = colors_[1];
+  gradient_info.start_color =
+      colors_[0].WithAlpha(colors_[0].alpha * opacity);
+  gradient_info.end_color = colors_[1].WithAlpha(colors_[1].alpha * opacity);
 
   Command cmd;
   cmd.label = "LinearGradientFill";
-  cmd.pipeline = renderer.GetGradientFillPipeline(OptionsFromPass(pass));
+  cmd.pipeline = std::move(pipeline);
   cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.scissor = entity.GetScissor();
   cmd.BindVertices(
       vertices_builder.CreateVertexBuffer(pass.GetTransientsBuffer()));
   cmd.primitive_type = PrimitiveType::kTriangle;
   FS::BindGradientInfo(
       cmd, pass.GetTransientsBuffer().EmplaceUniform(gradient_info));
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+  BindFrameInfo<VS>(cmd,
+                    pass.GetTransientsBuffer().EmplaceUniform(frame_info));
   return pass.AddCommand(std::move(cmd));
 }
 
@@ -118,14 +246,28 @@ const Color& SolidColorContents::GetColor() const {
   return color_;
 }
 
+bool SolidColorContents::IsOpaque() const {
+  return color_.IsOpaque();
+}
+
+bool SolidColorContents::CanInheritOpacity() const {
+  return true;
+}
+
+std::size_t SolidColorContents::GetHash() const {
+  auto seed = fml::HashCombine(std::string_view{"SolidColorContents"});
+  HashCombineColor(seed, color_);
+  return seed;
+}
+
 static VertexBuffer CreateSolidFillVertices(const Path& path,
-                                            HostBuffer& buffer) {
+                                            RenderPass& pass) {
   using VS = SolidFillPipeline::VertexShader;
 
   VertexBufferBuilder<VS::PerVertexData> vtx_builder;
 
-  auto tesselation_result = Tessellator{path.GetFillType()}.Tessellate(
-      path.CreatePolyline(), [&vtx_builder](auto point) {
+  auto tesselation_result =
+      TessellatePath(pass, path, [&vtx_builder](auto point) {
         VS::PerVertexData vtx;
         vtx.vertices = point;
         vtx_builder.AppendVertex(vtx);
@@ -134,30 +276,39 @@ static VertexBuffer CreateSolidFillVertices(const Path& path,
     return {};
   }
 
-  return vtx_builder.CreateVertexBuffer(buffer);
+  return vtx_builder.CreateVertexBuffer(pass.GetTransientsBuffer());
 }
 
-bool SolidColorContents::Render(const ContentContext& renderer,
-                                const Entity& entity,
-                                RenderPass& pass) const {
-  if (color_.IsTransparent()) {
+static bool RenderSolidFill(const ContentContext& renderer,
+                            const Entity& entity,
+                            RenderPass& pass,
+                            Color color) {
+  if (color.IsTransparent()) {
     return true;
   }
 
   using VS = SolidFillPipeline::VertexShader;
 
+  auto pipeline =
+      renderer.GetSolidFillPipeline(OptionsFromPassAndEntity(pass, entity));
+  if (!pipeline) {
+    return SkipDraw(pass);
+  }
+
   Command cmd;
   cmd.label = "SolidFill";
-  cmd.pipeline = renderer.GetSolidFillPipeline(OptionsFromPass(pass));
+  cmd.pipeline = std::move(pipeline);
   cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.scissor = entity.GetScissor();
   cmd.BindVertices(
-      CreateSolidFillVertices(entity.GetPath(), pass.GetTransientsBuffer()));
+      CreateSolidFillVertices(entity.GetPath(), pass));
 
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation();
-  frame_info.color = color_;
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+  frame_info.color = color;
+  BindFrameInfo<VS>(cmd,
+                    pass.GetTransientsBuffer().EmplaceUniform(frame_info));
 
   cmd.primitive_type = PrimitiveType::kTriangle;
 
@@ -168,6 +319,13 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool SolidColorContents::Render(const ContentContext& renderer,
+                                const Entity& entity,
+                                RenderPass& pass) const {
+  return RenderSolidFill(renderer, entity, pass,
+                         color_.WithAlpha(color_.alpha * entity.GetOpacity()));
+}
+
 std::unique_ptr<SolidColorContents> SolidColorContents::Make(Color color) {
   auto contents = std::make_unique<SolidColorContents>();
   contents->SetColor(color);
@@ -184,12 +342,18 @@ TextureContents::~TextureContents() = default;
 
 void TextureContents::SetTexture(std::shared_ptr<Texture> texture) {
   texture_ = std::move(texture);
+  texture_generation_ = texture_ ? texture_->GetContentsGeneration() : 0u;
+  drawn_generation_ = texture_generation_;
 }
 
 std::shared_ptr<Texture> TextureContents::GetTexture() const {
   return texture_;
 }
 
+void TextureContents::SetTextureUpload(std::shared_future<bool> upload) {
+  texture_upload_ = std::move(upload);
+}
+
 void TextureContents::SetOpacity(Scalar opacity) {
   opacity_ = opacity;
 }
@@ -201,6 +365,19 @@ bool TextureContents::Render(const ContentContext& renderer,
     return true;
   }
 
+  drawn_generation_ = texture_->GetContentsGeneration();
+
+  if (texture_upload_.valid()) {
+    if (texture_upload_.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return SkipDraw(pass);
+    }
+    // The contents of a texture whose upload failed are undefined.
+    if (!texture_upload_.get()) {
+      return true;
+    }
+  }
+
   using VS = TextureFillVertexShader;
   using FS = TextureFillFragmentShader;
 
@@ -223,18 +400,25 @@ bool TextureContents::Render(const ContentContext& renderer,
     return true;
   }
 
+  // The coverage of the entity maps to the source rect of the texture.
+  const auto source_rect = Rect(source_rect_);
+  const auto texture_bounds = Size(texture_size);
+
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
   {
-    const auto tess_result =
-        Tessellator{entity.GetPath().GetFillType()}.Tessellate(
-            entity.GetPath().CreatePolyline(),
-            [&vertex_builder, &coverage_rect](Point vtx) {
-              VS::PerVertexData data;
-              data.vertices = vtx;
-              data.texture_coords =
-                  ((vtx - coverage_rect->origin) / coverage_rect->size);
-              vertex_builder.AppendVertex(data);
-            });
+    const auto tess_result = TessellatePath(
+        pass, entity.GetPath(),
+        [&vertex_builder, &coverage_rect, &source_rect,
+         &texture_bounds](Point vtx) {
+          VS::PerVertexData data;
+          data.vertices = vtx;
+          data.texture_coords =
+              (source_rect.origin + (vtx - coverage_rect->origin) /
+                                        coverage_rect->size *
+                                        source_rect.size) /
+              texture_bounds;
+          vertex_builder.AppendVertex(data);
+        });
     if (!tess_result) {
       return false;
     }
@@ -244,19 +428,26 @@ bool TextureContents::Render(const ContentContext& renderer,
     return true;
   }
 
+  auto pipeline =
+      renderer.GetTexturePipeline(OptionsFromPassAndEntity(pass, entity));
+  if (!pipeline) {
+    return SkipDraw(pass);
+  }
+
   auto& host_buffer = pass.GetTransientsBuffer();
 
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation();
-  frame_info.alpha = opacity_;
+  frame_info.alpha = opacity_ * entity.GetOpacity();
 
   Command cmd;
   cmd.label = "TextureFill";
-  cmd.pipeline = renderer.GetTexturePipeline(OptionsFromPass(pass));
+  cmd.pipeline = std::move(pipeline);
   cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.scissor = entity.GetScissor();
   cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
-  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  BindFrameInfo<VS>(cmd, host_buffer.EmplaceUniform(frame_info));
   FS::BindTextureSampler(
       cmd, texture_,
       renderer.GetContext()->GetSamplerLibrary()->GetSampler({}));
@@ -273,6 +464,46 @@ const IRect& TextureContents::GetSourceRect() const {
   return source_rect_;
 }
 
+bool TextureContents::IsOpaque() const {
+  if (!texture_ || !texture_->IsOpaque() || opacity_ < 1.0f ||
+      source_rect_.IsEmpty() || texture_->GetSize().IsEmpty()) {
+    return false;
+  }
+  // Textures whose uploads are pending or have failed aren't drawn.
+  if (texture_upload_.valid() &&
+      (texture_upload_.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready ||
+       !texture_upload_.get())) {
+    return false;
+  }
+  return true;
+}
+
+bool TextureContents::CanInheritOpacity() const {
+  return true;
+}
+
+std::size_t TextureContents::GetHash() const {
+  // Textures are compared by identity and by the generation of their contents
+  // when they were set. Textures modified in place later are caught by
+  // |HasModifiedTextures|.
+  return fml::HashCombine(std::string_view{"TextureContents"}, texture_.get(),
+                          texture_generation_, source_rect_.origin.x,
+                          source_rect_.origin.y, source_rect_.size.width,
+                          source_rect_.size.height, opacity_);
+}
+
+bool TextureContents::HasModifiedTextures() const {
+  return texture_ && texture_->GetContentsGeneration() != drawn_generation_;
+}
+
+void TextureContents::CollectTextures(
+    std::vector<std::shared_ptr<const Texture>>& textures) const {
+  if (texture_) {
+    textures.push_back(texture_);
+  }
+}
+
 /*******************************************************************************
  ******* SolidStrokeContents
  ******************************************************************************/
@@ -337,6 +568,12 @@ bool SolidStrokeContents::Render(const ContentContext& renderer,
 
   using VS = SolidStrokeVertexShader;
 
+  auto pipeline =
+      renderer.GetSolidStrokePipeline(OptionsFromPassAndEntity(pass, entity));
+  if (!pipeline) {
+    return SkipDraw(pass);
+  }
+
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation();
@@ -348,11 +585,13 @@ bool SolidStrokeContents::Render(const ContentContext& renderer,
   Command cmd;
   cmd.primitive_type = PrimitiveType::kTriangleStrip;
   cmd.label = "SolidStroke";
-  cmd.pipeline = renderer.GetSolidStrokePipeline(OptionsFromPass(pass));
+  cmd.pipeline = std::move(pipeline);
   cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.scissor = entity.GetScissor();
   cmd.BindVertices(
       CreateSolidStrokeVertices(entity.GetPath(), pass.GetTransientsBuffer()));
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+  BindFrameInfo<VS>(cmd,
+                    pass.GetTransientsBuffer().EmplaceUniform(frame_info));
   VS::BindStrokeInfo(cmd,
                      pass.GetTransientsBuffer().EmplaceUniform(stroke_info));
 
@@ -369,6 +608,26 @@ Scalar SolidStrokeContents::GetStrokeSize() const {
   return stroke_size_;
 }
 
+std::optional<Rect> SolidStrokeContents::GetCoverage(
+    const Entity& entity) const {
+  auto bounds = entity.GetPath().GetBoundingBox();
+  if (!bounds.has_value()) {
+    return std::nullopt;
+  }
+  // Vertices are pushed out by half the stroke size along unit normals.
+  const auto outset = stroke_size_ * 0.5f;
+  const auto ltrb = bounds->GetLTRB();
+  return Rect::MakeLTRB(ltrb[0] - outset, ltrb[1] - outset, ltrb[2] + outset,
+                        ltrb[3] + outset);
+}
+
+std::size_t SolidStrokeContents::GetHash() const {
+  auto seed = fml::HashCombine(std::string_view{"SolidStrokeContents"});
+  HashCombineColor(seed, color_);
+  fml::HashCombineSeed(seed, stroke_size_);
+  return seed;
+}
+
 /*******************************************************************************
  ******* ClipContents
  ******************************************************************************/
@@ -382,22 +641,89 @@ bool ClipContents::Render(const ContentContext& renderer,
                           RenderPass& pass) const {
   using VS = ClipPipeline::VertexShader;
 
+  // Skipping the clip leaves the stencil untouched. Draws inside the clip
+  // then fail the stencil test and are not drawn either.
+  auto pipeline = renderer.GetClipPipeline(OptionsFromPass(pass));
+  if (!pipeline) {
+    return SkipDraw(pass);
+  }
+
   Command cmd;
   cmd.label = "Clip";
-  cmd.pipeline = renderer.GetClipPipeline(OptionsFromPass(pass));
+  cmd.pipeline = std::move(pipeline);
   cmd.stencil_reference = entity.GetStencilDepth() + 1u;
+  cmd.scissor = entity.GetScissor();
   cmd.BindVertices(
-      CreateSolidFillVertices(entity.GetPath(), pass.GetTransientsBuffer()));
+      CreateSolidFillVertices(entity.GetPath(), pass));
 
   VS::FrameInfo info;
   // The color really doesn't matter.
   info.color = Color::SkyBlue();
   info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
 
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(info));
+  BindFrameInfo<VS>(cmd, pass.GetTransientsBuffer().EmplaceUniform(info));
 
   pass.AddCommand(std::move(cmd));
   return true;
 }
 
+std::size_t ClipContents::GetHash() const {
+  // Clips only depend on the path of the entity.
+  return fml::HashCombine(std::string_view{"ClipContents"});
+}
+
+/*******************************************************************************
+ ******* EntityPassContents
+ ******************************************************************************/
+
+EntityPassContents::EntityPassContents(std::shared_ptr<const EntityPass> pass)
+    : pass_(std::move(pass)) {}
+
+EntityPassContents::~EntityPassContents() = default;
+
+const std::shared_ptr<const EntityPass>& EntityPassContents::GetPass() const {
+  return pass_;
+}
+
+bool EntityPassContents::Render(const ContentContext& renderer,
+                                const Entity& entity,
+                                RenderPass& pass) const {
+  if (!pass_) {
+    return true;
+  }
+  return pass_->RenderReference(renderer, pass, entity.GetTransformation(),
+                                entity.GetStencilDepth(), entity.GetScissor());
+}
+
+std::optional<Rect> EntityPassContents::GetCoverage(
+    const Entity& entity) const {
+  if (!coverage_.has_value()) {
+    coverage_ = pass_ ? pass_->GetCoverage() : std::nullopt;
+  }
+  return coverage_.value();
+}
+
+std::size_t EntityPassContents::GetHash() const {
+  if (!hash_.has_value()) {
+    hash_ = fml::HashCombine(std::string_view{"EntityPassContents"},
+                             pass_ ? pass_->GetHash() : 0u);
+  }
+  return hash_.value();
+}
+
+bool EntityPassContents::HasModifiedTextures() const {
+  return pass_ && pass_->HasModifiedTextures();
+}
+
+void EntityPassContents::CollectTextures(
+    std::vector<std::shared_ptr<const Texture>>& textures) const {
+  if (pass_) {
+    pass_->CollectTextures(textures);
+  }
+}
+
+const EntityPass* EntityPassContents::GetReferencedPass() const {
+  return pass_.get();
+}
+
 }  // namespace impeller
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <future>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +20,7 @@ namespace impeller {
 
 class ContentContext;
 class Entity;
+class EntityPass;
 class Surface;
 class RenderPass;
 
@@ -30,6 +34,57 @@ class Contents {
                       const Entity& entity,
                       RenderPass& pass) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the bounds of the area these contents may touch when
+  ///             rendered for the entity. This is in the local coordinate space
+  ///             of the entity and may be conservative.
+  ///
+  /// @return     The coverage or std::nullopt if nothing will be drawn.
+  ///
+  virtual std::optional<Rect> GetCoverage(const Entity& entity) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether rendering these contents fills the entire path of the
+  ///             entity with opaque colors. Whatever was drawn beneath such
+  ///             contents may be culled.
+  ///
+  virtual bool IsOpaque() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether these contents multiply everything they draw by the
+  ///             opacity of the entity. Drawing them with an opacity then looks
+  ///             the same as drawing them into a layer that is composited with
+  ///             that opacity.
+  ///
+  virtual bool CanInheritOpacity() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of everything that affects how these contents render.
+  ///             Contents with equal hashes render the same entity identically.
+  ///             Unless overridden, contents only hash equal to themselves.
+  ///
+  virtual std::size_t GetHash() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether textures drawn by these contents were modified in
+  ///             place since they were last drawn. Such contents render
+  ///             differently even though their hash is unchanged.
+  ///
+  virtual bool HasModifiedTextures() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Append the textures drawn by these contents.
+  ///
+  virtual void CollectTextures(
+      std::vector<std::shared_ptr<const Texture>>& textures) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The pass these contents draw by reference, if any. Passes
+  ///             with entities referencing other passes render those passes
+  ///             themselves instead of calling |Render|.
+  ///
+  virtual const EntityPass* GetReferencedPass() const;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Contents);
 };
@@ -51,6 +106,15 @@ class LinearGradientContents final : public Contents {
 
   const std::vector<Color>& GetColors() const;
 
+  // |Contents|
+  bool IsOpaque() const override;
+
+  // |Contents|
+  bool CanInheritOpacity() const override;
+
+  // |Contents|
+  std::size_t GetHash() const override;
+
  private:
   Point start_point_;
   Point end_point_;
@@ -76,6 +140,15 @@ class SolidColorContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool IsOpaque() const override;
+
+  // |Contents|
+  bool CanInheritOpacity() const override;
+
+  // |Contents|
+  std::size_t GetHash() const override;
+
  private:
   Color color_;
 
@@ -92,6 +165,12 @@ class TextureContents final : public Contents {
 
   std::shared_ptr<Texture> GetTexture() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set the future of a pending upload of the texture contents.
+  ///             Draws are skipped till the upload has completed.
+  ///
+  void SetTextureUpload(std::shared_future<bool> upload);
+
   void SetSourceRect(const IRect& source_rect);
 
   void SetOpacity(Scalar opacity);
@@ -103,8 +182,29 @@ class TextureContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool IsOpaque() const override;
+
+  // |Contents|
+  bool CanInheritOpacity() const override;
+
+  // |Contents|
+  std::size_t GetHash() const override;
+
+  // |Contents|
+  bool HasModifiedTextures() const override;
+
+  // |Contents|
+  void CollectTextures(
+      std::vector<std::shared_ptr<const Texture>>& textures) const override;
+
  public:
   std::shared_ptr<Texture> texture_;
+  // The contents generation of the texture when it was set. Part of the hash.
+  size_t texture_generation_ = 0u;
+  // The contents generation of the texture when it was last drawn.
+  mutable std::atomic_size_t drawn_generation_{0u};
+  std::shared_future<bool> texture_upload_;
   IRect source_rect_;
   Scalar opacity_ = 1.0f;
 
@@ -130,6 +230,12 @@ class SolidStrokeContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  std::size_t GetHash() const override;
+
  private:
   Color color_;
   Scalar stroke_size_ = 0.0;
@@ -148,8 +254,59 @@ class ClipContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  std::size_t GetHash() const override;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(ClipContents);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Draws a pass that may be shared by any number of entities,
+///             without copying it.
+///
+///             The entities and subpasses of the pass are rendered as if the
+///             transformation of the entity were applied to them, their
+///             stencil depths were offset by the stencil depth of the entity
+///             and they were restricted to its scissor. The pass must not be
+///             modified once it is referenced.
+///
+class EntityPassContents final : public Contents {
+ public:
+  explicit EntityPassContents(std::shared_ptr<const EntityPass> pass);
+
+  ~EntityPassContents() override;
+
+  const std::shared_ptr<const EntityPass>& GetPass() const;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  std::size_t GetHash() const override;
+
+  // |Contents|
+  bool HasModifiedTextures() const override;
+
+  // |Contents|
+  void CollectTextures(
+      std::vector<std::shared_ptr<const Texture>>& textures) const override;
+
+  // |Contents|
+  const EntityPass* GetReferencedPass() const override;
+
+ private:
+  const std::shared_ptr<const EntityPass> pass_;
+  // Computed on first use so that referencing a pass stays cheap.
+  mutable std::optional<std::optional<Rect>> coverage_;
+  mutable std::optional<std::size_t> hash_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EntityPassContents);
+};
+
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/entity.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "impeller/entity/content_context.h"
 #include "impeller/renderer/render_pass.h"
 
@@ -22,10 +23,15 @@ void Entity::SetTransformation(const Matrix& transformation) {
 }
 
 const Path& Entity::GetPath() const {
-  return path_;
+  static const Path kEmptyPath;
+  return path_ ? *path_ : kEmptyPath;
 }
 
 void Entity::SetPath(Path path) {
+  path_ = std::make_shared<const Path>(std::move(path));
+}
+
+void Entity::SetPath(std::shared_ptr<const Path> path) {
   path_ = std::move(path);
 }
 
@@ -42,7 +48,19 @@ std::optional<Rect> Entity::GetCoverage() const {
     return std::nullopt;
   }
 
-  return path_.GetBoundingBox();
+  if (contents_) {
+    return contents_->GetCoverage(*this);
+  }
+
+  return GetPath().GetBoundingBox();
+}
+
+std::optional<Rect> Entity::GetTransformedCoverage() const {
+  auto coverage = GetCoverage();
+  if (!coverage.has_value()) {
+    return std::nullopt;
+  }
+  return transformation_.TransformBounds(coverage.value());
 }
 
 void Entity::SetContents(std::shared_ptr<Contents> contents) {
@@ -65,7 +83,44 @@ void Entity::IncrementStencilDepth(uint32_t increment) {
   stencil_depth_ += increment;
 }
 
-bool Entity::Render(ContentContext& renderer, RenderPass& parent_pass) const {
+void Entity::SetScissor(std::optional<IRect> scissor) {
+  scissor_ = scissor;
+}
+
+const std::optional<IRect>& Entity::GetScissor() const {
+  return scissor_;
+}
+
+void Entity::SetOpacity(Scalar opacity) {
+  opacity_ = opacity;
+}
+
+Scalar Entity::GetOpacity() const {
+  return opacity_;
+}
+
+void Entity::SetBlendMode(BlendMode blend_mode) {
+  blend_mode_ = blend_mode;
+}
+
+Entity::BlendMode Entity::GetBlendMode() const {
+  return blend_mode_;
+}
+
+std::size_t Entity::GetHash() const {
+  auto seed = fml::HashCombine(transformation_.GetHash(), GetPath().GetHash(),
+                               stencil_depth_, opacity_, blend_mode_,
+                               adds_to_coverage_,
+                               contents_ ? contents_->GetHash() : 0u);
+  if (scissor_.has_value()) {
+    fml::HashCombineSeed(seed, scissor_->origin.x, scissor_->origin.y,
+                         scissor_->size.width, scissor_->size.height);
+  }
+  return seed;
+}
+
+bool Entity::Render(const ContentContext& renderer,
+                    RenderPass& parent_pass) const {
   if (!contents_) {
     return true;
   }
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "impeller/entity/contents.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/matrix.h"
@@ -18,6 +20,24 @@ class RenderPass;
 
 class Entity {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      How the color of the contents is combined with the color
+  ///             already in the render target. Contents output colors that
+  ///             are not premultiplied.
+  ///
+  enum class BlendMode {
+    /// The target is cleared to transparent black where the entity is drawn.
+    kClear,
+    /// The target is replaced by the source.
+    kSource,
+    /// The target is left untouched.
+    kDestination,
+    /// The source is composited over the target.
+    kSourceOver,
+    /// The source weighted by its alpha is added to the target.
+    kPlus,
+  };
+
   Entity();
 
   ~Entity();
@@ -30,12 +50,29 @@ class Entity {
 
   void SetPath(Path path);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set a path that may be shared with other entities.
+  ///
+  void SetPath(std::shared_ptr<const Path> path);
+
   void SetAddsToCoverage(bool adds);
 
   bool AddsToCoverage() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds of the area the contents of this entity may touch
+  ///             in the local coordinate space of the entity. Entities that
+  ///             don't add to coverage, like clips, have none.
+  ///
   std::optional<Rect> GetCoverage() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The coverage of the entity after its transformation has been
+  ///             applied. This is in the coordinate space of the render target
+  ///             the entity is rendered into.
+  ///
+  std::optional<Rect> GetTransformedCoverage() const;
+
   void SetContents(std::shared_ptr<Contents> contents);
 
   const std::shared_ptr<Contents>& GetContents() const;
@@ -46,13 +83,44 @@ class Entity {
 
   uint32_t GetStencilDepth() const;
 
-  bool Render(ContentContext& renderer, RenderPass& parent_pass) const;
+  //----------------------------------------------------------------------------
+  /// @brief      Restrict the entity to a region of the render target (in
+  ///             pixels). Unrestricted if absent.
+  ///
+  void SetScissor(std::optional<IRect> scissor);
+
+  const std::optional<IRect>& GetScissor() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Multiply the alpha of everything the entity draws. Only
+  ///             honored by contents that can inherit opacity.
+  ///
+  void SetOpacity(Scalar opacity);
+
+  Scalar GetOpacity() const;
+
+  void SetBlendMode(BlendMode blend_mode);
+
+  BlendMode GetBlendMode() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of everything that affects how the entity renders.
+  ///             Entities with equal hashes touch the same pixels of a render
+  ///             target with the same colors.
+  ///
+  std::size_t GetHash() const;
+
+  bool Render(const ContentContext& renderer, RenderPass& parent_pass) const;
 
  private:
   Matrix transformation_;
   std::shared_ptr<Contents> contents_;
-  Path path_;
+  // Paths are immutable once set. Sharing them keeps copies of entities cheap.
+  std::shared_ptr<const Path> path_;
   uint32_t stencil_depth_ = 0u;
+  std::optional<IRect> scissor_;
+  Scalar opacity_ = 1.0;
+  BlendMode blend_mode_ = BlendMode::kSourceOver;
   bool adds_to_coverage_ = true;
 };
 
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "impeller/entity/content_context.h"
+#include "impeller/entity/entity_pass.h"
+#include "impeller/entity/native_shaders_sw.h"
+#include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/backend/software/context_sw.h"
+#include "impeller/renderer/renderer.h"
+#include "impeller/renderer/surface.h"
+
+namespace impeller {
+
+static const ContentContext& GetBenchmarkContentContext() {
+  static const auto content_context = []() {
+    auto context = ContextSW::Create(GetEntityNativeShadersSW(), 0u);
+    FML_CHECK(context);
+    ContentContext::Options msaa_options;
+    msaa_options.sample_count = SampleCount::kCount4;
+    auto content_context =
+        std::make_unique<ContentContext>(context, std::vector{msaa_options});
+    FML_CHECK(content_context->IsValid());
+    FML_CHECK(content_context->GetPipelinesReady().get());
+    return content_context;
+  }();
+  return *content_context;
+}
+
+//------------------------------------------------------------------------------
+/// Looks up a pipeline variant that already exists from one or more threads.
+/// This is what every draw does while recording.
+///
+static void BM_ContentContextPipelineHit(benchmark::State& state) {
+  const auto& content_context = GetBenchmarkContentContext();
+  ContentContext::Options opts;
+  opts.sample_count = SampleCount::kCount4;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(content_context.GetSolidFillPipeline(opts));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ContentContextPipelineHit)->ThreadRange(1, 8)->UseRealTime();
+
+class BenchmarkSurface final : public Surface {
+ public:
+  BenchmarkSurface(RenderTarget target) : Surface(std::move(target)) {}
+
+  // |Surface|
+  bool Present() const override { return true; }
+};
+
+//------------------------------------------------------------------------------
+/// Renders a list of opaque cards with translucent labels over an opaque
+/// background, like a scrolled list. The cards overlap their predecessors.
+/// Reports the overdraw with and without the pixels hidden by the cards.
+///
+static void BM_EntityPassOverdraw(benchmark::State& state) {
+  auto context = ContextSW::Create(GetEntityNativeShadersSW(), 0u);
+  FML_CHECK(context);
+  ContentContext content_context(context);
+  FML_CHECK(content_context.IsValid());
+  Renderer renderer(context);
+  FML_CHECK(renderer.IsValid());
+  const ISize size(256, 256);
+  auto target = RenderTarget::CreateOffscreen(*context, size);
+
+  EntityPass pass;
+  auto add_rect = [&pass](Rect rect, Color color) {
+    Entity entity;
+    entity.SetPath(PathBuilder{}.AddRect(rect).TakePath());
+    entity.SetContents(SolidColorContents::Make(color));
+    pass.AddEntity(std::move(entity));
+  };
+  add_rect(Rect::MakeSize(Size(size)), Color::White());
+  const auto card_count = state.range(0);
+  const auto stride = static_cast<Scalar>(size.height) / card_count;
+  for (int64_t i = 0; i < card_count; i++) {
+    const auto top = i * stride;
+    add_rect(Rect::MakeXYWH(8, top, 240, stride * 2), Color::Blue());
+    add_rect(Rect::MakeXYWH(16, top + stride * 0.25f, 64, stride * 0.5f),
+             Color::Black().WithAlpha(0.5));
+  }
+
+  FrameStats stats;
+  for (auto _ : state) {
+    FML_CHECK(renderer.Render(std::make_unique<BenchmarkSurface>(target),
+                              [&](RenderPass& render_pass) {
+                                return pass.Render(content_context,
+                                                   render_pass);
+                              }));
+    stats = renderer.GetLastFrameStats();
+  }
+
+  const auto area = static_cast<double>(size.Area());
+  state.counters["overdraw_before"] =
+      (stats.pixels_drawn + stats.pixels_occluded) / area;
+  state.counters["overdraw_after"] = stats.pixels_drawn / area;
+  state.counters["entities_occluded"] = stats.entities_occluded;
+  state.counters["entities_trimmed"] = stats.entities_trimmed;
+}
+
+BENCHMARK(BM_EntityPassOverdraw)->Arg(4)->Arg(16)->Arg(64);
+
+}  // namespace impeller
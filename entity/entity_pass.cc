@@ -4,6 +4,10 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/entity/content_context.h"
 #include "impeller/geometry/path_builder.h"
@@ -98,12 +102,489 @@ EntityPass* EntityPass::AddSubpass(std::unique_ptr<EntityPass> pass) {
   return subpasses_.emplace_back(std::move(pass)).get();
 }
 
+//------------------------------------------------------------------------------
+/// @brief      Whether something with the given coverage in the coordinate
+///             space of the render target can be skipped. Things without a
+///             known coverage, like clips, are never skipped.
+///
+static bool IsOutsideBounds(const std::optional<Rect>& coverage,
+                            const Rect& bounds) {
+  return coverage.has_value() && !coverage->IntersectsWithRect(bounds);
+}
+
+static std::optional<IRect> ClipToTarget(const IRect& pixels,
+                                         const Entity& entity,
+                                         const IRect& target) {
+  auto clipped = pixels.Intersection(target);
+  if (clipped.has_value() && entity.GetScissor().has_value()) {
+    clipped = clipped->Intersection(entity.GetScissor().value());
+  }
+  return clipped;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The smallest pixel aligned rectangle that contains the rect.
+///
+static IRect RoundOut(const Rect& rect) {
+  const auto ltrb = rect.GetLTRB();
+  return IRect::MakeLTRB(std::floor(ltrb[0]), std::floor(ltrb[1]),
+                         std::ceil(ltrb[2]), std::ceil(ltrb[3]));
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The pixels of the render target that the entity may touch when
+///             rendered. Absent for entities without a known coverage, like
+///             clips, and for entities that touch no pixels.
+///
+static std::optional<IRect> GetPixelCoverage(const Entity& entity,
+                                             const IRect& target) {
+  const auto coverage = entity.GetTransformedCoverage();
+  if (!coverage.has_value()) {
+    return std::nullopt;
+  }
+  return ClipToTarget(RoundOut(coverage.value()), entity, target);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The pixels of the render target that the entity overwrites
+///             entirely with opaque colors. Absent if there are none that can
+///             be determined cheaply.
+///
+static std::optional<IRect> GetOpaquePixelCoverage(const Entity& entity,
+                                                   const IRect& target) {
+  // Entities with a stencil depth may be clipped by arbitrary paths.
+  if (entity.GetStencilDepth() != 0u) {
+    return std::nullopt;
+  }
+  const auto& contents = entity.GetContents();
+  if (!contents || !contents->IsOpaque() || entity.GetOpacity() < 1.0f) {
+    return std::nullopt;
+  }
+  const auto blend_mode = entity.GetBlendMode();
+  if (blend_mode != Entity::BlendMode::kSource &&
+      blend_mode != Entity::BlendMode::kSourceOver) {
+    return std::nullopt;
+  }
+  const auto& transformation = entity.GetTransformation();
+  if (!transformation.IsTranslationScaleOnly()) {
+    return std::nullopt;
+  }
+  const auto rect = entity.GetPath().GetRect();
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  const auto bounds = transformation.TransformBounds(rect.value());
+  if (!bounds.has_value()) {
+    return std::nullopt;
+  }
+  // Only pixels entirely within the bounds are guaranteed to be overwritten.
+  const auto ltrb = bounds->GetLTRB();
+  const auto pixels = IRect::MakeLTRB(std::ceil(ltrb[0]), std::ceil(ltrb[1]),
+                                      std::floor(ltrb[2]), std::floor(ltrb[3]));
+  return ClipToTarget(pixels, entity, target);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The part of an entity that remains visible once the entities
+///             drawn after it in the same pass are accounted for.
+///
+struct EntityVisibility {
+  /// Hidden entirely by the entities drawn after it.
+  bool occluded = false;
+  /// If only part of the entity is visible, the scissor that limits it to
+  /// that part.
+  std::optional<IRect> trimmed_scissor;
+  /// The number of pixels in the bounds of the entity that will be drawn.
+  size_t pixels_drawn = 0u;
+  /// The number of pixels in the bounds of the entity that are hidden.
+  size_t pixels_occluded = 0u;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The maximum number of opaque regions tracked while finding
+///             hidden entities. The largest regions are kept when there are
+///             more.
+///
+static constexpr size_t kMaxOccluders = 8u;
+
+static void AddOccluder(std::vector<IRect>& occluders, const IRect& occluder) {
+  for (const auto& existing : occluders) {
+    if (existing.Contains(occluder)) {
+      return;
+    }
+  }
+  occluders.erase(std::remove_if(occluders.begin(), occluders.end(),
+                                 [&occluder](const IRect& existing) {
+                                   return occluder.Contains(existing);
+                                 }),
+                  occluders.end());
+  if (occluders.size() < kMaxOccluders) {
+    occluders.push_back(occluder);
+    return;
+  }
+  auto smallest = std::min_element(
+      occluders.begin(), occluders.end(), [](const IRect& a, const IRect& b) {
+        return a.size.Area() < b.size.Area();
+      });
+  if (smallest->size.Area() < occluder.size.Area()) {
+    *smallest = occluder;
+  }
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Walk the entities back to front and find the parts of each that
+///             are hidden by opaque, axis aligned and unclipped entities drawn
+///             after it.
+///
+///             Each entity is passed through `resolve` along with a scratch
+///             entity first, so that a reference can be applied without
+///             copying all of them up front.
+///
+template <class Resolve>
+static std::vector<EntityVisibility> ComputeEntityVisibility(
+    const EntityPass::Entities& entities,
+    const IRect& target,
+    const Resolve& resolve) {
+  std::vector<EntityVisibility> visibility(entities.size());
+  std::vector<IRect> occluders;
+  Entity scratch;
+  for (size_t i = entities.size(); i > 0u; i--) {
+    const Entity& entity = resolve(entities[i - 1u], scratch);
+    auto& result = visibility[i - 1u];
+    const auto pixels = GetPixelCoverage(entity, target);
+    if (!pixels.has_value()) {
+      continue;
+    }
+    std::optional<IRect> visible = pixels;
+    for (const auto& occluder : occluders) {
+      visible = visible->Cutout(occluder);
+      if (!visible.has_value()) {
+        break;
+      }
+    }
+    const size_t area = pixels->size.Area();
+    if (!visible.has_value()) {
+      result.occluded = true;
+      result.pixels_occluded = area;
+      continue;
+    }
+    if (visible.value() != pixels.value()) {
+      result.trimmed_scissor = visible;
+    }
+    result.pixels_drawn = visible->size.Area();
+    result.pixels_occluded = area - result.pixels_drawn;
+    if (auto opaque = GetOpaquePixelCoverage(entity, target);
+        opaque.has_value()) {
+      AddOccluder(occluders, opaque.value());
+    }
+  }
+  return visibility;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Limit a scissor to a region of the render target. Absent if
+///             nothing remains.
+///
+static std::optional<IRect> IntersectScissor(
+    const std::optional<IRect>& scissor,
+    const IRect& region) {
+  if (!scissor.has_value()) {
+    return region;
+  }
+  return scissor->Intersection(region);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Fill a region of the render target with the clear color of its
+///             color attachment, replacing what was loaded there.
+///
+static bool ClearRegion(const ContentContext& renderer,
+                        RenderPass& pass,
+                        const IRect& region) {
+  const auto& attachments = pass.GetRenderTarget().GetColorAttachments();
+  const auto color0 = attachments.find(0u);
+  const auto clear_color = color0 != attachments.end()
+                               ? color0->second.clear_color
+                               : Color::BlackTransparent();
+  Entity entity;
+  entity.SetPath(PathBuilder{}.AddRect(Rect(region)).TakePath());
+  entity.SetContents(SolidColorContents::Make(clear_color));
+  entity.SetBlendMode(Entity::BlendMode::kSource);
+  entity.SetScissor(region);
+  return entity.Render(renderer, pass);
+}
+
+static bool SubmitOffscreenCommands(
+    const std::shared_ptr<CommandBuffer>& offscreen_command_buffer,
+    RenderPass& parent_pass) {
+  if (!offscreen_command_buffer) {
+    return true;
+  }
+
+  if (!offscreen_command_buffer->SubmitCommands()) {
+    return false;
+  }
+
+  parent_pass.GetStats().command_buffers_submitted++;
+  return true;
+}
+
 bool EntityPass::Render(ContentContext& renderer,
                         RenderPass& parent_pass) const {
+  return Render(renderer, parent_pass,
+                {IRect::MakeSize(parent_pass.GetRenderTargetSize())});
+}
+
+bool EntityPass::Render(ContentContext& renderer,
+                        RenderPass& parent_pass,
+                        const std::vector<IRect>& regions) const {
   TRACE_EVENT0("impeller", "EntityPass::Render");
 
+  // Subpass targets are only rendered once no matter how many regions they
+  // intersect.
+  OffscreenState offscreen;
+
+  const auto target = IRect::MakeSize(parent_pass.GetRenderTargetSize());
+  for (const auto& region : regions) {
+    const auto clipped_region = region.Intersection(target);
+    if (!clipped_region.has_value()) {
+      continue;
+    }
+    if (clipped_region.value() != target &&
+        !ClearRegion(renderer, parent_pass, clipped_region.value())) {
+      return false;
+    }
+    if (!RenderInternal(renderer, parent_pass, clipped_region.value(),
+                        offscreen, nullptr)) {
+      return false;
+    }
+  }
+
+  return SubmitOffscreenCommands(offscreen.command_buffer, parent_pass);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Map a scissor of a referenced pass into the render target of
+///             the pass referencing it. Under rotations and skews, the bounds
+///             of the transformed scissor are used.
+///
+static std::optional<IRect> TransformScissor(
+    const std::optional<IRect>& scissor,
+    const Matrix& xformation,
+    const std::optional<IRect>& reference_scissor) {
+  if (!scissor.has_value()) {
+    return reference_scissor;
+  }
+  auto bounds = xformation.TransformBounds(Rect(scissor.value()));
+  if (!bounds.has_value()) {
+    return reference_scissor;
+  }
+  auto transformed = RoundOut(bounds.value());
+  if (!reference_scissor.has_value()) {
+    return transformed;
+  }
+  return transformed.Intersection(reference_scissor.value())
+      .value_or(IRect::MakeSize({}));
+}
+
+const Entity& EntityPass::ApplyReference(const Entity& entity,
+                                         const Reference* reference,
+                                         Entity& referenced) {
+  if (!reference) {
+    return entity;
+  }
+  referenced = entity;
+  referenced.SetTransformation(reference->xformation *
+                               entity.GetTransformation());
+  referenced.IncrementStencilDepth(reference->stencil_offset);
+  referenced.SetScissor(TransformScissor(
+      entity.GetScissor(), reference->xformation, reference->scissor));
+  return referenced;
+}
+
+bool EntityPass::RenderReference(const ContentContext& renderer,
+                                 RenderPass& parent_pass,
+                                 const Matrix& xformation,
+                                 uint32_t stencil_offset,
+                                 const std::optional<IRect>& scissor) const {
+  TRACE_EVENT0("impeller", "EntityPass::RenderReference");
+
+  // References drawn by an entity pass join its offscreen work instead. The
+  // offscreen passes are submitted before the command buffer of the parent
+  // pass. So they still execute before being sampled.
+  const Reference reference{xformation, stencil_offset, scissor};
+  OffscreenState offscreen;
+  if (!RenderInternal(renderer, parent_pass,
+                      IRect::MakeSize(parent_pass.GetRenderTargetSize()),
+                      offscreen, &reference)) {
+    return false;
+  }
+  return SubmitOffscreenCommands(offscreen.command_buffer, parent_pass);
+}
+
+std::optional<Rect> EntityPass::GetCoverage() const {
+  std::optional<Rect> result;
+  auto add_coverage = [&result](const std::optional<Rect>& coverage) {
+    if (!coverage.has_value()) {
+      return;
+    }
+    result = result.has_value() ? result->Union(coverage.value()) : coverage;
+  };
   for (const auto& entity : entities_) {
-    if (!entity.Render(renderer, parent_pass)) {
+    add_coverage(entity.GetTransformedCoverage());
+  }
+  for (const auto& subpass : subpasses_) {
+    add_coverage(subpass->GetCoverage());
+  }
+  return result;
+}
+
+std::shared_ptr<Texture> EntityPass::RenderSubpassTarget(
+    const ContentContext& renderer,
+    RenderPass& parent_pass,
+    const EntityPass& subpass,
+    const ISize& subpass_size,
+    OffscreenState& offscreen) const {
+  // Subpasses are rendered in their own coordinate space. So the target only
+  // depends on the contents of the subpass and its size.
+  const auto cache_key = fml::HashCombine(
+      subpass.GetContentsHash(), subpass_size.width, subpass_size.height);
+  if (auto rendered = offscreen.targets.find(cache_key);
+      rendered != offscreen.targets.end()) {
+    return rendered->second;
+  }
+  // The hash only identifies textures. The cache checks they are still the
+  // same.
+  RasterCache::Textures textures;
+  subpass.CollectTextures(textures);
+  auto& raster_cache = renderer.GetRasterCache();
+  if (auto cached = raster_cache.Get(cache_key, textures)) {
+    parent_pass.GetStats().raster_cache_hits++;
+    offscreen.targets[cache_key] = cached;
+    return cached;
+  }
+  const auto should_cache =
+      raster_cache.ShouldCache(cache_key, subpass.GetEntityCount());
+
+  auto context = renderer.GetContext();
+
+  auto subpass_target =
+      RenderTarget::CreateOffscreen(renderer.GetTexturePool(), subpass_size);
+
+  auto subpass_texture = subpass_target.GetRenderTargetTexture();
+
+  if (!subpass_texture) {
+    return nullptr;
+  }
+
+  if (!offscreen.command_buffer) {
+    offscreen.command_buffer = context->CreateRenderCommandBuffer();
+    if (!offscreen.command_buffer) {
+      return nullptr;
+    }
+    offscreen.command_buffer->SetLabel("Offscreen Command Buffer");
+  }
+
+  auto sub_renderpass =
+      offscreen.command_buffer->CreateRenderPass(subpass_target);
+
+  if (!sub_renderpass) {
+    return nullptr;
+  }
+
+  sub_renderpass->SetLabel("OffscreenPass");
+  sub_renderpass->SetCapture(parent_pass.GetCapture());
+
+  // Nested subpasses are encoded into the same command buffer before this
+  // one. So the passes whose targets are sampled by this pass execute first.
+  if (!subpass.RenderInternal(
+          renderer, *sub_renderpass,
+          IRect::MakeSize(sub_renderpass->GetRenderTargetSize()), offscreen,
+          nullptr)) {
+    return nullptr;
+  }
+
+  if (!sub_renderpass->EncodeCommands(*context->GetTransientsAllocator())) {
+    return nullptr;
+  }
+
+  // Targets with skipped draws would keep their holes in later frames.
+  if (should_cache && sub_renderpass->GetStats().IsComplete() &&
+      raster_cache.Add(cache_key, subpass_texture, textures)) {
+    renderer.GetTexturePool().Release(subpass_texture);
+  }
+
+  {
+    auto& stats = parent_pass.GetStats();
+    stats += sub_renderpass->GetStats();
+    stats.offscreen_subpasses++;
+    stats.offscreen_pixel_area += subpass_target.GetRenderTargetSize().Area();
+  }
+
+  offscreen.targets[cache_key] = subpass_texture;
+  return subpass_texture;
+}
+
+bool EntityPass::RenderInternal(
+    const ContentContext& renderer,
+    RenderPass& parent_pass,
+    const IRect& region,
+    OffscreenState& offscreen,
+    const Reference* reference) const {
+  // Unless the whole render target is drawn, every draw has to be limited to
+  // the region.
+  const bool is_partial =
+      region != IRect::MakeSize(parent_pass.GetRenderTargetSize());
+  const auto region_bounds = Rect(region);
+
+  // Referenced, whatever is drawn into the render target of the parent pass
+  // is transformed. Offscreen subpasses are rendered as they are. The
+  // reference is applied to one entity at a time as it is needed.
+  auto resolve = [reference](const Entity& entity,
+                             Entity& referenced) -> const Entity& {
+    return ApplyReference(entity, reference, referenced);
+  };
+  const auto xformation =
+      reference ? reference->xformation * xformation_ : xformation_;
+  const auto stencil_depth =
+      stencil_depth_ + (reference ? reference->stencil_offset : 0u);
+
+  const auto visibility = ComputeEntityVisibility(entities_, region, resolve);
+
+  auto& stats = parent_pass.GetStats();
+  Entity referenced;
+  for (size_t i = 0; i < entities_.size(); i++) {
+    const auto& entity = resolve(entities_[i], referenced);
+    if (IsOutsideBounds(entity.GetTransformedCoverage(), region_bounds)) {
+      stats.entities_culled++;
+      continue;
+    }
+    const auto& entity_visibility = visibility[i];
+    stats.pixels_drawn += entity_visibility.pixels_drawn;
+    stats.pixels_occluded += entity_visibility.pixels_occluded;
+    if (entity_visibility.occluded) {
+      stats.entities_occluded++;
+      continue;
+    }
+    auto scissor = entity.GetScissor();
+    if (entity_visibility.trimmed_scissor.has_value()) {
+      stats.entities_trimmed++;
+      scissor = entity_visibility.trimmed_scissor;
+    } else if (is_partial) {
+      scissor = IntersectScissor(scissor, region);
+      if (!scissor.has_value()) {
+        continue;
+      }
+    }
+    if (scissor != entity.GetScissor()) {
+      auto scissored = entity;
+      scissored.SetScissor(scissor);
+      if (!RenderEntity(renderer, parent_pass, scissored, region, offscreen)) {
+        return false;
+      }
+      continue;
+    }
+    if (!RenderEntity(renderer, parent_pass, entity, region, offscreen)) {
       return false;
     }
   }
@@ -114,9 +595,23 @@ bool EntityPass::Render(ContentContext& renderer,
 
     if (delegate_->CanCollapseIntoParentPass()) {
       // Directly render into the parent pass and move on.
-      if (!subpass->Render(renderer, parent_pass)) {
+      if (!subpass->RenderInternal(renderer, parent_pass, region, offscreen,
+                                   reference)) {
+        return false;
+      }
+      continue;
+    }
+
+    if (auto opacity = delegate_->GetSubpassOpacity();
+        opacity.has_value() && subpass->CanInheritOpacity()) {
+      // Draw the entities into the parent pass with the opacity of the
+      // subpass instead of compositing an offscreen target.
+      if (!subpass->CloneWithOpacity(opacity.value())
+               ->RenderInternal(renderer, parent_pass, region, offscreen,
+                                reference)) {
         return false;
       }
+      parent_pass.GetStats().subpasses_folded++;
       continue;
     }
 
@@ -132,19 +627,34 @@ bool EntityPass::Render(ContentContext& renderer,
       continue;
     }
 
-    auto context = renderer.GetContext();
+    if (IsOutsideBounds(xformation.TransformBounds(subpass_coverage.value()),
+                        region_bounds)) {
+      parent_pass.GetStats().entities_culled++;
+      continue;
+    }
 
-    auto subpass_target = RenderTarget::CreateOffscreen(
-        *context, ISize::Ceil(subpass_coverage->size));
+    auto scissor = reference ? TransformScissor(subpass->scissor_,
+                                                reference->xformation,
+                                                reference->scissor)
+                             : subpass->scissor_;
+    if (is_partial) {
+      scissor = IntersectScissor(scissor, region);
+      if (!scissor.has_value()) {
+        continue;
+      }
+    }
 
-    auto subpass_texture = subpass_target.GetRenderTargetTexture();
+    const auto subpass_size = ISize::Ceil(subpass_coverage->size);
+    auto subpass_texture =
+        RenderSubpassTarget(renderer, parent_pass, *subpass, subpass_size,
+                            offscreen);
 
     if (!subpass_texture) {
       return false;
     }
 
-    auto offscreen_texture_contents =
-        delegate_->CreateContentsForSubpassTarget(subpass_texture);
+    auto offscreen_texture_contents = delegate_->CreateContentsForSubpassTarget(
+        subpass_texture, IRect::MakeSize(subpass_size));
 
     if (!offscreen_texture_contents) {
       // This is an error because the subpass delegate said the pass couldn't be
@@ -158,39 +668,12 @@ bool EntityPass::Render(ContentContext& renderer,
       return false;
     }
 
-    auto sub_command_buffer = context->CreateRenderCommandBuffer();
-
-    sub_command_buffer->SetLabel("Offscreen Command Buffer");
-
-    if (!sub_command_buffer) {
-      return false;
-    }
-
-    auto sub_renderpass = sub_command_buffer->CreateRenderPass(subpass_target);
-
-    if (!sub_renderpass) {
-      return false;
-    }
-
-    sub_renderpass->SetLabel("OffscreenPass");
-
-    if (!subpass->Render(renderer, *sub_renderpass)) {
-      return false;
-    }
-
-    if (!sub_renderpass->EncodeCommands(*context->GetTransientsAllocator())) {
-      return false;
-    }
-
-    if (!sub_command_buffer->SubmitCommands()) {
-      return false;
-    }
-
     Entity entity;
     entity.SetPath(PathBuilder{}.AddRect(subpass_coverage.value()).TakePath());
     entity.SetContents(std::move(offscreen_texture_contents));
-    entity.SetStencilDepth(stencil_depth_);
-    entity.SetTransformation(xformation_);
+    entity.SetStencilDepth(stencil_depth);
+    entity.SetScissor(scissor);
+    entity.SetTransformation(xformation);
     if (!entity.Render(renderer, parent_pass)) {
       return false;
     }
@@ -199,6 +682,22 @@ bool EntityPass::Render(ContentContext& renderer,
   return true;
 }
 
+bool EntityPass::RenderEntity(const ContentContext& renderer,
+                              RenderPass& parent_pass,
+                              const Entity& entity,
+                              const IRect& region,
+                              OffscreenState& offscreen) const {
+  if (const auto& contents = entity.GetContents()) {
+    if (auto referenced = contents->GetReferencedPass()) {
+      const Reference reference{entity.GetTransformation(),
+                                entity.GetStencilDepth(), entity.GetScissor()};
+      return referenced->RenderInternal(renderer, parent_pass, region,
+                                        offscreen, &reference);
+    }
+  }
+  return entity.Render(renderer, parent_pass);
+}
+
 void EntityPass::IterateAllEntities(std::function<bool(Entity&)> iterator) {
   if (!iterator) {
     return;
@@ -232,4 +731,325 @@ void EntityPass::SetStencilDepth(size_t stencil_depth) {
   stencil_depth_ = stencil_depth;
 }
 
+void EntityPass::SetScissor(std::optional<IRect> scissor) {
+  scissor_ = scissor;
+}
+
+std::size_t EntityPass::GetHash() const {
+  auto seed = GetContentsHash();
+  if (scissor_.has_value()) {
+    fml::HashCombineSeed(seed, scissor_->origin.x, scissor_->origin.y,
+                         scissor_->size.width, scissor_->size.height);
+  }
+  return seed;
+}
+
+std::size_t EntityPass::GetContentsHash() const {
+  // The transformation and stencil depth of this pass only apply to drawing
+  // its subpasses. So they still affect what ends up in its render target.
+  auto seed = fml::HashCombine(xformation_.GetHash(), stencil_depth_,
+                               delegate_->GetHash(), entities_.size(),
+                               subpasses_.size());
+  for (const auto& entity : entities_) {
+    fml::HashCombineSeed(seed, entity.GetHash());
+  }
+  for (const auto& subpass : subpasses_) {
+    fml::HashCombineSeed(seed, subpass->GetHash());
+  }
+  return seed;
+}
+
+static bool EntityHasModifiedTextures(const Entity& entity) {
+  const auto& contents = entity.GetContents();
+  return contents && contents->HasModifiedTextures();
+}
+
+bool EntityPass::HasModifiedTextures() const {
+  for (const auto& entity : entities_) {
+    if (EntityHasModifiedTextures(entity)) {
+      return true;
+    }
+  }
+  for (const auto& subpass : subpasses_) {
+    if (subpass->HasModifiedTextures()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void EntityPass::CollectTextures(
+    std::vector<std::shared_ptr<const Texture>>& textures) const {
+  for (const auto& entity : entities_) {
+    if (const auto& contents = entity.GetContents()) {
+      contents->CollectTextures(textures);
+    }
+  }
+  for (const auto& subpass : subpasses_) {
+    subpass->CollectTextures(textures);
+  }
+}
+
+// Finding overlaps is quadratic in the number of entities.
+static constexpr size_t kMaxOpacityInheritingEntities = 16u;
+
+bool EntityPass::CanInheritOpacity() const {
+  if (!subpasses_.empty() ||
+      entities_.size() > kMaxOpacityInheritingEntities) {
+    return false;
+  }
+  std::vector<Rect> coverages;
+  coverages.reserve(entities_.size());
+  for (const auto& entity : entities_) {
+    const auto& contents = entity.GetContents();
+    if (!contents || !contents->CanInheritOpacity()) {
+      return false;
+    }
+    // The stencil depths of a subpass start over at zero. Folded into the
+    // parent pass, its clips would modify the clips of the parent.
+    if (!entity.AddsToCoverage()) {
+      return false;
+    }
+    if (entity.GetBlendMode() != Entity::BlendMode::kSourceOver) {
+      return false;
+    }
+    const auto coverage = entity.GetTransformedCoverage();
+    if (!coverage.has_value()) {
+      continue;
+    }
+    for (const auto& other : coverages) {
+      if (other.IntersectsWithRect(coverage.value())) {
+        return false;
+      }
+    }
+    coverages.push_back(coverage.value());
+  }
+  return true;
+}
+
+std::unique_ptr<EntityPass> EntityPass::CloneWithOpacity(
+    Scalar opacity) const {
+  auto pass = std::make_unique<EntityPass>();
+  pass->entities_.reserve(entities_.size());
+  for (const auto& entity : entities_) {
+    auto& translucent = pass->entities_.emplace_back(entity);
+    translucent.SetOpacity(entity.GetOpacity() * opacity);
+    // The stencil depths of this pass start over at zero. Drawn into the
+    // parent pass, the entities are clipped by the clips the composite would
+    // have been clipped by.
+    translucent.IncrementStencilDepth(stencil_depth_);
+    // The scissor of this pass would otherwise only apply to its composite.
+    if (scissor_.has_value()) {
+      translucent.SetScissor(
+          IntersectScissor(entity.GetScissor(), scissor_.value())
+              .value_or(IRect::MakeSize({})));
+    }
+  }
+  pass->xformation_ = xformation_;
+  pass->stencil_depth_ = stencil_depth_;
+  pass->scissor_ = scissor_;
+  pass->delegate_ = delegate_;
+  return pass;
+}
+
+size_t EntityPass::GetEntityCount() const {
+  auto count = entities_.size();
+  for (const auto& subpass : subpasses_) {
+    count += subpass->GetEntityCount();
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Add the pixels touched by an entity that changed between two
+///             passes to the damage.
+///
+/// @return     False if the damage can't be bounded.
+///
+static bool AddEntityDamage(const Entity& entity,
+                            const IRect& target,
+                            std::vector<IRect>& damage) {
+  // Clips change what the entities drawn after them touch.
+  if (!entity.AddsToCoverage()) {
+    return false;
+  }
+  if (auto pixels = GetPixelCoverage(entity, target); pixels.has_value()) {
+    damage.push_back(pixels.value());
+  }
+  return true;
+}
+
+static std::vector<std::size_t> GetEntityHashes(
+    const EntityPass::Entities& entities) {
+  std::vector<std::size_t> hashes;
+  hashes.reserve(entities.size());
+  for (const auto& entity : entities) {
+    hashes.push_back(entity.GetHash());
+  }
+  return hashes;
+}
+
+bool EntityPass::AddDamage(const EntityPass& previous,
+                           const IRect& target,
+                           std::vector<IRect>& damage) const {
+  // Entities that were added, removed, or changed are somewhere between the
+  // unchanged entities at the start and at the end of the passes.
+  const auto hashes = GetEntityHashes(entities_);
+  const auto previous_hashes = GetEntityHashes(previous.entities_);
+  const auto common = std::min(hashes.size(), previous_hashes.size());
+  size_t prefix = 0u;
+  while (prefix < common && hashes[prefix] == previous_hashes[prefix]) {
+    prefix++;
+  }
+  size_t suffix = 0u;
+  while (prefix + suffix < common &&
+         hashes[hashes.size() - suffix - 1u] ==
+             previous_hashes[previous_hashes.size() - suffix - 1u]) {
+    suffix++;
+  }
+  for (size_t i = prefix; i + suffix < entities_.size(); i++) {
+    if (!AddEntityDamage(entities_[i], target, damage)) {
+      return false;
+    }
+  }
+  for (size_t i = prefix; i + suffix < previous.entities_.size(); i++) {
+    if (!AddEntityDamage(previous.entities_[i], target, damage)) {
+      return false;
+    }
+  }
+  // Unchanged entities still draw differently if their textures were modified
+  // in place.
+  for (size_t i = 0u; i < entities_.size(); i++) {
+    if ((i < prefix || i + suffix >= entities_.size()) &&
+        EntityHasModifiedTextures(entities_[i]) &&
+        !AddEntityDamage(entities_[i], target, damage)) {
+      return false;
+    }
+  }
+
+  // How subpasses are drawn into this pass depends on the delegate, the
+  // transformation, and the stencil depth of this pass.
+  const bool same_composition =
+      delegate_->GetHash() == previous.delegate_->GetHash() &&
+      xformation_ == previous.xformation_ &&
+      stencil_depth_ == previous.stencil_depth_;
+  const auto count = std::max(subpasses_.size(), previous.subpasses_.size());
+  for (size_t i = 0; i < count; i++) {
+    const auto subpass =
+        i < subpasses_.size() ? subpasses_[i].get() : nullptr;
+    const auto previous_subpass =
+        i < previous.subpasses_.size() ? previous.subpasses_[i].get() : nullptr;
+    if (subpass && previous_subpass && same_composition) {
+      if (delegate_->CanElide() ||
+          (subpass->GetHash() == previous_subpass->GetHash() &&
+           !subpass->HasModifiedTextures())) {
+        continue;
+      }
+      // The entities of collapsed subpasses are drawn straight into the
+      // render target. Only the ones that changed are damaged.
+      if (delegate_->CanCollapseIntoParentPass()) {
+        if (!subpass->AddDamage(*previous_subpass, target, damage)) {
+          return false;
+        }
+        continue;
+      }
+    }
+    if (previous_subpass) {
+      previous.AddSubpassCoverage(*previous_subpass, target, damage);
+    }
+    if (subpass) {
+      AddSubpassCoverage(*subpass, target, damage);
+    }
+  }
+  return true;
+}
+
+void EntityPass::AddSubpassCoverage(const EntityPass& subpass,
+                                    const IRect& target,
+                                    std::vector<IRect>& damage) const {
+  if (delegate_->CanElide()) {
+    return;
+  }
+
+  if (delegate_->CanCollapseIntoParentPass()) {
+    // Clips in the subpass only affect the entities drawn after them in the
+    // subpass, which are damaged already.
+    for (const auto& entity : subpass.entities_) {
+      if (auto pixels = GetPixelCoverage(entity, target); pixels.has_value()) {
+        damage.push_back(pixels.value());
+      }
+    }
+    for (const auto& nested : subpass.subpasses_) {
+      subpass.AddSubpassCoverage(*nested, target, damage);
+    }
+    return;
+  }
+
+  const auto coverage = GetSubpassCoverage(subpass);
+  if (!coverage.has_value()) {
+    return;
+  }
+  const auto bounds = xformation_.TransformBounds(coverage.value());
+  if (!bounds.has_value()) {
+    damage.push_back(target);
+    return;
+  }
+  auto pixels = RoundOut(bounds.value()).Intersection(target);
+  if (pixels.has_value() && subpass.scissor_.has_value()) {
+    pixels = pixels->Intersection(subpass.scissor_.value());
+  }
+  if (pixels.has_value()) {
+    damage.push_back(pixels.value());
+  }
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The maximum number of regions damage is tracked in. Past that,
+///             the regions are replaced by their bounds.
+///
+static constexpr size_t kMaxDamageRegions = 8u;
+
+//------------------------------------------------------------------------------
+/// @brief      Merge overlapping regions of damage. Overlapping regions would
+///             be repainted more than once, blending some entities twice.
+///
+static std::vector<IRect> MergeDamage(const std::vector<IRect>& damage) {
+  std::vector<IRect> merged;
+  for (auto region : damage) {
+    for (size_t i = 0; i < merged.size();) {
+      if (!merged[i].IntersectsWithRect(region)) {
+        i++;
+        continue;
+      }
+      // The grown region may now overlap regions it was already checked
+      // against.
+      region = region.Union(merged[i]);
+      merged.erase(merged.begin() + i);
+      i = 0;
+    }
+    merged.push_back(region);
+  }
+  if (merged.size() <= kMaxDamageRegions) {
+    return merged;
+  }
+  auto bounds = merged.front();
+  for (const auto& region : merged) {
+    bounds = bounds.Union(region);
+  }
+  return {bounds};
+}
+
+std::vector<IRect> EntityPass::ComputeDamage(const EntityPass& previous,
+                                             const ISize& size) const {
+  if (size.IsEmpty()) {
+    return {};
+  }
+  const auto target = IRect::MakeSize(size);
+  std::vector<IRect> damage;
+  if (!AddDamage(previous, target, damage)) {
+    return {target};
+  }
+  return MergeDamage(damage);
+}
+
 }  // namespace impeller
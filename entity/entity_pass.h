@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -16,6 +17,7 @@
 
 namespace impeller {
 
+class CommandBuffer;
 class ContentContext;
 
 class EntityPass {
@@ -45,27 +47,221 @@ class EntityPass {
 
   EntityPass* GetSuperpass() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Render the entities and subpasses of this pass into the parent
+  ///             pass.
+  ///
+  ///             The offscreen passes of all subpasses, at any depth, are
+  ///             encoded into a single command buffer that is submitted once
+  ///             before this call returns. Since a subpass is always encoded
+  ///             before the pass that samples its render target, the command
+  ///             buffer executes the passes in dependency order.
+  ///
   bool Render(ContentContext& renderer, RenderPass& parent_pass) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Render only the parts of this pass that fall within regions of
+  ///             the render target of the parent pass. The regions are cleared
+  ///             to the clear color of the color attachment first. Outside of
+  ///             them, the render target keeps whatever the parent pass loaded
+  ///             into it.
+  ///
+  /// @param[in]  regions  Disjoint regions of the render target in pixels.
+  ///
+  bool Render(ContentContext& renderer,
+              RenderPass& parent_pass,
+              const std::vector<IRect>& regions) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render this pass as part of another pass that references it.
+  ///             The pass itself is left untouched so that it may be
+  ///             referenced any number of times.
+  ///
+  ///             Offscreen subpasses are rendered as they are. Only what is
+  ///             drawn into the render target of the parent pass is
+  ///             transformed.
+  ///
+  /// @param[in]  xformation      Applied to the entities of this pass and the
+  ///                             composites of its subpasses before their own
+  ///                             transformations.
+  /// @param[in]  stencil_offset  Added to the stencil depths of what is drawn
+  ///                             into the render target of the parent pass.
+  /// @param[in]  scissor         The region of the render target of the parent
+  ///                             pass that rendering is restricted to.
+  ///
+  bool RenderReference(const ContentContext& renderer,
+                       RenderPass& parent_pass,
+                       const Matrix& xformation,
+                       uint32_t stencil_offset,
+                       const std::optional<IRect>& scissor) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds of the area the entities of this pass and its
+  ///             subpasses may touch, in the coordinate space of the render
+  ///             target of this pass.
+  ///
+  std::optional<Rect> GetCoverage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of everything that affects how this pass and its
+  ///             subpasses render.
+  ///
+  std::size_t GetHash() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of everything that affects what this pass renders into
+  ///             a render target of its own. Unlike `GetHash`, this leaves out
+  ///             how the pass is drawn into its parent.
+  ///
+  std::size_t GetContentsHash() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether textures drawn by this pass or its subpasses were
+  ///             modified in place since they were last drawn.
+  ///
+  bool HasModifiedTextures() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Append the textures drawn by this pass and its subpasses.
+  ///
+  void CollectTextures(
+      std::vector<std::shared_ptr<const Texture>>& textures) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the regions of a render target that differ between
+  ///             rendering the previous pass into it and rendering this one.
+  ///
+  ///             Entities are matched by their hashes. Past the unchanged
+  ///             entities at the start and end of both passes, the bounds of
+  ///             the entities of either pass are damaged. Subpasses are
+  ///             compared in order. A changed clip damages the whole render
+  ///             target.
+  ///
+  /// @return     Disjoint regions of the render target in pixels. Empty if
+  ///             both passes render the same.
+  ///
+  std::vector<IRect> ComputeDamage(const EntityPass& previous,
+                                   const ISize& size) const;
+
   void IterateAllEntities(std::function<bool(Entity&)> iterator);
 
   void SetTransformation(Matrix xformation);
 
   void SetStencilDepth(size_t stencil_depth);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The scissor applied when the contents of this pass are
+  ///             rendered into its parent. This is in the coordinate space of
+  ///             the parent render target.
+  ///
+  void SetScissor(std::optional<IRect> scissor);
+
  private:
   Entities entities_;
   Subpasses subpasses_;
   EntityPass* superpass_ = nullptr;
   Matrix xformation_;
   size_t stencil_depth_ = 0u;
-  std::unique_ptr<EntityPassDelegate> delegate_ =
+  std::optional<IRect> scissor_;
+  // Shared by the copies of this pass made to fold subpasses.
+  std::shared_ptr<EntityPassDelegate> delegate_ =
       EntityPassDelegate::MakeDefault();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The offscreen work of rendering a pass into a frame. Subpass
+  ///             targets are rendered once and shared by all the regions of
+  ///             the frame that composite them.
+  ///
+  struct OffscreenState {
+    // Created lazily by the first subpass that needs an offscreen target.
+    std::shared_ptr<CommandBuffer> command_buffer;
+    // Keyed by the contents hash and the size of the subpasses.
+    std::unordered_map<size_t, std::shared_ptr<Texture>> targets;
+  };
+
   std::optional<Rect> GetSubpassCoverage(const EntityPass& subpass) const;
 
   std::optional<Rect> GetEntitiesCoverage() const;
 
+  size_t GetEntityCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether drawing the entities of this pass with an opacity
+  ///             looks the same as compositing its render target with that
+  ///             opacity. That is the case if no entities overlap and all of
+  ///             them can inherit opacity.
+  ///
+  bool CanInheritOpacity() const;
+
+  std::unique_ptr<EntityPass> CloneWithOpacity(Scalar opacity) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      How a referenced pass is drawn into the render target of the
+  ///             pass referencing it.
+  ///
+  struct Reference {
+    Matrix xformation;
+    uint32_t stencil_offset = 0u;
+    std::optional<IRect> scissor;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get an entity the way it is drawn into the render target of
+  ///             the parent pass.
+  ///
+  /// @param[in]  entity      An entity of this pass.
+  /// @param[in]  reference   How this pass is referenced, or null.
+  /// @param[out] referenced  Scratch space for the entity with the reference
+  ///                         applied. It shares its path and contents with
+  ///                         the entity.
+  ///
+  /// @return     The entity itself if there is no reference. Otherwise,
+  ///             `referenced`.
+  ///
+  static const Entity& ApplyReference(const Entity& entity,
+                                      const Reference* reference,
+                                      Entity& referenced);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  reference  How this pass is referenced, or null if it is
+  ///                        drawn as it is.
+  ///
+  bool RenderInternal(const ContentContext& renderer,
+                      RenderPass& parent_pass,
+                      const IRect& region,
+                      OffscreenState& offscreen,
+                      const Reference* reference) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render an entity of this pass. Entities that reference other
+  ///             passes render them as part of this one so that their
+  ///             offscreen work is submitted along with that of this pass.
+  ///
+  bool RenderEntity(const ContentContext& renderer,
+                    RenderPass& parent_pass,
+                    const Entity& entity,
+                    const IRect& region,
+                    OffscreenState& offscreen) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a texture with the contents of a subpass, either from the
+  ///             targets already rendered for this frame, from the raster
+  ///             cache, or by rendering the subpass offscreen.
+  ///
+  std::shared_ptr<Texture> RenderSubpassTarget(const ContentContext& renderer,
+                                               RenderPass& parent_pass,
+                                               const EntityPass& subpass,
+                                               const ISize& subpass_size,
+                                               OffscreenState& offscreen) const;
+
+  bool AddDamage(const EntityPass& previous,
+                 const IRect& target,
+                 std::vector<IRect>& damage) const;
+
+  void AddSubpassCoverage(const EntityPass& subpass,
+                          const IRect& target,
+                          std::vector<IRect>& damage) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EntityPass);
 };
 
@@ -73,6 +269,12 @@ struct CanvasStackEntry {
   Matrix xformation;
   size_t stencil_depth = 0u;
   bool is_subpass = false;
+  /// The bounds of the clips applied to this entry in the coordinate space of
+  /// the current pass. Unbounded if absent.
+  std::optional<Rect> clip_bounds;
+  /// The intersection of the axis aligned rectangular clips applied to this
+  /// entry in pixels. These clips don't touch the stencil. Unbounded if absent.
+  std::optional<IRect> scissor;
 };
 
 }  // namespace impeller
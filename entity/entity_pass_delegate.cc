@@ -4,12 +4,22 @@
 
 #include "impeller/entity/entity_pass_delegate.h"
 
+#include "flutter/fml/hash_combine.h"
+
 namespace impeller {
 
 EntityPassDelegate::EntityPassDelegate() = default;
 
 EntityPassDelegate::~EntityPassDelegate() = default;
 
+std::optional<Scalar> EntityPassDelegate::GetSubpassOpacity() {
+  return std::nullopt;
+}
+
+std::size_t EntityPassDelegate::GetHash() const {
+  return std::hash<const EntityPassDelegate*>{}(this);
+}
+
 class DefaultEntityPassDelegate final : public EntityPassDelegate {
  public:
   DefaultEntityPassDelegate() = default;
@@ -28,11 +38,18 @@ class DefaultEntityPassDelegate final : public EntityPassDelegate {
 
   // |EntityPassDelegate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
-      std::shared_ptr<Texture> target) override {
+      std::shared_ptr<Texture> target,
+      IRect source_rect) override {
     // Not possible since this pass always collapses into its parent.
     FML_UNREACHABLE();
   }
 
+  // |EntityPassDelegate|
+  std::size_t GetHash() const override {
+    // All default delegates behave the same.
+    return fml::HashCombine();
+  }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(DefaultEntityPassDelegate);
 };
@@ -26,8 +26,37 @@ class EntityPassDelegate {
 
   virtual bool CanCollapseIntoParentPass() = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create the contents that draw the render target of a subpass
+  ///             into the parent pass.
+  ///
+  /// @param[in]  target       The color texture of the subpass.
+  /// @param[in]  source_rect  The region of the texture the subpass rendered
+  ///                          into. Render targets are recycled and may be
+  ///                          larger than the subpass.
+  ///
   virtual std::shared_ptr<Contents> CreateContentsForSubpassTarget(
-      std::shared_ptr<Texture> target) = 0;
+      std::shared_ptr<Texture> target,
+      IRect source_rect) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The opacity the contents created for subpass targets are
+  ///             drawn with, if that is all they do. Subpasses whose entities
+  ///             don't overlap may then be drawn directly into the parent pass
+  ///             with the opacity applied to each entity.
+  ///
+  /// @return     The opacity or std::nullopt if the contents do more than
+  ///             apply an opacity. Unless overridden, subpasses are never
+  ///             drawn directly.
+  ///
+  virtual std::optional<Scalar> GetSubpassOpacity();
+
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of everything that affects how the delegate draws
+  ///             subpasses. Unless overridden, delegates only hash equal to
+  ///             themselves.
+  ///
+  virtual std::size_t GetHash() const;
 
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(EntityPassDelegate);
@@ -17,12 +17,19 @@ bool EntityPlayground::OpenPlaygroundHere(Entity entity) {
     return true;
   }
 
-  ContentContext context_context(GetContext());
+  // Playground surfaces are multisampled.
+  ContentContext::Options msaa_options;
+  msaa_options.sample_count = SampleCount::kCount4;
+  ContentContext context_context(GetContext(), {msaa_options});
   if (!context_context.IsValid()) {
     return false;
   }
   Renderer::RenderCallback callback = [&](RenderPass& pass) -> bool {
-    return entity.Render(context_context, pass);
+    if (!entity.Render(context_context, pass)) {
+      return false;
+    }
+    context_context.EndFrame();
+    return true;
   };
   return Playground::OpenPlaygroundHere(callback);
 }
@@ -2,11 +2,20 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <thread>
+
 #include "flutter/testing/testing.h"
+#include "impeller/entity/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/entity_pass.h"
 #include "impeller/entity/entity_playground.h"
+#include "impeller/entity/native_shaders_sw.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/playground/playground.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/backend/software/context_sw.h"
+#include "impeller/renderer/renderer.h"
+#include "impeller/renderer/surface.h"
 
 namespace impeller {
 namespace testing {
@@ -25,5 +34,448 @@ TEST_F(EntityTest, CanDrawRect) {
   ASSERT_TRUE(OpenPlaygroundHere(entity));
 }
 
+class OffscreenPassDelegate final : public EntityPassDelegate {
+ public:
+  OffscreenPassDelegate() = default;
+
+  // |EntityPassDelegate|
+  ~OffscreenPassDelegate() override = default;
+
+  // |EntityPassDelegate|
+  std::optional<Rect> GetCoverageRect() override { return std::nullopt; }
+
+  // |EntityPassDelegate|
+  bool CanElide() override { return false; }
+
+  // |EntityPassDelegate|
+  bool CanCollapseIntoParentPass() override { return false; }
+
+  // |EntityPassDelegate|
+  std::shared_ptr<Contents> CreateContentsForSubpassTarget(
+      std::shared_ptr<Texture> target,
+      IRect source_rect) override {
+    auto contents = std::make_shared<TextureContents>();
+    contents->SetTexture(target);
+    contents->SetSourceRect(source_rect);
+    return contents;
+  }
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(OffscreenPassDelegate);
+};
+
+class OnscreenSurface final : public Surface {
+ public:
+  OnscreenSurface(RenderTarget target) : Surface(std::move(target)) {}
+
+  // |Surface|
+  bool Present() const override { return true; }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Renders entity passes with the software backend into a small
+///             offscreen target so that tests can check the frame stats
+///             without a playground window.
+///
+class EntitySWTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    context_ = ContextSW::Create(GetEntityNativeShadersSW(), 0u);
+    ASSERT_TRUE(context_ && context_->IsValid());
+    content_context_ = std::make_unique<ContentContext>(context_);
+    ASSERT_TRUE(content_context_->IsValid());
+    renderer_ = std::make_unique<Renderer>(context_);
+    ASSERT_TRUE(renderer_->IsValid());
+    target_ = RenderTarget::CreateOffscreen(*context_, {16, 16});
+    ASSERT_TRUE(target_.IsValid());
+  }
+
+  const std::shared_ptr<Context>& GetContext() const { return context_; }
+
+  ContentContext& GetContentContext() const { return *content_context_; }
+
+  FrameStats GetLastFrameStats() const {
+    return renderer_->GetLastFrameStats();
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render the pass into the offscreen target. This doesn't end
+  ///             the frame of the content context.
+  ///
+  bool Render(const EntityPass& pass) {
+    return renderer_->Render(std::make_unique<OnscreenSurface>(target_),
+                             [&](RenderPass& render_pass) {
+                               return pass.Render(*content_context_,
+                                                  render_pass);
+                             });
+  }
+
+  bool Render(const EntityPass& pass, const std::vector<IRect>& regions) {
+    return renderer_->Render(
+        std::make_unique<OnscreenSurface>(target_),
+        [&](RenderPass& render_pass) {
+          return pass.Render(*content_context_, render_pass, regions);
+        });
+  }
+
+  static Entity MakeRect(Rect rect, Color color) {
+    Entity entity;
+    entity.SetPath(PathBuilder{}.AddRect(rect).TakePath());
+    entity.SetContents(SolidColorContents::Make(color));
+    return entity;
+  }
+
+ private:
+  std::shared_ptr<Context> context_;
+  std::unique_ptr<ContentContext> content_context_;
+  std::unique_ptr<Renderer> renderer_;
+  RenderTarget target_;
+};
+
+using EntityPassTest = EntitySWTest;
+using PipelineBuilderTest = EntitySWTest;
+using ContentContextTest = EntitySWTest;
+
+TEST_F(EntityPassTest, NestedSubpassesAreSubmittedOnce) {
+  // Each pass draws a rect and owns the next one, three subpasses deep.
+  EntityPass root;
+  EntityPass* pass = &root;
+  for (size_t i = 0; i < 4u; i++) {
+    pass->AddEntity(MakeRect({0, 0, 8, 8}, Color::Red()));
+    pass->SetDelegate(std::make_unique<OffscreenPassDelegate>());
+    if (i < 3u) {
+      pass = pass->AddSubpass(std::make_unique<EntityPass>());
+    }
+  }
+
+  ASSERT_TRUE(Render(root));
+
+  const auto stats = GetLastFrameStats();
+  ASSERT_EQ(stats.offscreen_subpasses, 3u);
+  // One for all the offscreen passes and one for the onscreen pass.
+  ASSERT_EQ(stats.command_buffers_submitted, 2u);
+}
+
+TEST_F(EntityPassTest, SubpassesAreRenderedOncePerFrame) {
+  EntityPass root;
+  root.SetDelegate(std::make_unique<OffscreenPassDelegate>());
+  auto subpass = root.AddSubpass(std::make_unique<EntityPass>());
+  subpass->AddEntity(MakeRect({0, 0, 16, 16}, Color::Red()));
+
+  // Both regions composite the same subpass target.
+  ASSERT_TRUE(Render(
+      root, {IRect::MakeXYWH(0, 0, 8, 8), IRect::MakeXYWH(8, 8, 8, 8)}));
+
+  const auto stats = GetLastFrameStats();
+  ASSERT_EQ(stats.offscreen_subpasses, 1u);
+}
+
+TEST_F(EntityPassTest, OffscreenTargetsAreRecycledAcrossFrames) {
+  for (size_t frame = 0; frame < 3u; frame++) {
+    // The coverage of the subpass changes slightly every frame.
+    EntityPass root;
+    root.SetDelegate(std::make_unique<OffscreenPassDelegate>());
+    auto subpass = root.AddSubpass(std::make_unique<EntityPass>());
+    subpass->AddEntity(MakeRect({0, 0, 8.0f + frame, 8}, Color::Red()));
+
+    ASSERT_TRUE(Render(root));
+    GetContentContext().EndFrame();
+    const auto stats = GetLastFrameStats();
+    ASSERT_EQ(stats.offscreen_subpasses, 1u);
+    // The color and stencil attachments are only created for the first frame.
+    ASSERT_EQ(stats.textures_created, frame == 0u ? 2u : 0u);
+  }
+
+  const auto& pool = GetContentContext().GetTexturePool();
+  ASSERT_EQ(pool.GetTexturesCreated(), 2u);
+  ASSERT_EQ(pool.GetTexturesReused(), 4u);
+  ASSERT_EQ(pool.GetTexturesEvicted(), 0u);
+}
+
+TEST_F(EntityPassTest, PooledTexturesOnlyAgeAtTheEndOfAFrame) {
+  EntityPass root;
+  root.SetDelegate(std::make_unique<OffscreenPassDelegate>());
+  auto subpass = root.AddSubpass(std::make_unique<EntityPass>());
+  subpass->AddEntity(MakeRect({0, 0, 8, 8}, Color::Red()));
+
+  // Rendering many passes in a single frame doesn't age the pool.
+  for (size_t i = 0; i <= TexturePool::kMaxUnusedFrames; i++) {
+    ASSERT_TRUE(Render(root));
+  }
+  const auto& pool = GetContentContext().GetTexturePool();
+  ASSERT_EQ(pool.GetTexturesCreated(), 2u);
+  ASSERT_EQ(pool.GetTexturesEvicted(), 0u);
+
+  for (size_t frame = 0; frame <= TexturePool::kMaxUnusedFrames; frame++) {
+    GetContentContext().EndFrame();
+  }
+  ASSERT_EQ(pool.GetTexturesEvicted(), 2u);
+}
+
+TEST_F(EntityPassTest, StableSubpassesAreRasterCached) {
+  const auto& pool = GetContentContext().GetTexturePool();
+  size_t uncached_pooled_bytes = 0u;
+  for (size_t frame = 0; frame < 3u; frame++) {
+    // Only the transformation of the subpass changes from frame to frame.
+    EntityPass root;
+    root.SetDelegate(std::make_unique<OffscreenPassDelegate>());
+    root.SetTransformation(Matrix::MakeTranslation({1.0f * frame, 0, 0}));
+    auto subpass = root.AddSubpass(std::make_unique<EntityPass>());
+    for (size_t i = 0; i < 2u; i++) {
+      subpass->AddEntity(MakeRect({0, 4.0f * i, 8, 4}, Color::Red()));
+    }
+
+    ASSERT_TRUE(Render(root));
+    GetContentContext().EndFrame();
+    const auto stats = GetLastFrameStats();
+    // The subpass is cached once it has been rendered in two frames.
+    ASSERT_EQ(stats.offscreen_subpasses, frame < 2u ? 1u : 0u);
+    ASSERT_EQ(stats.raster_cache_hits, frame < 2u ? 0u : 1u);
+    if (frame == 0u) {
+      uncached_pooled_bytes = pool.GetPooledBytes();
+    }
+  }
+
+  const auto& cache = GetContentContext().GetRasterCache();
+  ASSERT_EQ(cache.GetHits(), 1u);
+  ASSERT_EQ(cache.GetMisses(), 2u);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_GT(cache.GetCachedBytes(), 0u);
+  // The cached target only counts against the budget of the cache.
+  ASSERT_EQ(pool.GetPooledBytes() + cache.GetCachedBytes(),
+            uncached_pooled_bytes);
+}
+
+TEST_F(EntityPassTest, RasterCacheMissesTexturesModifiedInPlace) {
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {8, 8};
+  auto texture = GetContext()->GetPermanentsAllocator()->CreateTexture(
+      StorageMode::kHostVisible, desc);
+  ASSERT_TRUE(texture);
+
+  EntityPass root;
+  root.SetDelegate(std::make_unique<OffscreenPassDelegate>());
+  auto subpass = root.AddSubpass(std::make_unique<EntityPass>());
+  for (size_t i = 0; i < 2u; i++) {
+    auto contents = std::make_shared<TextureContents>();
+    contents->SetTexture(texture);
+    contents->SetSourceRect(IRect::MakeSize(desc.size));
+    Entity entity;
+    entity.SetPath(PathBuilder{}.AddRect({0, 4.0f * i, 8, 4}).TakePath());
+    entity.SetContents(std::move(contents));
+    subpass->AddEntity(std::move(entity));
+  }
+
+  auto render = [&] {
+    auto rendered = Render(root);
+    GetContentContext().EndFrame();
+    return rendered;
+  };
+  for (size_t frame = 0; frame < 3u; frame++) {
+    ASSERT_TRUE(render());
+  }
+  ASSERT_EQ(GetLastFrameStats().raster_cache_hits, 1u);
+
+  // The hash of the subpass is the same. But the cached target is stale.
+  std::vector<uint8_t> contents(desc.GetSizeOfBaseMipLevel(), 0xFF);
+  ASSERT_TRUE(texture->SetContents(contents.data(), contents.size()));
+  ASSERT_TRUE(render());
+  const auto stats = GetLastFrameStats();
+  ASSERT_EQ(stats.raster_cache_hits, 0u);
+  ASSERT_EQ(stats.offscreen_subpasses, 1u);
+  ASSERT_EQ(GetContentContext().GetRasterCache().GetEntriesEvicted(), 1u);
+}
+
+TEST_F(EntityPassTest, RasterCacheEvictsLeastRecentlyUsedEntries) {
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {8, 8};
+  const auto bytes = desc.GetSizeOfBaseMipLevel();
+
+  RasterCache cache(2u * bytes, 1u, 1u);
+  for (size_t key = 0; key < 3u; key++) {
+    ASSERT_EQ(cache.Get(key), nullptr);
+    ASSERT_TRUE(cache.ShouldCache(key, 1u));
+    cache.Add(key, GetContext()->GetPermanentsAllocator()->CreateTexture(
+                       StorageMode::kHostVisible, desc));
+    cache.EndFrame();
+  }
+
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_EQ(cache.GetCachedBytes(), 2u * bytes);
+  ASSERT_EQ(cache.GetEntriesEvicted(), 1u);
+  ASSERT_EQ(cache.Get(0u), nullptr);
+  ASSERT_NE(cache.Get(2u), nullptr);
+
+  // Entries that are not used for a while are evicted too.
+  for (size_t frame = 0; frame <= RasterCache::kMaxUnusedFrames; frame++) {
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetCachedBytes(), 0u);
+}
+
+TEST_F(EntityPassTest, EntitiesOutsideTheRenderTargetAreCulled) {
+  EntityPass root;
+  auto add_rect = [&](Rect rect, Matrix xformation) {
+    auto entity = MakeRect(rect, Color::Red());
+    entity.SetTransformation(xformation);
+    root.AddEntity(std::move(entity));
+  };
+  add_rect({0, 0, 8, 8}, {});
+  add_rect({0, 0, 8, 8}, Matrix::MakeTranslation({32, 0, 0}));
+  add_rect({-16, -16, 8, 8}, {});
+  // Only visible because of the transformation.
+  add_rect({-16, -16, 8, 8}, Matrix::MakeTranslation({12, 12, 0}));
+
+  ASSERT_TRUE(Render(root));
+  ASSERT_EQ(GetLastFrameStats().entities_culled, 2u);
+}
+
+TEST_F(EntityPassTest, EntitiesHiddenByOpaqueEntitiesAreCulled) {
+  EntityPass root;
+  auto add_rect = [&](Rect rect, Color color, uint32_t stencil_depth = 0u) {
+    auto entity = MakeRect(rect, color);
+    entity.SetStencilDepth(stencil_depth);
+    root.AddEntity(std::move(entity));
+  };
+  // Hidden entirely.
+  add_rect(Rect::MakeLTRB(0, 0, 16, 4), Color::Red());
+  // The top two thirds are hidden.
+  add_rect(Rect::MakeLTRB(0, 0, 16, 12), Color::Green().WithAlpha(0.5));
+  add_rect(Rect::MakeLTRB(0, 0, 16, 8), Color::Blue());
+  // Entities that may be clipped by the stencil don't hide anything.
+  add_rect(Rect::MakeLTRB(0, 0, 16, 16), Color::Red(), 1u);
+
+  ASSERT_TRUE(Render(root));
+  const auto stats = GetLastFrameStats();
+  ASSERT_EQ(stats.entities_occluded, 1u);
+  ASSERT_EQ(stats.entities_trimmed, 1u);
+  ASSERT_EQ(stats.draw_calls, 3u);
+  ASSERT_EQ(stats.pixels_drawn, 64u + 128u + 256u);
+  ASSERT_EQ(stats.pixels_occluded, 64u + 128u);
+}
+
+TEST_F(PipelineBuilderTest, VertexDescriptorsAreShared) {
+  const auto& context = *GetContext();
+  auto a = SolidFillPipeline::Builder::MakeDefaultPipelineDescriptor(context);
+  auto b = SolidFillPipeline::Builder::MakeDefaultPipelineDescriptor(context);
+  ASSERT_TRUE(a.has_value() && b.has_value());
+  ASSERT_TRUE(a->GetVertexDescriptor());
+  ASSERT_EQ(a->GetVertexDescriptor(), b->GetVertexDescriptor());
+  ASSERT_EQ(a->GetVertexDescriptor()->GetStageInputs().size(),
+            SolidFillVertexShader::kAllShaderStageInputs.size());
+}
+
+TEST_F(ContentContextTest, CreatesExpectedVariantsUpFront) {
+  // The variants created up front depend on the options of the context.
+  ContentContext::Options msaa_options;
+  msaa_options.sample_count = SampleCount::kCount4;
+  ContentContext content_context(GetContext(), {msaa_options});
+  ASSERT_TRUE(content_context.IsValid());
+  ASSERT_TRUE(content_context.GetPipelinesReady().get());
+
+  auto pipeline = content_context.GetSolidFillPipeline(msaa_options);
+  ASSERT_TRUE(pipeline);
+  ASSERT_EQ(pipeline->GetDescriptor().GetSampleCount(), SampleCount::kCount4);
+  ASSERT_EQ(content_context.GetClipPipeline(msaa_options)
+                ->GetDescriptor()
+                .GetSampleCount(),
+            SampleCount::kCount4);
+}
+
+TEST_F(ContentContextTest, OptionsAreAppliedToVariants) {
+  auto& content_context = GetContentContext();
+
+  ContentContext::Options opts;
+  opts.blend_mode = Entity::BlendMode::kSource;
+  auto source = content_context.GetSolidFillPipeline(opts);
+  ASSERT_TRUE(source);
+  ASSERT_FALSE(source->GetDescriptor()
+                   .GetColorAttachmentDescriptor(0u)
+                   ->blending_enabled);
+
+  opts.blend_mode = Entity::BlendMode::kPlus;
+  auto plus = content_context.GetSolidFillPipeline(opts);
+  ASSERT_TRUE(plus);
+  ASSERT_EQ(plus->GetDescriptor()
+                .GetColorAttachmentDescriptor(0u)
+                ->dst_color_blend_factor,
+            BlendFactor::kOne);
+
+  // Clips share the solid fill pipeline prototype.
+  auto clip = content_context.GetClipPipeline({});
+  ASSERT_TRUE(clip);
+  ASSERT_NE(clip, content_context.GetSolidFillPipeline({}));
+  const auto& clip_desc = clip->GetDescriptor();
+  ASSERT_EQ(clip_desc.GetColorAttachmentDescriptor(0u)->write_mask,
+            static_cast<uint64_t>(ColorWriteMask::kNone));
+  ASSERT_EQ(clip_desc.GetFrontStencilAttachmentDescriptor()->stencil_compare,
+            CompareFunction::kGreaterEqual);
+  ASSERT_EQ(
+      clip_desc.GetFrontStencilAttachmentDescriptor()->depth_stencil_pass,
+      StencilOperation::kSetToReferenceValue);
+}
+
+TEST_F(ContentContextTest, PipelinesCanBeAcquiredWithoutWaiting) {
+  auto& content_context = GetContentContext();
+  content_context.SetPipelineAcquisition(
+      ContentContext::PipelineAcquisition::kNoWait);
+
+  // Software pipelines are created synchronously so these are always ready.
+  ContentContext::Options msaa_options;
+  msaa_options.sample_count = SampleCount::kCount4;
+  ASSERT_TRUE(content_context.GetSolidFillPipeline({}));
+  ASSERT_TRUE(content_context.GetSolidFillPipeline(msaa_options));
+
+  std::promise<std::shared_ptr<Pipeline>> promise;
+  SolidFillPipeline pending(promise.get_future().share());
+  ASSERT_EQ(pending.GetIfReady(), nullptr);
+  auto pipeline = content_context.GetSolidFillPipeline({});
+  promise.set_value(pipeline);
+  ASSERT_EQ(pending.GetIfReady(), pipeline);
+}
+
+TEST_F(ContentContextTest, PipelinesCanBeLookedUpConcurrently) {
+  const auto& content_context = GetContentContext();
+
+  ContentContext::Options msaa_options;
+  msaa_options.sample_count = SampleCount::kCount4;
+  const std::vector<ContentContext::Options> all_options = {{}, msaa_options};
+
+  // The MSAA variants don't exist yet. The threads race to create them.
+  constexpr size_t kThreadCount = 8u;
+  constexpr size_t kIterationCount = 1000u;
+  std::vector<std::vector<std::shared_ptr<Pipeline>>> results(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&, &result = results[i]]() {
+      for (size_t j = 0; j < kIterationCount; j++) {
+        for (const auto& opts : all_options) {
+          result.push_back(content_context.GetGradientFillPipeline(opts));
+          result.push_back(content_context.GetSolidFillPipeline(opts));
+          result.push_back(content_context.GetTexturePipeline(opts));
+          result.push_back(content_context.GetSolidStrokePipeline(opts));
+          result.push_back(content_context.GetClipPipeline(opts));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Every thread must have seen the same pipeline for each lookup.
+  const auto lookup_count = all_options.size() * 5u;
+  for (const auto& result : results) {
+    ASSERT_EQ(result.size(), kIterationCount * lookup_count);
+    for (size_t i = 0; i < result.size(); i++) {
+      ASSERT_TRUE(result[i]);
+      ASSERT_EQ(result[i], results[0][i % lookup_count]);
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/native_shaders_sw.h"
+
+#include "flutter/impeller/entity/gradient_fill.frag.h"
+#include "flutter/impeller/entity/gradient_fill.vert.h"
+#include "flutter/impeller/entity/solid_fill.frag.h"
+#include "flutter/impeller/entity/solid_fill.vert.h"
+#include "flutter/impeller/entity/solid_stroke.frag.h"
+#include "flutter/impeller/entity/solid_stroke.vert.h"
+#include "flutter/impeller/entity/texture_fill.frag.h"
+#include "flutter/impeller/entity/texture_fill.vert.h"
+#include "impeller/geometry/matrix.h"
+
+namespace impeller {
+
+static Vector4 Transform(const Matrix& mvp, Point point) {
+  return Vector4{point.x, point.y, 0.0, 1.0} * mvp;
+}
+
+/*******************************************************************************
+ ******* Gradient Fill
+ ******************************************************************************/
+
+static Vector4 GradientFillVertex(const ShaderBindingsSW& bindings,
+                                  size_t vertex_index,
+                                  VaryingsSW& varyings) {
+  using VS = GradientFillVertexShader;
+  const auto& frame_info = bindings.GetUniform(VS::kResourceFrameInfo);
+  const auto& vertex = bindings.GetVertex<VS::PerVertexData>(vertex_index);
+  varyings.Set(0u, vertex.vertices);  // interpolated_vertices
+  return Transform(frame_info.mvp, vertex.vertices);
+}
+
+static Color GradientFillFragment(const ShaderBindingsSW& bindings,
+                                  const VaryingsSW& varyings) {
+  using FS = GradientFillFragmentShader;
+  const auto& gradient_info = bindings.GetUniform(FS::kResourceGradientInfo);
+  const auto interpolated_vertices = varyings.GetPoint(0u);
+  const auto direction = gradient_info.end_point - gradient_info.start_point;
+  const auto len_squared =
+      direction.x * direction.x + direction.y * direction.y;
+  const auto offset = interpolated_vertices - gradient_info.start_point;
+  const auto interp =
+      (offset.x * direction.x + offset.y * direction.y) / len_squared;
+  const auto& start = gradient_info.start_color;
+  const auto& end = gradient_info.end_color;
+  return {start.x + (end.x - start.x) * interp,  //
+          start.y + (end.y - start.y) * interp,  //
+          start.z + (end.z - start.z) * interp,  //
+          start.w + (end.w - start.w) * interp};
+}
+
+/*******************************************************************************
+ ******* Solid Fill
+ ******************************************************************************/
+
+static Vector4 SolidFillVertex(const ShaderBindingsSW& bindings,
+                               size_t vertex_index,
+                               VaryingsSW& varyings) {
+  using VS = SolidFillVertexShader;
+  const auto& frame_info = bindings.GetUniform(VS::kResourceFrameInfo);
+  const auto& vertex = bindings.GetVertex<VS::PerVertexData>(vertex_index);
+  varyings.Set(0u, frame_info.color);  // color
+  return Transform(frame_info.mvp, vertex.vertices);
+}
+
+static Color SolidFillFragment(const ShaderBindingsSW& bindings,
+                               const VaryingsSW& varyings) {
+  return varyings.GetColor(0u);
+}
+
+/*******************************************************************************
+ ******* Solid Stroke
+ ******************************************************************************/
+
+static Vector4 SolidStrokeVertex(const ShaderBindingsSW& bindings,
+                                 size_t vertex_index,
+                                 VaryingsSW& varyings) {
+  using VS = SolidStrokeVertexShader;
+  const auto& frame_info = bindings.GetUniform(VS::kResourceFrameInfo);
+  const auto& stroke_info = bindings.GetUniform(VS::kResourceStrokeInfo);
+  const auto& vertex = bindings.GetVertex<VS::PerVertexData>(vertex_index);
+  // Push one vertex by the half stroke size along the normal vector.
+  const auto offset = vertex.vertex_normal * (stroke_info.size * 0.5f);
+  varyings.Set(0u, stroke_info.color);  // stroke_color
+  return Transform(frame_info.mvp, vertex.vertex_position + offset);
+}
+
+static Color SolidStrokeFragment(const ShaderBindingsSW& bindings,
+                                 const VaryingsSW& varyings) {
+  return varyings.GetColor(0u);
+}
+
+/*******************************************************************************
+ ******* Texture Fill
+ ******************************************************************************/
+
+static Vector4 TextureFillVertex(const ShaderBindingsSW& bindings,
+                                 size_t vertex_index,
+                                 VaryingsSW& varyings) {
+  using VS = TextureFillVertexShader;
+  const auto& frame_info = bindings.GetUniform(VS::kResourceFrameInfo);
+  const auto& vertex = bindings.GetVertex<VS::PerVertexData>(vertex_index);
+  varyings.Set(0u, vertex.texture_coords);  // v_texture_coords
+  varyings.Set(2u, frame_info.alpha);       // v_alpha
+  return Transform(frame_info.mvp, vertex.vertices);
+}
+
+static Color TextureFillFragment(const ShaderBindingsSW& bindings,
+                                 const VaryingsSW& varyings) {
+  using FS = TextureFillFragmentShader;
+  auto sampled =
+      bindings.Sample(FS::kResourceTextureSampler, varyings.GetPoint(0u));
+  sampled.alpha *= varyings.GetScalar(2u);
+  return sampled;
+}
+
+const std::vector<NativeShaderSW>& GetEntityNativeShadersSW() {
+  static const std::vector<NativeShaderSW> kShaders = {
+      NativeShaderSW::Vertex(GradientFillVertexShader::kEntrypointName,
+                             GradientFillVertex, 2u),
+      NativeShaderSW::Fragment(GradientFillFragmentShader::kEntrypointName,
+                               GradientFillFragment),
+      NativeShaderSW::Vertex(SolidFillVertexShader::kEntrypointName,
+                             SolidFillVertex, 4u),
+      NativeShaderSW::Fragment(SolidFillFragmentShader::kEntrypointName,
+                               SolidFillFragment),
+      NativeShaderSW::Vertex(SolidStrokeVertexShader::kEntrypointName,
+                             SolidStrokeVertex, 4u),
+      NativeShaderSW::Fragment(SolidStrokeFragmentShader::kEntrypointName,
+                               SolidStrokeFragment),
+      NativeShaderSW::Vertex(TextureFillVertexShader::kEntrypointName,
+                             TextureFillVertex, 3u),
+      NativeShaderSW::Fragment(TextureFillFragmentShader::kEntrypointName,
+                               TextureFillFragment),
+  };
+  return kShaders;
+}
+
+}  // namespace impeller
@@ -0,0 +1,22 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <vector>
+
+#include "impeller/renderer/backend/software/shader_function_sw.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Native implementations of the shaders in `entity/shaders` for
+///             use with the software backend. These must be kept in sync with
+///             the GLSL sources.
+///
+/// @return     The shaders to create a `ContextSW` with.
+///
+const std::vector<NativeShaderSW>& GetEntityNativeShadersSW();
+
+}  // namespace impeller
@@ -0,0 +1,185 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/raster_cache.h"
+
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+static size_t GetTextureBytes(const Texture& texture) {
+  const auto& desc = texture.GetTextureDescriptor();
+  return desc.GetSizeOfBaseMipLevel() * static_cast<size_t>(desc.sample_count);
+}
+
+RasterCache::RasterCache(size_t budget,
+                         size_t access_threshold,
+                         size_t min_entity_count)
+    : budget_(budget),
+      access_threshold_(access_threshold),
+      min_entity_count_(min_entity_count) {}
+
+RasterCache::~RasterCache() = default;
+
+bool RasterCache::DrawsTextures(const Entry& entry, const Textures& textures) {
+  if (entry.drawn_textures.size() != textures.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < textures.size(); i++) {
+    const auto& drawn = entry.drawn_textures[i];
+    // Expired textures may share their address with newer ones.
+    auto texture = drawn.texture.lock();
+    if (!texture || texture != textures[i] ||
+        texture->GetContentsGeneration() != drawn.contents_generation) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<Texture> RasterCache::Get(size_t key,
+                                          const Textures& textures) {
+  std::scoped_lock lock(mutex_);
+
+  if (auto found = entries_.find(key); found != entries_.end()) {
+    if (DrawsTextures(found->second, textures)) {
+      found->second.last_used_frame = frame_;
+      hits_++;
+      return found->second.texture;
+    }
+    Evict(found);
+  }
+
+  misses_++;
+  // Subpasses rendered more than once in the same frame only count once.
+  auto& candidate = candidates_[key];
+  if (candidate.access_count == 0u || candidate.last_access_frame != frame_) {
+    candidate.access_count++;
+    candidate.last_access_frame = frame_;
+  }
+  return nullptr;
+}
+
+bool RasterCache::ShouldCache(size_t key, size_t entity_count) const {
+  if (entity_count < min_entity_count_) {
+    return false;
+  }
+  std::scoped_lock lock(mutex_);
+  auto found = candidates_.find(key);
+  return found != candidates_.end() &&
+         found->second.access_count >= access_threshold_;
+}
+
+bool RasterCache::Add(size_t key,
+                      std::shared_ptr<Texture> texture,
+                      const Textures& textures) {
+  if (!texture) {
+    return false;
+  }
+
+  const auto bytes = GetTextureBytes(*texture);
+  if (bytes > budget_) {
+    return false;
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (entries_.count(key) != 0u) {
+    return false;
+  }
+  while (cached_bytes_ + bytes > budget_ && EvictLeastRecentlyUsed()) {
+  }
+
+  Entry entry;
+  entry.texture = std::move(texture);
+  entry.drawn_textures.reserve(textures.size());
+  for (const auto& drawn : textures) {
+    entry.drawn_textures.push_back(
+        {drawn, drawn ? drawn->GetContentsGeneration() : 0u});
+  }
+  entry.bytes = bytes;
+  entry.last_used_frame = frame_;
+  entries_[key] = std::move(entry);
+  cached_bytes_ += bytes;
+  candidates_.erase(key);
+  return true;
+}
+
+bool RasterCache::EvictLeastRecentlyUsed() {
+  auto found = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (found == entries_.end() ||
+        it->second.last_used_frame < found->second.last_used_frame) {
+      found = it;
+    }
+  }
+  if (found == entries_.end()) {
+    return false;
+  }
+  Evict(found);
+  return true;
+}
+
+void RasterCache::Evict(std::unordered_map<size_t, Entry>::iterator entry) {
+  cached_bytes_ -= entry->second.bytes;
+  entries_evicted_++;
+  entries_.erase(entry);
+}
+
+void RasterCache::EndFrame() {
+  std::scoped_lock lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (frame_ - it->second.last_used_frame >= kMaxUnusedFrames) {
+      cached_bytes_ -= it->second.bytes;
+      entries_evicted_++;
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // Only subpasses rendered in consecutive frames become cached.
+  for (auto it = candidates_.begin(); it != candidates_.end();) {
+    if (it->second.last_access_frame != frame_) {
+      it = candidates_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  frame_++;
+}
+
+size_t RasterCache::GetHits() const {
+  std::scoped_lock lock(mutex_);
+  return hits_;
+}
+
+size_t RasterCache::GetMisses() const {
+  std::scoped_lock lock(mutex_);
+  return misses_;
+}
+
+double RasterCache::GetHitRate() const {
+  std::scoped_lock lock(mutex_);
+  const auto lookups = hits_ + misses_;
+  if (lookups == 0u) {
+    return 0.0;
+  }
+  return static_cast<double>(hits_) / static_cast<double>(lookups);
+}
+
+size_t RasterCache::GetEntriesEvicted() const {
+  std::scoped_lock lock(mutex_);
+  return entries_evicted_;
+}
+
+size_t RasterCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t RasterCache::GetCachedBytes() const {
+  std::scoped_lock lock(mutex_);
+  return cached_bytes_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,173 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+class Texture;
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the render targets of offscreen subpasses whose contents
+///             don't change from frame to frame so that they can be drawn again
+///             without rendering the subpass.
+///
+///             Entries are keyed by a hash of everything that affects what the
+///             subpass renders into its target. Subpasses are rendered in their
+///             own coordinate space and transformed when they are drawn into
+///             their parent. So moving, scaling or rotating a subpass still
+///             hits the cache. Hashes only identify the textures a subpass
+///             draws. So entries also remember those textures and the
+///             generation of their contents, and are only hit if they still
+///             match.
+///
+///             Caching a subpass costs texture memory for as long as it stays
+///             in the cache. A subpass is only worth caching if it has at
+///             least `min_entity_count` entities and has been rendered in
+///             `access_threshold` consecutive frames. Entries are evicted if
+///             they have not been used for `kMaxUnusedFrames` frames. The least
+///             recently used entries are also evicted to keep the cache within
+///             its memory budget. Cached textures only count against this
+///             budget. Those that came from a texture pool must be released
+///             from it.
+///
+///             The cache may be used from multiple threads.
+///
+class RasterCache {
+ public:
+  static constexpr size_t kMaxUnusedFrames = 3u;
+
+  static constexpr size_t kDefaultBudget = 64u * 1024u * 1024u;
+
+  static constexpr size_t kDefaultAccessThreshold = 2u;
+
+  static constexpr size_t kDefaultMinEntityCount = 2u;
+
+  using Textures = std::vector<std::shared_ptr<const Texture>>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a raster cache.
+  ///
+  /// @param[in]  budget            The number of bytes of texture memory the
+  ///                               cache may hold on to.
+  /// @param[in]  access_threshold  The number of consecutive frames a subpass
+  ///                               must be rendered in before it is cached.
+  /// @param[in]  min_entity_count  The number of entities, including those of
+  ///                               nested subpasses, below which a subpass is
+  ///                               cheap enough to render every frame.
+  ///
+  RasterCache(size_t budget = kDefaultBudget,
+              size_t access_threshold = kDefaultAccessThreshold,
+              size_t min_entity_count = kDefaultMinEntityCount);
+
+  ~RasterCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the texture a subpass was rendered into earlier.
+  ///
+  /// @param[in]  key       The hash of the subpass.
+  /// @param[in]  textures  The textures drawn by the subpass. Entries drawing
+  ///                       other textures, or textures that were modified
+  ///                       since, are evicted instead of returned.
+  ///
+  /// @return     The texture or null if the subpass is not cached. A miss
+  ///             counts towards the frames the subpass has been rendered in.
+  ///
+  std::shared_ptr<Texture> Get(size_t key, const Textures& textures = {});
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the texture a subpass is about to be rendered into
+  ///             should be added to the cache.
+  ///
+  bool ShouldCache(size_t key, size_t entity_count) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add the texture a subpass was rendered into. The subpass must
+  ///             have been rendered completely.
+  ///
+  /// @param[in]  key       The hash of the subpass.
+  /// @param[in]  texture   The texture the subpass was rendered into.
+  /// @param[in]  textures  The textures drawn by the subpass. Only weak
+  ///                       references to them are kept.
+  ///
+  /// @return     Whether the texture was added. Textures larger than the
+  ///             budget of the cache are not, and neither are textures for
+  ///             subpasses that are already cached.
+  ///
+  bool Add(size_t key,
+           std::shared_ptr<Texture> texture,
+           const Textures& textures = {});
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame and evict entries that have not been
+  ///             used for too long.
+  ///
+  void EndFrame();
+
+  size_t GetHits() const;
+
+  size_t GetMisses() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The fraction of lookups that were hits over the lifetime of
+  ///             the cache. Zero if there have been no lookups.
+  ///
+  double GetHitRate() const;
+
+  size_t GetEntriesEvicted() const;
+
+  size_t GetEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of bytes of texture memory held by the cache.
+  ///
+  size_t GetCachedBytes() const;
+
+ private:
+  struct DrawnTexture {
+    std::weak_ptr<const Texture> texture;
+    size_t contents_generation = 0u;
+  };
+
+  struct Entry {
+    std::shared_ptr<Texture> texture;
+    std::vector<DrawnTexture> drawn_textures;
+    size_t bytes = 0u;
+    size_t last_used_frame = 0u;
+  };
+
+  struct Candidate {
+    size_t access_count = 0u;
+    size_t last_access_frame = 0u;
+  };
+
+  const size_t budget_;
+  const size_t access_threshold_;
+  const size_t min_entity_count_;
+  mutable std::mutex mutex_;
+  std::unordered_map<size_t, Entry> entries_;
+  std::unordered_map<size_t, Candidate> candidates_;
+  size_t frame_ = 0u;
+  size_t cached_bytes_ = 0u;
+  size_t hits_ = 0u;
+  size_t misses_ = 0u;
+  size_t entries_evicted_ = 0u;
+
+  bool EvictLeastRecentlyUsed();
+
+  void Evict(std::unordered_map<size_t, Entry>::iterator entry);
+
+  static bool DrawsTextures(const Entry& entry, const Textures& textures);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCache);
+};
+
+}  // namespace impeller
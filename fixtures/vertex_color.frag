@@ -0,0 +1,11 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+in vec4 interpolated_color;
+
+out vec4 frag_color;
+
+void main() {
+  frag_color = interpolated_color;
+}
@@ -310,5 +310,114 @@ TEST(GeometryTest, RectIntersection) {
   }
 }
 
+TEST(GeometryTest, MatrixTransformBounds) {
+  {
+    auto m =
+        Matrix::MakeTranslation({10, 20, 0}) * Matrix::MakeScale({2, 3, 1});
+    auto bounds = m.TransformBounds(Rect(0, 0, 10, 10));
+    ASSERT_TRUE(bounds.has_value());
+    ASSERT_RECT_NEAR(bounds.value(), Rect(10, 20, 20, 30));
+  }
+
+  {
+    auto m = Matrix::MakeRotationZ(Radians{kPiOver2});
+    auto bounds = m.TransformBounds(Rect(0, 0, 10, 20));
+    ASSERT_TRUE(bounds.has_value());
+    ASSERT_RECT_NEAR(bounds.value(), Rect(-20, 0, 20, 10));
+  }
+}
+
+TEST(GeometryTest, PathGetRect) {
+  {
+    auto path = PathBuilder{}.AddRect(Rect(10, 20, 30, 40)).TakePath();
+    auto rect = path.GetRect();
+    ASSERT_TRUE(rect.has_value());
+    ASSERT_RECT_NEAR(rect.value(), Rect(10, 20, 30, 40));
+  }
+
+  {
+    Path path;
+    path.AddLinearComponent({0, 0}, {0, 10})
+        .AddLinearComponent({0, 10}, {10, 10})
+        .AddLinearComponent({10, 10}, {10, 0})
+        .AddLinearComponent({10, 0}, {0, 0});
+    auto rect = path.GetRect();
+    ASSERT_TRUE(rect.has_value());
+    ASSERT_RECT_NEAR(rect.value(), Rect(0, 0, 10, 10));
+  }
+
+  {
+    // Not closed.
+    Path path;
+    path.AddLinearComponent({0, 0}, {10, 0})
+        .AddLinearComponent({10, 0}, {10, 10})
+        .AddLinearComponent({10, 10}, {0, 10})
+        .AddLinearComponent({0, 10}, {0, 5});
+    ASSERT_FALSE(path.GetRect().has_value());
+  }
+
+  ASSERT_FALSE(PathBuilder{}
+                   .AddRoundedRect(Rect(0, 0, 10, 10), 2)
+                   .TakePath()
+                   .GetRect()
+                   .has_value());
+}
+
+TEST(GeometryTest, MatrixIsTranslationScaleOnly) {
+  ASSERT_TRUE(Matrix{}.IsTranslationScaleOnly());
+  auto translate_scale =
+      Matrix::MakeTranslation({1, 2, 3}) * Matrix::MakeScale({2, 3, 1});
+  ASSERT_TRUE(translate_scale.IsTranslationScaleOnly());
+  ASSERT_FALSE(Matrix::MakeRotationZ(Radians{1}).IsTranslationScaleOnly());
+  ASSERT_FALSE(Matrix::MakeSkew(1, 0).IsTranslationScaleOnly());
+}
+
+TEST(GeometryTest, PathHashesDependOnComponents) {
+  const auto hash =
+      PathBuilder{}.AddRect(Rect(10, 20, 30, 40)).TakePath().GetHash();
+  ASSERT_EQ(hash,
+            PathBuilder{}.AddRect(Rect(10, 20, 30, 40)).TakePath().GetHash());
+  ASSERT_NE(hash,
+            PathBuilder{}.AddRect(Rect(10, 20, 30, 41)).TakePath().GetHash());
+  ASSERT_NE(hash, PathBuilder{}
+                      .AddRect(Rect(10, 20, 30, 40))
+                      .TakePath(FillType::kOdd)
+                      .GetHash());
+  ASSERT_NE(hash,
+            PathBuilder{}.AddOval(Rect(10, 20, 30, 40)).TakePath().GetHash());
+}
+
+TEST(GeometryTest, RectContainsRect) {
+  Rect a(0, 0, 100, 100);
+  ASSERT_TRUE(a.Contains(Rect(0, 0, 100, 100)));
+  ASSERT_TRUE(a.Contains(Rect(10, 10, 20, 20)));
+  ASSERT_FALSE(a.Contains(Rect(90, 90, 20, 20)));
+  ASSERT_FALSE(a.Contains(Rect(-1, 0, 10, 10)));
+}
+
+TEST(GeometryTest, RectCutout) {
+  IRect a = IRect::MakeLTRB(0, 0, 100, 100);
+
+  // Covered entirely.
+  ASSERT_FALSE(a.Cutout(IRect::MakeLTRB(-10, -10, 110, 110)).has_value());
+
+  // Covered along an edge.
+  ASSERT_EQ(a.Cutout(IRect::MakeLTRB(-10, -10, 110, 40)),
+            IRect::MakeLTRB(0, 40, 100, 100));
+  ASSERT_EQ(a.Cutout(IRect::MakeLTRB(-10, 60, 110, 110)),
+            IRect::MakeLTRB(0, 0, 100, 60));
+  ASSERT_EQ(a.Cutout(IRect::MakeLTRB(-10, -10, 30, 110)),
+            IRect::MakeLTRB(30, 0, 100, 100));
+  ASSERT_EQ(a.Cutout(IRect::MakeLTRB(70, 0, 100, 100)),
+            IRect::MakeLTRB(0, 0, 70, 100));
+
+  // The uncovered part isn't a rect.
+  ASSERT_EQ(a.Cutout(IRect::MakeLTRB(40, 40, 60, 60)), a);
+  ASSERT_EQ(a.Cutout(IRect::MakeLTRB(-10, 40, 110, 60)), a);
+
+  // Disjoint.
+  ASSERT_EQ(a.Cutout(IRect::MakeLTRB(200, 200, 300, 300)), a);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,9 +4,12 @@
 
 #include "impeller/geometry/matrix.h"
 
+#include <algorithm>
 #include <climits>
 #include <sstream>
 
+#include "flutter/fml/hash_combine.h"
+
 namespace impeller {
 
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
@@ -193,6 +196,30 @@ Scalar Matrix::GetDeterminant() const {
   return b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
 }
 
+std::optional<Rect> Matrix::TransformBounds(const Rect& rect) const {
+  const auto ltrb = rect.GetLTRB();
+  const Point corners[] = {
+      {ltrb[0], ltrb[1]},
+      {ltrb[2], ltrb[1]},
+      {ltrb[0], ltrb[3]},
+      {ltrb[2], ltrb[3]},
+  };
+
+  std::optional<Point> min;
+  std::optional<Point> max;
+  for (const auto& corner : corners) {
+    const auto transformed = Vector4(corner.x, corner.y, 0.0, 1.0) * *this;
+    if (transformed.w <= 0.0) {
+      return std::nullopt;
+    }
+    const auto point =
+        Point{transformed.x / transformed.w, transformed.y / transformed.w};
+    min = min.has_value() ? min->Min(point) : point;
+    max = max.has_value() ? max->Max(point) : point;
+  }
+  return Rect::MakeLTRB(min->x, min->y, max->x, max->y);
+}
+
 /*
  *  Adapted for Impeller from Graphics Gems:
  *  http://www.realtimerendering.com/resources/GraphicsGems/gemsii/unmatrix.c
@@ -389,4 +416,12 @@ uint64_t MatrixDecomposition::GetComponentsMask() const {
   return mask;
 }
 
+std::size_t Matrix::GetHash() const {
+  auto seed = fml::HashCombine();
+  for (auto value : m) {
+    fml::HashCombineSeed(seed, value);
+  }
+  return seed;
+}
+
 }  // namespace impeller
@@ -12,6 +12,7 @@
 #include "impeller/geometry/matrix_decomposition.h"
 #include "impeller/geometry/point.h"
 #include "impeller/geometry/quaternion.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/geometry/scalar.h"
 #include "impeller/geometry/shear.h"
 #include "impeller/geometry/size.h"
@@ -224,6 +225,21 @@ struct Matrix {
             m[9] == 0 && m[10] == 1 && m[11] == 0 && m[14] == 0 && m[15] == 1);
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the matrix only translates and scales. Such matrices
+  ///             map axis aligned rectangles to axis aligned rectangles.
+  ///
+  constexpr bool IsTranslationScaleOnly() const {
+    return (
+        // clang-format off
+        m[1]  == 0.0 && m[2]  == 0.0 && m[3]  == 0.0 &&
+        m[4]  == 0.0 && m[6]  == 0.0 && m[7]  == 0.0 &&
+        m[8]  == 0.0 && m[9]  == 0.0 && m[11] == 0.0 &&
+        m[15] == 1.0
+        // clang-format on
+    );
+  }
+
   constexpr bool IsIdentity() const {
     return (
         // clang-format off
@@ -237,6 +253,18 @@ struct Matrix {
 
   std::optional<MatrixDecomposition> Decompose() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the axis aligned bounds of a rectangle after this
+  ///             transformation has been applied to it. The z coordinate of
+  ///             the rectangle is zero.
+  ///
+  /// @return     The bounds or std::nullopt if a perspective transformation
+  ///             maps a corner of the rectangle behind the eye.
+  ///
+  std::optional<Rect> TransformBounds(const Rect& rect) const;
+
+  std::size_t GetHash() const;
+
   constexpr bool operator==(const Matrix& m) const {
     // clang-format off
     return vec[0] == m.vec[0]
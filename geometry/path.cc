@@ -6,6 +6,8 @@
 
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
+
 namespace impeller {
 
 Path::Path() = default;
@@ -189,6 +191,33 @@ std::optional<Rect> Path::GetBoundingBox() const {
   return Rect{min.x, min.y, difference.x, difference.y};
 }
 
+std::optional<Rect> Path::GetRect() const {
+  // Rectangles with either winding fill the same area with these fill types.
+  if (fill_ != FillType::kNonZero && fill_ != FillType::kOdd) {
+    return std::nullopt;
+  }
+  if (components_.size() != 4u || linears_.size() != 4u) {
+    return std::nullopt;
+  }
+  // Four connected segments that alternate between horizontal and vertical
+  // and close the contour.
+  const bool first_horizontal = linears_[0].p1.y == linears_[0].p2.y;
+  for (size_t i = 0; i < 4u; i++) {
+    const auto& linear = linears_[i];
+    const auto& next = linears_[(i + 1) % 4u];
+    if (linear.p2 != next.p1) {
+      return std::nullopt;
+    }
+    const bool horizontal = linear.p1.y == linear.p2.y;
+    const bool vertical = linear.p1.x == linear.p2.x;
+    if (horizontal == vertical ||
+        horizontal != (first_horizontal == (i % 2u == 0u))) {
+      return std::nullopt;
+    }
+  }
+  return GetBoundingBox();
+}
+
 std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
   if (linears_.empty() && quads_.empty() && cubics_.empty()) {
     return std::nullopt;
@@ -228,4 +257,40 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
   return std::make_pair(min.value(), max.value());
 }
 
+static void HashCombinePoint(std::size_t& seed, const Point& point) {
+  fml::HashCombineSeed(seed, point.x, point.y);
+}
+
+std::size_t Path::GetHash() const {
+  auto seed = fml::HashCombine();
+  fml::HashCombineSeed(seed, fill_);
+  for (const auto& component : components_) {
+    fml::HashCombineSeed(seed, component.type);
+    switch (component.type) {
+      case ComponentType::kLinear: {
+        const auto& linear = linears_[component.index];
+        HashCombinePoint(seed, linear.p1);
+        HashCombinePoint(seed, linear.p2);
+        break;
+      }
+      case ComponentType::kQuadratic: {
+        const auto& quad = quads_[component.index];
+        HashCombinePoint(seed, quad.p1);
+        HashCombinePoint(seed, quad.cp);
+        HashCombinePoint(seed, quad.p2);
+        break;
+      }
+      case ComponentType::kCubic: {
+        const auto& cubic = cubics_[component.index];
+        HashCombinePoint(seed, cubic.p1);
+        HashCombinePoint(seed, cubic.cp1);
+        HashCombinePoint(seed, cubic.cp2);
+        HashCombinePoint(seed, cubic.p2);
+        break;
+      }
+    }
+  }
+  return seed;
+}
+
 }  // namespace impeller
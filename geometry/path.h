@@ -81,8 +81,20 @@ class Path {
 
   std::optional<Rect> GetBoundingBox() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      If the path fills exactly one axis aligned rectangle, get that
+  ///             rectangle.
+  ///
+  std::optional<Rect> GetRect() const;
+
   std::optional<std::pair<Point, Point>> GetMinMaxCoveragePoints() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of the fill type and the components of the path. Paths
+  ///             with equal hashes describe the same shape.
+  ///
+  std::size_t GetHash() const;
+
  private:
   struct ComponentIndexPair {
     ComponentType type = ComponentType::kLinear;
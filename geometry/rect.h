@@ -79,6 +79,10 @@ struct TRect {
     return origin == r.origin && size == r.size;
   }
 
+  constexpr bool operator!=(const TRect& r) const {
+    return origin != r.origin || size != r.size;
+  }
+
   constexpr bool Contains(const TPoint<Type>& p) const {
     return p.x >= origin.x && p.x <= size.width && p.y >= origin.y &&
            p.y <= size.height;
@@ -122,7 +126,55 @@ struct TRect {
   }
 
   constexpr bool IntersectsWithRect(const TRect& o) const {
-    return Interesection(o).has_value();
+    return Intersection(o).has_value();
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the other rect lies entirely within this one.
+  ///
+  constexpr bool Contains(const TRect& o) const {
+    auto this_ltrb = GetLTRB();
+    auto other_ltrb = o.GetLTRB();
+    return other_ltrb[0] >= this_ltrb[0] && other_ltrb[1] >= this_ltrb[1] &&
+           other_ltrb[2] <= this_ltrb[2] && other_ltrb[3] <= this_ltrb[3];
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the bounds of the part of this rect not covered by the
+  ///             other rect. This is exact when the other rect spans this one
+  ///             along an axis. Otherwise, this rect is returned unchanged.
+  ///
+  /// @return     The bounds of the uncovered part or std::nullopt if the other
+  ///             rect covers this one entirely.
+  ///
+  constexpr std::optional<TRect<T>> Cutout(const TRect& o) const {
+    const auto this_ltrb = GetLTRB();
+    const auto other_ltrb = o.GetLTRB();
+    auto left = this_ltrb[0];
+    auto top = this_ltrb[1];
+    auto right = this_ltrb[2];
+    auto bottom = this_ltrb[3];
+    if (other_ltrb[0] <= left && other_ltrb[2] >= right) {
+      if (other_ltrb[1] <= top && other_ltrb[3] > top) {
+        top = std::min(other_ltrb[3], bottom);
+      }
+      if (other_ltrb[3] >= bottom && other_ltrb[1] < bottom) {
+        bottom = std::max(other_ltrb[1], top);
+      }
+    }
+    if (other_ltrb[1] <= top && other_ltrb[3] >= bottom) {
+      if (other_ltrb[0] <= left && other_ltrb[2] > left) {
+        left = std::min(other_ltrb[2], right);
+      }
+      if (other_ltrb[2] >= right && other_ltrb[0] < right) {
+        right = std::max(other_ltrb[0], left);
+      }
+    }
+    auto result = TRect::MakeLTRB(left, top, right, bottom);
+    if (result.size.IsEmpty()) {
+      return std::nullopt;
+    }
+    return result;
   }
 };
 
@@ -29,6 +29,8 @@ class Playground : public ::testing::Test {
 
   bool OpenPlaygroundHere(Renderer::RenderCallback render_callback);
 
+  FrameStats GetLastFrameStats() const;
+
   std::shared_ptr<Texture> CreateTextureForFixture(
       const char* fixture_name) const;
 
@@ -165,6 +165,10 @@ bool Playground::OpenPlaygroundHere(Renderer::RenderCallback render_callback) {
   return true;
 }
 
+FrameStats Playground::GetLastFrameStats() const {
+  return renderer_.GetLastFrameStats();
+}
+
 std::shared_ptr<Texture> Playground::CreateTextureForFixture(
     const char* fixture_name) const {
   CompressedImage compressed_image(
@@ -174,7 +178,11 @@ std::shared_ptr<Texture> Playground::CreateTextureForFixture(
   // bit pixel strides, this is overkill. Since this is a test fixture we
   // aren't necessarily trying to eke out memory savings here and instead
   // favor simplicity.
-  auto image = compressed_image.Decode().ConvertToRGBA();
+  auto decoded_image = compressed_image.Decode();
+  const auto is_opaque =
+      decoded_image.GetFormat() == DecompressedImage::Format::kGrey ||
+      decoded_image.GetFormat() == DecompressedImage::Format::kRGB;
+  auto image = decoded_image.ConvertToRGBA();
   if (!image.IsValid()) {
     VALIDATION_LOG << "Could not find fixture named " << fixture_name;
     return nullptr;
@@ -194,6 +202,7 @@ std::shared_ptr<Texture> Playground::CreateTextureForFixture(
     return nullptr;
   }
   texture->SetLabel(fixture_name);
+  texture->SetIsOpaque(is_opaque);
 
   auto uploaded = texture->SetContents(image.GetAllocation()->GetMapping(),
                                        image.GetAllocation()->GetSize());
@@ -4,12 +4,65 @@
 
 #include "impeller/renderer/allocator.h"
 
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/range.h"
+
 namespace impeller {
 
 Allocator::Allocator() = default;
 
 Allocator::~Allocator() = default;
 
+std::shared_ptr<DeviceBuffer> Allocator::CreateBuffer(StorageMode mode,
+                                                      size_t length) {
+  auto buffer = OnCreateBuffer(mode, length);
+  if (buffer) {
+    device_buffers_created_.fetch_add(1u, std::memory_order_relaxed);
+  }
+  return buffer;
+}
+
+std::shared_ptr<Texture> Allocator::CreateTexture(
+    StorageMode mode,
+    const TextureDescriptor& desc) {
+  auto texture = OnCreateTexture(mode, desc);
+  if (texture) {
+    textures_created_.fetch_add(1u, std::memory_order_relaxed);
+  }
+  return texture;
+}
+
+std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
+    const uint8_t* buffer,
+    size_t length) {
+  auto new_buffer = CreateBuffer(StorageMode::kHostVisible, length);
+
+  if (!new_buffer) {
+    return nullptr;
+  }
+
+  auto entire_range = Range{0, length};
+
+  if (!new_buffer->CopyHostBuffer(buffer, entire_range)) {
+    return nullptr;
+  }
+
+  return new_buffer;
+}
+
+std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
+    const fml::Mapping& mapping) {
+  return CreateBufferWithCopy(mapping.GetMapping(), mapping.GetSize());
+}
+
+size_t Allocator::GetDeviceBuffersCreated() const {
+  return device_buffers_created_.load(std::memory_order_relaxed);
+}
+
+size_t Allocator::GetTexturesCreated() const {
+  return textures_created_.load(std::memory_order_relaxed);
+}
+
 bool Allocator::RequiresExplicitHostSynchronization(StorageMode mode) {
   if (mode != StorageMode::kHostVisible) {
     return false;
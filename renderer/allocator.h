@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include "flutter/fml/macros.h"
@@ -56,26 +57,45 @@ class Allocator {
 
   bool IsValid() const;
 
-  virtual std::shared_ptr<DeviceBuffer> CreateBuffer(StorageMode mode,
-                                                     size_t length) = 0;
+  std::shared_ptr<DeviceBuffer> CreateBuffer(StorageMode mode, size_t length);
 
-  virtual std::shared_ptr<Texture> CreateTexture(
-      StorageMode mode,
-      const TextureDescriptor& desc) = 0;
+  std::shared_ptr<Texture> CreateTexture(StorageMode mode,
+                                         const TextureDescriptor& desc);
 
-  virtual std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(
-      const uint8_t* buffer,
-      size_t length) = 0;
+  std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(const uint8_t* buffer,
+                                                     size_t length);
 
-  virtual std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(
-      const fml::Mapping& mapping) = 0;
+  std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(
+      const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of device buffers successfully created by this
+  ///             allocator over its lifetime. Used to derive frame statistics.
+  ///
+  size_t GetDeviceBuffersCreated() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of textures successfully created by this allocator
+  ///             over its lifetime. Used to derive frame statistics.
+  ///
+  size_t GetTexturesCreated() const;
 
   static bool RequiresExplicitHostSynchronization(StorageMode mode);
 
  protected:
   Allocator();
 
+  virtual std::shared_ptr<DeviceBuffer> OnCreateBuffer(StorageMode mode,
+                                                       size_t length) = 0;
+
+  virtual std::shared_ptr<Texture> OnCreateTexture(
+      StorageMode mode,
+      const TextureDescriptor& desc) = 0;
+
  private:
+  std::atomic_size_t device_buffers_created_ = 0u;
+  std::atomic_size_t textures_created_ = 0u;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Allocator);
 };
 
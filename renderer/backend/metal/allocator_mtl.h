@@ -34,22 +34,14 @@ class AllocatorMTL final : public Allocator {
   bool IsValid() const;
 
   // |Allocator|
-  std::shared_ptr<DeviceBuffer> CreateBuffer(StorageMode mode,
-                                             size_t length) override;
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(StorageMode mode,
+                                               size_t length) override;
 
   // |Allocator|
-  std::shared_ptr<Texture> CreateTexture(
+  std::shared_ptr<Texture> OnCreateTexture(
       StorageMode mode,
       const TextureDescriptor& desc) override;
 
-  // |Allocator|
-  std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(const uint8_t* buffer,
-                                                     size_t length) override;
-
-  // |Allocator|
-  std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(
-      const fml::Mapping& mapping) override;
-
   FML_DISALLOW_COPY_AND_ASSIGN(AllocatorMTL);
 };
 
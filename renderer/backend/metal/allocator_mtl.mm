@@ -78,8 +78,8 @@ static MTLStorageMode ToMTLStorageMode(StorageMode mode) {
   return MTLStorageModeShared;
 }
 
-std::shared_ptr<DeviceBuffer> AllocatorMTL::CreateBuffer(StorageMode mode,
-                                                         size_t length) {
+std::shared_ptr<DeviceBuffer> AllocatorMTL::OnCreateBuffer(StorageMode mode,
+                                                           size_t length) {
   auto buffer = [device_ newBufferWithLength:length
                                      options:ToMTLResourceOptions(mode)];
   if (!buffer) {
@@ -89,30 +89,7 @@ std::shared_ptr<DeviceBuffer> AllocatorMTL::CreateBuffer(StorageMode mode,
       new DeviceBufferMTL(buffer, length, mode));
 }
 
-std::shared_ptr<DeviceBuffer> AllocatorMTL::CreateBufferWithCopy(
-    const uint8_t* buffer,
-    size_t length) {
-  auto new_buffer = CreateBuffer(StorageMode::kHostVisible, length);
-
-  if (!new_buffer) {
-    return nullptr;
-  }
-
-  auto entire_range = Range{0, length};
-
-  if (!new_buffer->CopyHostBuffer(buffer, entire_range)) {
-    return nullptr;
-  }
-
-  return new_buffer;
-}
-
-std::shared_ptr<DeviceBuffer> AllocatorMTL::CreateBufferWithCopy(
-    const fml::Mapping& mapping) {
-  return CreateBufferWithCopy(mapping.GetMapping(), mapping.GetSize());
-}
-
-std::shared_ptr<Texture> AllocatorMTL::CreateTexture(
+std::shared_ptr<Texture> AllocatorMTL::OnCreateTexture(
     StorageMode mode,
     const TextureDescriptor& desc) {
   if (!IsValid()) {
@@ -42,6 +42,12 @@ class CommandBufferMTL final : public CommandBuffer {
   std::shared_ptr<RenderPass> CreateRenderPass(
       RenderTarget target) const override;
 
+  // |CommandBuffer|
+  bool OnCopyBufferToTexture(std::shared_ptr<const DeviceBuffer> source,
+                             Range source_range,
+                             std::shared_ptr<Texture> destination,
+                             IRect region) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(CommandBufferMTL);
 };
 
@@ -4,7 +4,11 @@
 
 #include "impeller/renderer/backend/metal/command_buffer_mtl.h"
 
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/metal/device_buffer_mtl.h"
 #include "impeller/renderer/backend/metal/render_pass_mtl.h"
+#include "impeller/renderer/backend/metal/texture_mtl.h"
+#include "impeller/renderer/formats.h"
 
 namespace impeller {
 
@@ -81,4 +85,42 @@ std::shared_ptr<RenderPass> CommandBufferMTL::CreateRenderPass(
   return pass;
 }
 
+bool CommandBufferMTL::OnCopyBufferToTexture(
+    std::shared_ptr<const DeviceBuffer> source,
+    Range source_range,
+    std::shared_ptr<Texture> destination,
+    IRect region) {
+  if (!buffer_) {
+    return false;
+  }
+
+  auto source_buffer = DeviceBufferMTL::Cast(*source).GetMTLBuffer();
+  if (source_range.offset + source_range.length > source_buffer.length) {
+    VALIDATION_LOG << "Texture copy source is out of bounds of its buffer.";
+    return false;
+  }
+
+  auto encoder = [buffer_ blitCommandEncoder];
+  if (!encoder) {
+    return false;
+  }
+
+  const auto bytes_per_row =
+      region.size.width *
+      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  [encoder copyFromBuffer:source_buffer
+             sourceOffset:source_range.offset
+        sourceBytesPerRow:bytes_per_row
+      sourceBytesPerImage:source_range.length
+               sourceSize:MTLSizeMake(region.size.width, region.size.height, 1)
+                toTexture:TextureMTL::Cast(*destination).GetMTLTexture()
+         destinationSlice:0u
+         destinationLevel:0u
+        destinationOrigin:MTLOriginMake(region.origin.x, region.origin.y, 0)];
+  [encoder endEncoding];
+
+  // The command buffer retains the resources referenced by the blit.
+  return true;
+}
+
 }  // namespace impeller
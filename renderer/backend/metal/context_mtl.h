@@ -10,8 +10,8 @@
 #include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/metal/allocator_mtl.h"
-#include "impeller/renderer/backend/metal/backend_cast.h"
 #include "impeller/renderer/backend/metal/command_buffer_mtl.h"
 #include "impeller/renderer/backend/metal/pipeline_library_mtl.h"
 #include "impeller/renderer/backend/metal/shader_library_mtl.h"
@@ -29,6 +29,17 @@ class ContextMTL final : public Context,
   static std::shared_ptr<Context> Create(
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a context whose shader functions are loaded lazily
+  ///             from memory mapped shader bundles. Only the functions that
+  ///             are used are paged in and turned into Metal libraries.
+  ///
+  /// @param[in]  shader_bundle_paths  The paths of the bundles created by
+  ///                                  `tools/create_shader_bundle.py`.
+  ///
+  static std::shared_ptr<Context> CreateWithShaderBundles(
+      const std::vector<std::string>& shader_bundle_paths);
+
   // |Context|
   ~ContextMTL() override;
 
@@ -45,7 +56,9 @@ class ContextMTL final : public Context,
   std::shared_ptr<AllocatorMTL> transients_allocator_;
   bool is_valid_ = false;
 
-  ContextMTL(id<MTLDevice> device, NSArray<id<MTLLibrary>>* shader_libraries);
+  ContextMTL(id<MTLDevice> device,
+             NSArray<id<MTLLibrary>>* shader_libraries,
+             std::vector<std::shared_ptr<ShaderBundle>> shader_bundles = {});
 
   // |Context|
   bool IsValid() const override;
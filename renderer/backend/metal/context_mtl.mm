@@ -14,8 +14,10 @@
 
 namespace impeller {
 
-ContextMTL::ContextMTL(id<MTLDevice> device,
-                       NSArray<id<MTLLibrary>>* shader_libraries)
+ContextMTL::ContextMTL(
+    id<MTLDevice> device,
+    NSArray<id<MTLLibrary>>* shader_libraries,
+    std::vector<std::shared_ptr<ShaderBundle>> shader_bundles)
     : device_(device) {
   // Validate device.
   if (!device_) {
@@ -31,8 +33,8 @@ ContextMTL::ContextMTL(id<MTLDevice> device,
     }
 
     // std::make_shared disallowed because of private friend ctor.
-    auto library = std::shared_ptr<ShaderLibraryMTL>(
-        new ShaderLibraryMTL(shader_libraries));
+    auto library = std::shared_ptr<ShaderLibraryMTL>(new ShaderLibraryMTL(
+        device_, shader_libraries, std::move(shader_bundles)));
     if (!library->IsValid()) {
       VALIDATION_LOG << "Could not create valid Metal shader library.";
       return;
@@ -170,6 +172,26 @@ std::shared_ptr<Context> ContextMTL::Create(
   return context;
 }
 
+std::shared_ptr<Context> ContextMTL::CreateWithShaderBundles(
+    const std::vector<std::string>& shader_bundle_paths) {
+  std::vector<std::shared_ptr<ShaderBundle>> bundles;
+  for (const auto& bundle_path : shader_bundle_paths) {
+    auto bundle = ShaderBundle::Open(bundle_path);
+    if (!bundle) {
+      return nullptr;
+    }
+    bundles.emplace_back(std::move(bundle));
+  }
+  auto device = CreateMetalDevice();
+  auto context = std::shared_ptr<ContextMTL>(
+      new ContextMTL(device, [NSArray array], std::move(bundles)));
+  if (!context->IsValid()) {
+    FML_LOG(ERROR) << "Could not create Metal context.";
+    return nullptr;
+  }
+  return context;
+}
+
 ContextMTL::~ContextMTL() = default;
 
 bool ContextMTL::IsValid() const {
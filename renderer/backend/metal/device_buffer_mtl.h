@@ -7,7 +7,7 @@
 #include <Metal/Metal.h>
 
 #include "flutter/fml/macros.h"
-#include "impeller/renderer/backend/metal/backend_cast.h"
+#include "impeller/base/backend_cast.h"
 #include "impeller/renderer/device_buffer.h"
 
 namespace impeller {
@@ -54,6 +54,9 @@ class DeviceBufferMTL final
   std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
       Allocator& allocator) const override;
 
+  // |Buffer|
+  const uint8_t* GetHostContents() const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(DeviceBufferMTL);
 };
 
@@ -94,6 +94,13 @@ std::shared_ptr<const DeviceBuffer> DeviceBufferMTL::GetDeviceBuffer(
   return shared_from_this();
 }
 
+const uint8_t* DeviceBufferMTL::GetHostContents() const {
+  if (mode_ != StorageMode::kHostVisible) {
+    return nullptr;
+  }
+  return reinterpret_cast<const uint8_t*>(buffer_.contents);
+}
+
 bool DeviceBufferMTL::SetLabel(const std::string& label) {
   if (label.empty()) {
     return false;
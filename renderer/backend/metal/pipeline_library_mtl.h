@@ -7,6 +7,7 @@
 #include <Metal/Metal.h>
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -32,6 +33,7 @@ class PipelineLibraryMTL final : public PipelineLibrary {
                          ComparableHash<PipelineDescriptor>,
                          ComparableEqual<PipelineDescriptor>>;
   id<MTLDevice> device_ = nullptr;
+  std::mutex pipelines_mutex_;
   Pipelines pipelines_;
 
   PipelineLibraryMTL(id<MTLDevice> device);
@@ -8,6 +8,7 @@
 #include "impeller/renderer/backend/metal/pipeline_mtl.h"
 #include "impeller/renderer/backend/metal/shader_function_mtl.h"
 #include "impeller/renderer/backend/metal/vertex_descriptor_mtl.h"
+#include "impeller/renderer/pipeline_cache.h"
 
 namespace impeller {
 
@@ -67,22 +68,120 @@ static id<MTLDepthStencilState> CreateDepthStencilDescriptor(
   return [device newDepthStencilStateWithDescriptor:descriptor];
 }
 
-PipelineFuture PipelineLibraryMTL::GetRenderPipeline(
-    PipelineDescriptor descriptor) {
-  if (auto found = pipelines_.find(descriptor); found != pipelines_.end()) {
-    return found->second;
+static NSURL* CreateTemporaryBinaryArchiveURL() {
+  auto name = [NSString stringWithFormat:@"impeller_pipeline_%@.metallib",
+                                         NSUUID.UUID.UUIDString];
+  auto path = [NSTemporaryDirectory() stringByAppendingPathComponent:name];
+  return [NSURL fileURLWithPath:path];
+}
+
+static void RemoveTemporaryBinaryArchive(NSURL* url) {
+  if (url != nil) {
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
   }
+}
 
+// Binary archives can only be created from files. The file must outlive the
+// creation of the pipelines that use the archive.
+API_AVAILABLE(macos(11.0), ios(14.0))
+static id<MTLBinaryArchive> LoadBinaryArchive(
+    id<MTLDevice> device,
+    const std::shared_ptr<fml::Mapping>& data,
+    NSURL* url) {
+  if (!data) {
+    return nil;
+  }
+  auto contents =
+      [NSData dataWithBytesNoCopy:const_cast<uint8_t*>(data->GetMapping())
+                           length:data->GetSize()
+                     freeWhenDone:NO];
+  if (![contents writeToURL:url atomically:NO]) {
+    return nil;
+  }
+  auto descriptor = [[MTLBinaryArchiveDescriptor alloc] init];
+  descriptor.url = url;
+  NSError* error = nil;
+  id<MTLBinaryArchive> archive =
+      [device newBinaryArchiveWithDescriptor:descriptor error:&error];
+  if (error != nil) {
+    VALIDATION_LOG << "Could not load cached pipeline: "
+                   << error.localizedDescription.UTF8String;
+    return nil;
+  }
+  return archive;
+}
+
+API_AVAILABLE(macos(11.0), ios(14.0))
+static bool StoreBinaryArchive(id<MTLDevice> device,
+                               MTLRenderPipelineDescriptor* mtl_descriptor,
+                               const PipelineDescriptor& descriptor,
+                               PipelineCache& cache) {
+  NSError* error = nil;
+  id<MTLBinaryArchive> archive = [device
+      newBinaryArchiveWithDescriptor:[[MTLBinaryArchiveDescriptor alloc] init]
+                               error:&error];
+  if (error != nil ||
+      ![archive addRenderPipelineFunctionsWithDescriptor:mtl_descriptor
+                                                   error:&error]) {
+    VALIDATION_LOG << "Could not archive pipeline: "
+                   << error.localizedDescription.UTF8String;
+    return false;
+  }
+  auto url = CreateTemporaryBinaryArchiveURL();
+  if (![archive serializeToURL:url error:&error]) {
+    VALIDATION_LOG << "Could not serialize pipeline archive: "
+                   << error.localizedDescription.UTF8String;
+    return false;
+  }
+  auto contents = [NSData dataWithContentsOfURL:url];
+  RemoveTemporaryBinaryArchive(url);
+  if (contents == nil) {
+    return false;
+  }
+  fml::NonOwnedMapping mapping(static_cast<const uint8_t*>(contents.bytes),
+                               contents.length);
+  return cache.Store(descriptor, mapping);
+}
+
+PipelineFuture PipelineLibraryMTL::GetRenderPipeline(
+    PipelineDescriptor descriptor) {
   auto promise = std::make_shared<std::promise<std::shared_ptr<Pipeline>>>();
   auto future = PipelineFuture{promise->get_future()};
 
-  pipelines_[descriptor] = future;
+  {
+    std::scoped_lock lock(pipelines_mutex_);
+    if (auto found = pipelines_.find(descriptor); found != pipelines_.end()) {
+      return found->second;
+    }
+    pipelines_[descriptor] = future;
+  }
 
   auto weak_this = weak_from_this();
 
+  auto mtl_descriptor = GetMTLRenderPipelineDescriptor(descriptor);
+
+  // Look for the pipeline in archives created by previous launches. Metal
+  // falls back to compiling the pipeline if the archive does not contain it.
+  auto cache = GetPipelineCache();
+  NSURL* archive_url = nil;
+  if (cache) {
+    if (@available(macOS 11.0, iOS 14.0, *)) {
+      archive_url = CreateTemporaryBinaryArchiveURL();
+      if (auto archive = LoadBinaryArchive(device_, cache->Load(descriptor),
+                                           archive_url)) {
+        mtl_descriptor.binaryArchives = @[ archive ];
+      } else {
+        RemoveTemporaryBinaryArchive(archive_url);
+        archive_url = nil;
+      }
+    }
+  }
+
   auto completion_handler =
       ^(id<MTLRenderPipelineState> _Nullable render_pipeline_state,
         NSError* _Nullable error) {
+        RemoveTemporaryBinaryArchive(archive_url);
+
         if (error != nil) {
           VALIDATION_LOG << "Could not create render pipeline: "
                          << error.localizedDescription.UTF8String;
@@ -105,9 +204,21 @@ PipelineFuture PipelineLibraryMTL::GetRenderPipeline(
             CreateDepthStencilDescriptor(descriptor, device_)  //
             ));
         promise->set_value(new_pipeline);
+
+        // Archiving compiles the pipeline again. Keep that off the thread
+        // pipeline creation callbacks are delivered on.
+        if (cache && archive_url == nil) {
+          if (@available(macOS 11.0, iOS 14.0, *)) {
+            auto device = device_;
+            dispatch_async(
+                dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+                  StoreBinaryArchive(device, mtl_descriptor, descriptor,
+                                     *cache);
+                });
+          }
+        }
       };
-  [device_ newRenderPipelineStateWithDescriptor:GetMTLRenderPipelineDescriptor(
-                                                    descriptor)
+  [device_ newRenderPipelineStateWithDescriptor:mtl_descriptor
                               completionHandler:completion_handler];
   return future;
 }
@@ -39,10 +39,10 @@ class RenderPassMTL final : public RenderPass {
   HostBuffer& GetTransientsBuffer() override;
 
   // |RenderPass|
-  bool AddCommand(Command command) override;
+  bool OnAddCommand(Command command) override;
 
   // |RenderPass|
-  bool EncodeCommands(Allocator& transients_allocator) const override;
+  bool OnEncodeCommands(Allocator& transients_allocator) const override;
 
   bool EncodeCommands(Allocator& transients_allocator,
                       id<MTLRenderCommandEncoder> pass) const;
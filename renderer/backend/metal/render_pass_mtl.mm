@@ -156,7 +156,7 @@ void RenderPassMTL::SetLabel(std::string label) {
   transients_buffer_->SetLabel(SPrintF("%s Transients", label_.c_str()));
 }
 
-bool RenderPassMTL::EncodeCommands(Allocator& transients_allocator) const {
+bool RenderPassMTL::OnEncodeCommands(Allocator& transients_allocator) const {
   TRACE_EVENT0("impeller", "RenderPassMTL::EncodeCommands");
   if (!IsValid()) {
     return false;
@@ -212,6 +212,19 @@ struct PassBindingsCache {
     [encoder_ setDepthStencilState:depth_stencil_];
   }
 
+  void SetScissor(const IRect& scissor) {
+    if (scissor_.has_value() && scissor_.value() == scissor) {
+      return;
+    }
+    scissor_ = scissor;
+    MTLScissorRect rect;
+    rect.x = static_cast<NSUInteger>(scissor.origin.x);
+    rect.y = static_cast<NSUInteger>(scissor.origin.y);
+    rect.width = static_cast<NSUInteger>(scissor.size.width);
+    rect.height = static_cast<NSUInteger>(scissor.size.height);
+    [encoder_ setScissorRect:rect];
+  }
+
   bool SetBuffer(ShaderStage stage,
                  uint64_t index,
                  uint64_t offset,
@@ -314,6 +327,7 @@ struct PassBindingsCache {
   const id<MTLRenderCommandEncoder> encoder_;
   id<MTLRenderPipelineState> pipeline_ = nullptr;
   id<MTLDepthStencilState> depth_stencil_ = nullptr;
+  std::optional<IRect> scissor_;
   std::map<ShaderStage, BufferMap> buffers_;
   std::map<ShaderStage, TextureMap> textures_;
   std::map<ShaderStage, SamplerMap> samplers_;
@@ -391,6 +405,8 @@ bool RenderPassMTL::EncodeCommands(Allocator& allocator,
   };
 
   const auto target_sample_count = render_target_.GetSampleCount();
+  const auto target_bounds =
+      IRect::MakeSize(render_target_.GetRenderTargetSize());
 
   fml::closure pop_debug_marker = [encoder]() { [encoder popDebugGroup]; };
   for (const auto& command : commands_) {
@@ -427,6 +443,8 @@ bool RenderPassMTL::EncodeCommands(Allocator& allocator,
                                        : MTLWindingCounterClockwise];
     [encoder setCullMode:MTLCullModeNone];
     [encoder setStencilReferenceValue:command.stencil_reference];
+    // The scissor was clamped to the render target when the command was added.
+    pass_bindings.SetScissor(command.scissor.value_or(target_bounds));
     if (!bind_stage_resources(command.vertex_bindings, ShaderStage::kVertex)) {
       return false;
     }
@@ -462,7 +480,7 @@ bool RenderPassMTL::EncodeCommands(Allocator& allocator,
   return true;
 }
 
-bool RenderPassMTL::AddCommand(Command command) {
+bool RenderPassMTL::OnAddCommand(Command command) {
   if (!command) {
     VALIDATION_LOG << "Attempted to add an invalid command to the render pass.";
     return false;
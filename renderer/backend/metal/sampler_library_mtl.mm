@@ -32,7 +32,8 @@ std::shared_ptr<const Sampler> SamplerLibraryMTL::GetSampler(
   if (!mtl_sampler) {
     return nullptr;
   }
-  auto sampler = std::shared_ptr<SamplerMTL>(new SamplerMTL(mtl_sampler));
+  auto sampler =
+      std::shared_ptr<SamplerMTL>(new SamplerMTL(descriptor, mtl_sampler));
   if (!sampler->IsValid()) {
     return nullptr;
   }
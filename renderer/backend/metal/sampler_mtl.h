@@ -7,7 +7,7 @@
 #include <Metal/Metal.h>
 
 #include "flutter/fml/macros.h"
-#include "impeller/renderer/backend/metal/backend_cast.h"
+#include "impeller/base/backend_cast.h"
 #include "impeller/renderer/sampler.h"
 
 namespace impeller {
@@ -29,7 +29,7 @@ class SamplerMTL final : public Sampler,
 
   id<MTLSamplerState> state_ = nullptr;
 
-  SamplerMTL(id<MTLSamplerState> state);
+  SamplerMTL(SamplerDescriptor desc, id<MTLSamplerState> state);
 
   // |Sampler|
   bool IsValid() const override;
@@ -10,9 +10,11 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/comparable.h"
+#include "impeller/renderer/shader_bundle.h"
 #include "impeller/renderer/shader_library.h"
 
 namespace impeller {
@@ -57,17 +59,26 @@ class ShaderLibraryMTL final : public ShaderLibrary {
                                        ShaderKey::Equal>;
 
   UniqueID library_id_;
+  id<MTLDevice> device_ = nullptr;
   NSArray<id<MTLLibrary>>* libraries_ = nullptr;
   Functions functions_;
   bool is_valid_ = false;
 
-  ShaderLibraryMTL(NSArray<id<MTLLibrary>>* libraries);
+  ShaderLibraryMTL(id<MTLDevice> device,
+                   NSArray<id<MTLLibrary>>* libraries,
+                   std::vector<std::shared_ptr<ShaderBundle>> bundles);
 
   // |ShaderLibrary|
   std::shared_ptr<const ShaderFunction> GetFunction(
       const std::string_view& name,
       ShaderStage stage) override;
 
+  // |ShaderLibrary|
+  std::shared_ptr<const ShaderFunction> OnCreateFunctionFromData(
+      const std::string_view& name,
+      ShaderStage stage,
+      std::shared_ptr<fml::Mapping> data) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ShaderLibraryMTL);
 };
 
@@ -4,13 +4,19 @@
 
 #include "impeller/renderer/backend/metal/shader_library_mtl.h"
 
+#include "impeller/base/validation.h"
 #include "impeller/renderer/backend/metal/shader_function_mtl.h"
 
 namespace impeller {
 
-ShaderLibraryMTL::ShaderLibraryMTL(NSArray<id<MTLLibrary>>* libraries)
-    : libraries_(libraries) {
-  if (libraries_ == nil || libraries_.count == 0) {
+ShaderLibraryMTL::ShaderLibraryMTL(
+    id<MTLDevice> device,
+    NSArray<id<MTLLibrary>>* libraries,
+    std::vector<std::shared_ptr<ShaderBundle>> bundles)
+    : ShaderLibrary(std::move(bundles)),
+      device_(device),
+      libraries_(libraries) {
+  if ((libraries_ == nil || libraries_.count == 0) && !HasBundles()) {
     return;
   }
 
@@ -45,14 +51,59 @@ std::shared_ptr<const ShaderFunction> ShaderLibraryMTL::GetFunction(
     }
   }
 
-  if (function == nil) {
+  std::shared_ptr<const ShaderFunction> func;
+  if (function != nil) {
+    func = std::shared_ptr<ShaderFunctionMTL>(new ShaderFunctionMTL(
+        library_id_, function, {name.data(), name.size()}, stage));
+  } else {
+    func = CreateFunctionFromBundles(name, stage);
+  }
+
+  if (!func) {
     return nullptr;
   }
 
-  auto func = std::shared_ptr<ShaderFunctionMTL>(new ShaderFunctionMTL(
-      library_id_, function, {name.data(), name.size()}, stage));
   functions_[key] = func;
   return func;
 }
 
+// |ShaderLibrary|
+std::shared_ptr<const ShaderFunction>
+ShaderLibraryMTL::OnCreateFunctionFromData(
+    const std::string_view& name,
+    ShaderStage stage,
+    std::shared_ptr<fml::Mapping> data) {
+  // Each function in a bundle is a Metal library of its own. The data refers
+  // to the mapped bundle and is only paged in now.
+  __block auto library_data = data;
+  auto dispatch_data =
+      ::dispatch_data_create(data->GetMapping(),  // buffer
+                             data->GetSize(),     // size
+                             dispatch_get_global_queue(QOS_CLASS_DEFAULT,
+                                                       0),  // queue
+                             ^() {
+                               // We just need a reference.
+                               library_data.reset();
+                             }  // destructor
+      );
+  if (!dispatch_data) {
+    VALIDATION_LOG << "Could not wrap shader bundle data in dispatch data.";
+    return nullptr;
+  }
+
+  NSError* error = nil;
+  auto library = [device_ newLibraryWithData:dispatch_data error:&error];
+  if (!library) {
+    VALIDATION_LOG << "Could not create shader library from bundle: "
+                   << error.localizedDescription.UTF8String;
+    return nullptr;
+  }
+  auto function = [library newFunctionWithName:@(std::string{name}.c_str())];
+  if (function == nil) {
+    return nullptr;
+  }
+  return std::shared_ptr<ShaderFunctionMTL>(new ShaderFunctionMTL(
+      library_id_, function, {name.data(), name.size()}, stage));
+}
+
 }  // namespace impeller
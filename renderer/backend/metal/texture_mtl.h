@@ -7,7 +7,7 @@
 #include <Metal/Metal.h>
 
 #include "flutter/fml/macros.h"
-#include "impeller/renderer/backend/metal/backend_cast.h"
+#include "impeller/base/backend_cast.h"
 #include "impeller/renderer/texture.h"
 
 namespace impeller {
@@ -24,7 +24,7 @@ class TextureMTL final : public Texture,
   void SetLabel(const std::string_view& label) override;
 
   // |Texture|
-  bool SetContents(const uint8_t* contents, size_t length) override;
+  bool GetContents(uint8_t* contents, size_t length) const override;
 
   // |Texture|
   bool IsValid() const override;
@@ -38,6 +38,9 @@ class TextureMTL final : public Texture,
   id<MTLTexture> texture_ = nullptr;
   bool is_valid_ = false;
 
+  // |Texture|
+  bool OnSetContents(const uint8_t* contents, size_t length) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TextureMTL);
 };
 
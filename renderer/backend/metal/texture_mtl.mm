@@ -30,7 +30,7 @@ void TextureMTL::SetLabel(const std::string_view& label) {
   [texture_ setLabel:@(label.data())];
 }
 
-bool TextureMTL::SetContents(const uint8_t* contents, size_t length) {
+bool TextureMTL::OnSetContents(const uint8_t* contents, size_t length) {
   if (!IsValid() || !contents) {
     return false;
   }
@@ -57,6 +57,35 @@ bool TextureMTL::SetContents(const uint8_t* contents, size_t length) {
   return true;
 }
 
+bool TextureMTL::GetContents(uint8_t* contents, size_t length) const {
+  if (!IsValid() || !contents) {
+    return false;
+  }
+
+  const auto& desc = GetTextureDescriptor();
+
+  // Out of bounds access.
+  if (length != desc.GetSizeOfBaseMipLevel()) {
+    return false;
+  }
+
+  // Private textures must be blitted into a host visible resource before they
+  // can be read. That is not supported yet.
+  if (texture_.storageMode == MTLStorageModePrivate) {
+    return false;
+  }
+
+  const auto region =
+      MTLRegionMake2D(0u, 0u, desc.size.width, desc.size.height);
+  [texture_ getBytes:contents                 //
+         bytesPerRow:desc.GetBytesPerRow()  //
+          fromRegion:region                 //
+         mipmapLevel:0u                     //
+  ];
+
+  return true;
+}
+
 ISize TextureMTL::GetSize() const {
   return {static_cast<ISize::Type>(texture_.width),
           static_cast<ISize::Type>(texture_.height)};
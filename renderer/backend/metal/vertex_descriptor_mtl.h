@@ -7,7 +7,7 @@
 #include <set>
 
 #include "flutter/fml/macros.h"
-#include "impeller/renderer/backend/metal/backend_cast.h"
+#include "impeller/base/backend_cast.h"
 #include "impeller/renderer/vertex_descriptor.h"
 
 namespace impeller {
@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/allocator_sw.h"
+
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/software/device_buffer_sw.h"
+#include "impeller/renderer/backend/software/texture_sw.h"
+
+namespace impeller {
+
+AllocatorSW::AllocatorSW(std::string label)
+    : allocator_label_(std::move(label)) {}
+
+AllocatorSW::~AllocatorSW() = default;
+
+std::shared_ptr<DeviceBuffer> AllocatorSW::OnCreateBuffer(StorageMode mode,
+                                                          size_t length) {
+  auto buffer = std::shared_ptr<DeviceBufferSW>(new DeviceBufferSW(length));
+  if (!buffer->IsValid()) {
+    return nullptr;
+  }
+  return buffer;
+}
+
+std::shared_ptr<Texture> AllocatorSW::OnCreateTexture(
+    StorageMode mode,
+    const TextureDescriptor& desc) {
+  if (!desc.IsValid()) {
+    VALIDATION_LOG << "Texture descriptor was invalid.";
+    return nullptr;
+  }
+
+  auto backing = std::shared_ptr<DeviceBufferSW>(
+      new DeviceBufferSW(desc.GetSizeOfBaseMipLevel()));
+  if (!backing->IsValid()) {
+    return nullptr;
+  }
+
+  auto texture = std::make_shared<TextureSW>(desc, std::move(backing), 0u);
+  if (!texture->IsValid()) {
+    return nullptr;
+  }
+  return texture;
+}
+
+}  // namespace impeller
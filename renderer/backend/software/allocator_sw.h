@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/allocator.h"
+
+namespace impeller {
+
+class AllocatorSW final : public Allocator {
+ public:
+  // |Allocator|
+  ~AllocatorSW() override;
+
+ private:
+  friend class ContextSW;
+
+  std::string allocator_label_;
+
+  AllocatorSW(std::string label);
+
+  // |Allocator|
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(StorageMode mode,
+                                               size_t length) override;
+
+  // |Allocator|
+  std::shared_ptr<Texture> OnCreateTexture(
+      StorageMode mode,
+      const TextureDescriptor& desc) override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AllocatorSW);
+};
+
+}  // namespace impeller
@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/command_buffer_sw.h"
+
+#include <cstring>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/software/device_buffer_sw.h"
+#include "impeller/renderer/backend/software/render_pass_sw.h"
+#include "impeller/renderer/backend/software/texture_sw.h"
+#include "impeller/renderer/formats.h"
+
+namespace impeller {
+
+CommandBufferSW::CommandBufferSW(std::shared_ptr<const RasterizerSW> rasterizer)
+    : rasterizer_(std::move(rasterizer)),
+      encoded_passes_(std::make_shared<EncodedPassesSW>()) {
+  if (!rasterizer_) {
+    return;
+  }
+  is_valid_ = true;
+}
+
+CommandBufferSW::~CommandBufferSW() = default;
+
+bool CommandBufferSW::IsValid() const {
+  return is_valid_;
+}
+
+void CommandBufferSW::SetLabel(const std::string& label) const {
+  // Command buffers are executed immediately on submission and there is no
+  // debugger to display labels.
+}
+
+static void PerformCopy(const EncodedCopySW& copy) {
+  const auto& source = DeviceBufferSW::Cast(*copy.source);
+  const auto& destination = TextureSW::Cast(*copy.destination);
+  const auto bytes_per_pixel = BytesPerPixelForPixelFormat(
+      destination.GetTextureDescriptor().format);
+  const auto row_length = copy.region.size.width * bytes_per_pixel;
+  const auto* source_row = source.GetContents() + copy.source_range.offset;
+  auto* destination_row = destination.GetPixels() +
+                          copy.region.origin.y * destination.GetBytesPerRow() +
+                          copy.region.origin.x * bytes_per_pixel;
+  for (int64_t y = 0; y < copy.region.size.height; y++) {
+    ::memmove(destination_row, source_row, row_length);
+    source_row += row_length;
+    destination_row += destination.GetBytesPerRow();
+  }
+}
+
+bool CommandBufferSW::SubmitCommands(CompletionCallback callback) {
+  TRACE_EVENT0("impeller", "CommandBufferSW::SubmitCommands");
+  if (!IsValid() || submitted_) {
+    // Already committed or was never valid. Either way, this is caller error.
+    if (callback) {
+      callback(Status::kError);
+    }
+    return false;
+  }
+  submitted_ = true;
+
+  // Passes and copies are executed in the order in which they were encoded.
+  // There is no asynchronous device so the command buffer has completed by the
+  // time this call returns.
+  auto status = Status::kCompleted;
+  auto copy = encoded_copies_.begin();
+  for (size_t i = 0; i <= encoded_passes_->size(); i++) {
+    for (; copy != encoded_copies_.end() && copy->pass_index == i; ++copy) {
+      PerformCopy(*copy);
+    }
+    if (i == encoded_passes_->size()) {
+      break;
+    }
+    const auto& pass = (*encoded_passes_)[i];
+    if (!rasterizer_->Rasterize(*pass)) {
+      VALIDATION_LOG << "Could not rasterize render pass '" << pass->label
+                     << "'.";
+      status = Status::kError;
+      break;
+    }
+  }
+  encoded_passes_->clear();
+  encoded_copies_.clear();
+
+  if (callback) {
+    callback(status);
+  }
+  return status == Status::kCompleted;
+}
+
+void CommandBufferSW::ReserveSpotInQueue() {
+  // Submissions execute synchronously so the queue position is always the
+  // submission order.
+}
+
+std::shared_ptr<RenderPass> CommandBufferSW::CreateRenderPass(
+    RenderTarget target) const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  auto pass = std::shared_ptr<RenderPassSW>(
+      new RenderPassSW(encoded_passes_, std::move(target)));
+  if (!pass->IsValid()) {
+    return nullptr;
+  }
+
+  return pass;
+}
+
+bool CommandBufferSW::OnCopyBufferToTexture(
+    std::shared_ptr<const DeviceBuffer> source,
+    Range source_range,
+    std::shared_ptr<Texture> destination,
+    IRect region) {
+  if (!IsValid() || submitted_) {
+    return false;
+  }
+
+  if (source_range.offset + source_range.length >
+      DeviceBufferSW::Cast(*source).GetSize()) {
+    VALIDATION_LOG << "Texture copy source is out of bounds of its buffer.";
+    return false;
+  }
+
+  EncodedCopySW copy;
+  copy.pass_index = encoded_passes_->size();
+  copy.source = std::move(source);
+  copy.source_range = source_range;
+  copy.destination = std::move(destination);
+  copy.region = region;
+  encoded_copies_.emplace_back(std::move(copy));
+  return true;
+}
+
+}  // namespace impeller
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/software/rasterizer_sw.h"
+#include "impeller/renderer/command_buffer.h"
+
+namespace impeller {
+
+struct EncodedCopySW {
+  // The number of render passes that were encoded before this copy.
+  size_t pass_index = 0u;
+  std::shared_ptr<const DeviceBuffer> source;
+  Range source_range;
+  std::shared_ptr<Texture> destination;
+  IRect region;
+};
+
+class CommandBufferSW final : public CommandBuffer {
+ public:
+  // |CommandBuffer|
+  ~CommandBufferSW() override;
+
+ private:
+  friend class ContextSW;
+
+  std::shared_ptr<const RasterizerSW> rasterizer_;
+  std::shared_ptr<EncodedPassesSW> encoded_passes_;
+  std::vector<EncodedCopySW> encoded_copies_;
+  bool is_valid_ = false;
+  bool submitted_ = false;
+
+  CommandBufferSW(std::shared_ptr<const RasterizerSW> rasterizer);
+
+  // |CommandBuffer|
+  void SetLabel(const std::string& label) const override;
+
+  // |CommandBuffer|
+  bool IsValid() const override;
+
+  // |CommandBuffer|
+  bool SubmitCommands(CompletionCallback callback) override;
+
+  // |CommandBuffer|
+  void ReserveSpotInQueue() override;
+
+  // |CommandBuffer|
+  std::shared_ptr<RenderPass> CreateRenderPass(
+      RenderTarget target) const override;
+
+  // |CommandBuffer|
+  bool OnCopyBufferToTexture(std::shared_ptr<const DeviceBuffer> source,
+                             Range source_range,
+                             std::shared_ptr<Texture> destination,
+                             IRect region) override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CommandBufferSW);
+};
+
+}  // namespace impeller
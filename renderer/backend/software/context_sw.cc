@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/context_sw.h"
+
+#include "flutter/fml/logging.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/software/command_buffer_sw.h"
+
+namespace impeller {
+
+ContextSW::ContextSW(const std::vector<NativeShaderSW>& shaders,
+                     size_t worker_count) {
+  // Setup the rasterization workers.
+  {
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner;
+    if (worker_count > 0u) {
+      workers_ = fml::ConcurrentMessageLoop::Create(worker_count);
+      task_runner = workers_->GetTaskRunner();
+    }
+    rasterizer_ = std::make_shared<RasterizerSW>(std::move(task_runner));
+  }
+
+  // Setup the shader library.
+  {
+    // std::make_shared disallowed because of private friend ctor.
+    auto library =
+        std::shared_ptr<ShaderLibrarySW>(new ShaderLibrarySW(shaders));
+    if (!library->IsValid()) {
+      VALIDATION_LOG << "Could not create valid software shader library.";
+      return;
+    }
+    shader_library_ = std::move(library);
+  }
+
+  // Setup the pipeline library.
+  {  //
+    pipeline_library_ =
+        std::shared_ptr<PipelineLibrarySW>(new PipelineLibrarySW());
+  }
+
+  // Setup the sampler library.
+  {  //
+    sampler_library_ =
+        std::shared_ptr<SamplerLibrarySW>(new SamplerLibrarySW());
+  }
+
+  {
+    transients_allocator_ = std::shared_ptr<AllocatorSW>(
+        new AllocatorSW("Impeller Transients Allocator"));
+    permanents_allocator_ = std::shared_ptr<AllocatorSW>(
+        new AllocatorSW("Impeller Permanents Allocator"));
+  }
+
+  is_valid_ = true;
+}
+
+std::shared_ptr<Context> ContextSW::Create(
+    const std::vector<NativeShaderSW>& shaders,
+    size_t worker_count) {
+  auto context =
+      std::shared_ptr<ContextSW>(new ContextSW(shaders, worker_count));
+  if (!context->IsValid()) {
+    FML_LOG(ERROR) << "Could not create software context.";
+    return nullptr;
+  }
+  return context;
+}
+
+ContextSW::~ContextSW() = default;
+
+bool ContextSW::IsValid() const {
+  return is_valid_;
+}
+
+std::shared_ptr<ShaderLibrary> ContextSW::GetShaderLibrary() const {
+  return shader_library_;
+}
+
+std::shared_ptr<PipelineLibrary> ContextSW::GetPipelineLibrary() const {
+  return pipeline_library_;
+}
+
+std::shared_ptr<SamplerLibrary> ContextSW::GetSamplerLibrary() const {
+  return sampler_library_;
+}
+
+std::shared_ptr<CommandBuffer> ContextSW::CreateRenderCommandBuffer() const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  auto buffer =
+      std::shared_ptr<CommandBufferSW>(new CommandBufferSW(rasterizer_));
+  if (!buffer->IsValid()) {
+    return nullptr;
+  }
+  return buffer;
+}
+
+std::shared_ptr<CommandBuffer> ContextSW::CreateTransferCommandBuffer() const {
+  // There is no separate transfer queue in host memory.
+  return CreateRenderCommandBuffer();
+}
+
+std::shared_ptr<Allocator> ContextSW::GetPermanentsAllocator() const {
+  return permanents_allocator_;
+}
+
+std::shared_ptr<Allocator> ContextSW::GetTransientsAllocator() const {
+  return transients_allocator_;
+}
+
+}  // namespace impeller
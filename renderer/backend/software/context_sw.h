@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/renderer/backend/software/allocator_sw.h"
+#include "impeller/renderer/backend/software/pipeline_library_sw.h"
+#include "impeller/renderer/backend/software/rasterizer_sw.h"
+#include "impeller/renderer/backend/software/sampler_library_sw.h"
+#include "impeller/renderer/backend/software/shader_library_sw.h"
+#include "impeller/renderer/context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A context that renders into host memory without a GPU. Useful
+///             for golden tests and headless rendering.
+///
+///             There is no offline shader compilation for this backend.
+///             Instead, native implementations of shader functions are
+///             registered with the context using the same entrypoint names
+///             generated by `impellerc`.
+///
+class ContextSW final : public Context,
+                        public BackendCast<ContextSW, Context> {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Create a software context.
+  ///
+  /// @param[in]  shaders       The native shader functions available to
+  ///                           pipelines created with this context.
+  /// @param[in]  worker_count  The number of threads used for rasterization.
+  ///                           If zero, all work happens on the thread that
+  ///                           submits the command buffer.
+  ///
+  static std::shared_ptr<Context> Create(
+      const std::vector<NativeShaderSW>& shaders,
+      size_t worker_count = std::thread::hardware_concurrency());
+
+  // |Context|
+  ~ContextSW() override;
+
+ private:
+  std::shared_ptr<fml::ConcurrentMessageLoop> workers_;
+  std::shared_ptr<RasterizerSW> rasterizer_;
+  std::shared_ptr<ShaderLibrarySW> shader_library_;
+  std::shared_ptr<PipelineLibrarySW> pipeline_library_;
+  std::shared_ptr<SamplerLibrary> sampler_library_;
+  std::shared_ptr<AllocatorSW> permanents_allocator_;
+  std::shared_ptr<AllocatorSW> transients_allocator_;
+  bool is_valid_ = false;
+
+  ContextSW(const std::vector<NativeShaderSW>& shaders, size_t worker_count);
+
+  // |Context|
+  bool IsValid() const override;
+
+  // |Context|
+  std::shared_ptr<Allocator> GetPermanentsAllocator() const override;
+
+  // |Context|
+  std::shared_ptr<Allocator> GetTransientsAllocator() const override;
+
+  // |Context|
+  std::shared_ptr<ShaderLibrary> GetShaderLibrary() const override;
+
+  // |Context|
+  std::shared_ptr<SamplerLibrary> GetSamplerLibrary() const override;
+
+  // |Context|
+  std::shared_ptr<PipelineLibrary> GetPipelineLibrary() const override;
+
+  // |Context|
+  std::shared_ptr<CommandBuffer> CreateRenderCommandBuffer() const override;
+
+  // |Context|
+  std::shared_ptr<CommandBuffer> CreateTransferCommandBuffer() const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ContextSW);
+};
+
+}  // namespace impeller
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/device_buffer_sw.h"
+
+#include <cstring>
+
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/software/texture_sw.h"
+
+namespace impeller {
+
+DeviceBufferSW::DeviceBufferSW(size_t size) {
+  // Allocations are always tightly sized (not rounded up to a power of two) as
+  // they are never resized.
+  if (!allocation_.Truncate(size, false /* npot */)) {
+    return;
+  }
+  if (size > 0u) {
+    ::memset(allocation_.GetBuffer(), 0, size);
+  }
+  is_valid_ = true;
+}
+
+DeviceBufferSW::~DeviceBufferSW() = default;
+
+bool DeviceBufferSW::IsValid() const {
+  return is_valid_;
+}
+
+uint8_t* DeviceBufferSW::GetContents() const {
+  return allocation_.GetBuffer();
+}
+
+size_t DeviceBufferSW::GetSize() const {
+  return allocation_.GetLength();
+}
+
+bool DeviceBufferSW::CopyHostBuffer(const uint8_t* source,
+                                    Range source_range,
+                                    size_t offset) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  if (offset + source_range.length > GetSize()) {
+    // Out of bounds of this buffer.
+    return false;
+  }
+
+  if (source) {
+    ::memmove(GetContents() + offset, source + source_range.offset,
+              source_range.length);
+  }
+
+  return true;
+}
+
+std::shared_ptr<Texture> DeviceBufferSW::MakeTexture(TextureDescriptor desc,
+                                                     size_t offset) const {
+  if (!desc.IsValid() || !IsValid()) {
+    return nullptr;
+  }
+
+  // Avoid overruns.
+  if (offset + desc.GetSizeOfBaseMipLevel() > GetSize()) {
+    VALIDATION_LOG << "Avoiding buffer overrun when creating texture.";
+    return nullptr;
+  }
+
+  auto texture = std::make_shared<TextureSW>(
+      desc,
+      std::static_pointer_cast<const DeviceBufferSW>(shared_from_this()),
+      offset);
+  if (!texture->IsValid()) {
+    return nullptr;
+  }
+  return texture;
+}
+
+// |Buffer|
+std::shared_ptr<const DeviceBuffer> DeviceBufferSW::GetDeviceBuffer(
+    Allocator& allocator) const {
+  return shared_from_this();
+}
+
+const uint8_t* DeviceBufferSW::GetHostContents() const {
+  return GetContents();
+}
+
+bool DeviceBufferSW::SetLabel(const std::string& label) {
+  if (label.empty()) {
+    return false;
+  }
+  label_ = label;
+  return true;
+}
+
+bool DeviceBufferSW::SetLabel(const std::string& label, Range range) {
+  // There are no debug markers in host memory.
+  return !label.empty();
+}
+
+BufferView DeviceBufferSW::AsBufferView() const {
+  BufferView view;
+  view.buffer = shared_from_this();
+  view.range = {0u, GetSize()};
+  return view;
+}
+
+}  // namespace impeller
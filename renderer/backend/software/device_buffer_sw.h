@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/allocation.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/renderer/device_buffer.h"
+
+namespace impeller {
+
+class DeviceBufferSW final : public DeviceBuffer,
+                             public BackendCast<DeviceBufferSW, DeviceBuffer> {
+ public:
+  // |DeviceBuffer|
+  ~DeviceBufferSW() override;
+
+  uint8_t* GetContents() const;
+
+  size_t GetSize() const;
+
+ private:
+  friend class AllocatorSW;
+
+  // Host memory is the device memory for the software backend. All storage
+  // modes are backed by the same kind of allocation.
+  Allocation allocation_;
+  std::string label_;
+  bool is_valid_ = false;
+
+  DeviceBufferSW(size_t size);
+
+  bool IsValid() const;
+
+  // |DeviceBuffer|
+  bool CopyHostBuffer(const uint8_t* source,
+                      Range source_range,
+                      size_t offset) override;
+
+  // |DeviceBuffer|
+  std::shared_ptr<Texture> MakeTexture(TextureDescriptor desc,
+                                       size_t offset) const override;
+
+  // |DeviceBuffer|
+  bool SetLabel(const std::string& label) override;
+
+  // |DeviceBuffer|
+  bool SetLabel(const std::string& label, Range range) override;
+
+  // |DeviceBuffer|
+  BufferView AsBufferView() const override;
+
+  // |Buffer|
+  std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
+      Allocator& allocator) const override;
+
+  // |Buffer|
+  const uint8_t* GetHostContents() const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DeviceBufferSW);
+};
+
+}  // namespace impeller
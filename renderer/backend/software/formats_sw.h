@@ -0,0 +1,224 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/color.h"
+#include "impeller/renderer/formats.h"
+
+namespace impeller {
+
+constexpr uint8_t ToUNorm8(Scalar component) {
+  return static_cast<uint8_t>(
+      std::clamp<Scalar>(component, 0.0, 1.0) * 255.0f + 0.5f);
+}
+
+constexpr Scalar FromUNorm8(uint8_t component) {
+  return static_cast<Scalar>(component) / 255.0f;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Read a single pixel of the given format from host memory. Only
+///             the 32-bit color formats are supported. The sRGB variants are
+///             treated as linear.
+///
+constexpr Color ReadPixelSW(PixelFormat format, const uint8_t* pixel) {
+  switch (format) {
+    case PixelFormat::kR8G8B8A8UNormInt:
+    case PixelFormat::kR8G8B8A8UNormIntSRGB:
+      return {FromUNorm8(pixel[0]), FromUNorm8(pixel[1]),
+              FromUNorm8(pixel[2]), FromUNorm8(pixel[3])};
+    case PixelFormat::kB8G8R8A8UNormInt:
+    case PixelFormat::kB8G8R8A8UNormIntSRGB:
+      return {FromUNorm8(pixel[2]), FromUNorm8(pixel[1]),
+              FromUNorm8(pixel[0]), FromUNorm8(pixel[3])};
+    case PixelFormat::kUnknown:
+    case PixelFormat::kS8UInt:
+      return {};
+  }
+  return {};
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Write a single pixel of the given format into host memory. Only
+///             components selected in the color write mask are written.
+///
+constexpr void WritePixelSW(PixelFormat format,
+                            uint8_t* pixel,
+                            const Color& color,
+                            uint64_t write_mask) {
+  size_t r = 0u, g = 1u, b = 2u, a = 3u;
+  switch (format) {
+    case PixelFormat::kR8G8B8A8UNormInt:
+    case PixelFormat::kR8G8B8A8UNormIntSRGB:
+      break;
+    case PixelFormat::kB8G8R8A8UNormInt:
+    case PixelFormat::kB8G8R8A8UNormIntSRGB:
+      r = 2u;
+      b = 0u;
+      break;
+    case PixelFormat::kUnknown:
+    case PixelFormat::kS8UInt:
+      return;
+  }
+  if (write_mask & static_cast<uint64_t>(ColorWriteMask::kRed)) {
+    pixel[r] = ToUNorm8(color.red);
+  }
+  if (write_mask & static_cast<uint64_t>(ColorWriteMask::kGreen)) {
+    pixel[g] = ToUNorm8(color.green);
+  }
+  if (write_mask & static_cast<uint64_t>(ColorWriteMask::kBlue)) {
+    pixel[b] = ToUNorm8(color.blue);
+  }
+  if (write_mask & static_cast<uint64_t>(ColorWriteMask::kAlpha)) {
+    pixel[a] = ToUNorm8(color.alpha);
+  }
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The per-component multiplier for a blend factor. Constant blend
+///             colors cannot be specified in Impeller yet and are treated as
+///             transparent black (the Metal default).
+///
+constexpr Color BlendFactorSW(BlendFactor factor,
+                              const Color& src,
+                              const Color& dst) {
+  switch (factor) {
+    case BlendFactor::kZero:
+    case BlendFactor::kBlendColor:
+    case BlendFactor::kBlendAlpha:
+      return {0.0, 0.0, 0.0, 0.0};
+    case BlendFactor::kOne:
+    case BlendFactor::kOneMinusBlendColor:
+    case BlendFactor::kOneMinusBlendAlpha:
+      return {1.0, 1.0, 1.0, 1.0};
+    case BlendFactor::kSourceColor:
+      return src;
+    case BlendFactor::kOneMinusSourceColor:
+      return {1.0f - src.red, 1.0f - src.green, 1.0f - src.blue,
+              1.0f - src.alpha};
+    case BlendFactor::kSourceAlpha:
+      return {src.alpha, src.alpha, src.alpha, src.alpha};
+    case BlendFactor::kOneMinusSourceAlpha:
+      return {1.0f - src.alpha, 1.0f - src.alpha, 1.0f - src.alpha,
+              1.0f - src.alpha};
+    case BlendFactor::kDestinationColor:
+      return dst;
+    case BlendFactor::kOneMinusDestinationColor:
+      return {1.0f - dst.red, 1.0f - dst.green, 1.0f - dst.blue,
+              1.0f - dst.alpha};
+    case BlendFactor::kDestinationAlpha:
+      return {dst.alpha, dst.alpha, dst.alpha, dst.alpha};
+    case BlendFactor::kOneMinusDestinationAlpha:
+      return {1.0f - dst.alpha, 1.0f - dst.alpha, 1.0f - dst.alpha,
+              1.0f - dst.alpha};
+    case BlendFactor::kSourceAlphaSaturated: {
+      const auto f = std::min<Scalar>(src.alpha, 1.0f - dst.alpha);
+      return {f, f, f, 1.0};
+    }
+  }
+  return {};
+}
+
+constexpr Scalar BlendOperationSW(BlendOperation op, Scalar src, Scalar dst) {
+  switch (op) {
+    case BlendOperation::kAdd:
+      return src + dst;
+    case BlendOperation::kSubtract:
+      return src - dst;
+    case BlendOperation::kReverseSubtract:
+      return dst - src;
+    case BlendOperation::kMin:
+      return std::min(src, dst);
+    case BlendOperation::kMax:
+      return std::max(src, dst);
+  }
+  return src;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Blend a new fragment color with the color already in the
+///             attachment as described by the attachment descriptor.
+///
+/// @see        `ColorAttachmentDescriptor`
+///
+constexpr Color BlendSW(const ColorAttachmentDescriptor& desc,
+                        const Color& src,
+                        const Color& dst) {
+  if (!desc.blending_enabled) {
+    return src;
+  }
+  const auto sc = BlendFactorSW(desc.src_color_blend_factor, src, dst);
+  const auto dc = BlendFactorSW(desc.dst_color_blend_factor, src, dst);
+  const auto sa = BlendFactorSW(desc.src_alpha_blend_factor, src, dst);
+  const auto da = BlendFactorSW(desc.dst_alpha_blend_factor, src, dst);
+  return {
+      BlendOperationSW(desc.color_blend_op, src.red * sc.red, dst.red * dc.red),
+      BlendOperationSW(desc.color_blend_op, src.green * sc.green,
+                       dst.green * dc.green),
+      BlendOperationSW(desc.color_blend_op, src.blue * sc.blue,
+                       dst.blue * dc.blue),
+      BlendOperationSW(desc.alpha_blend_op, src.alpha * sa.alpha,
+                       dst.alpha * da.alpha),
+  };
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Performs the stencil comparison. The reference value is the
+///             left hand operand as documented on `CompareFunction`.
+///
+constexpr bool StencilCompareSW(CompareFunction compare,
+                                uint32_t reference,
+                                uint32_t current) {
+  switch (compare) {
+    case CompareFunction::kNever:
+      return false;
+    case CompareFunction::kAlways:
+      return true;
+    case CompareFunction::kLess:
+      return reference < current;
+    case CompareFunction::kEqual:
+      return reference == current;
+    case CompareFunction::kLessEqual:
+      return reference <= current;
+    case CompareFunction::kGreater:
+      return reference > current;
+    case CompareFunction::kNotEqual:
+      return reference != current;
+    case CompareFunction::kGreaterEqual:
+      return reference >= current;
+  }
+  return true;
+}
+
+constexpr uint8_t StencilOperationSW(StencilOperation op,
+                                     uint8_t reference,
+                                     uint8_t current) {
+  switch (op) {
+    case StencilOperation::kKeep:
+      return current;
+    case StencilOperation::kZero:
+      return 0u;
+    case StencilOperation::kSetToReferenceValue:
+      return reference;
+    case StencilOperation::kIncrementClamp:
+      return current == 0xFF ? current : static_cast<uint8_t>(current + 1u);
+    case StencilOperation::kDecrementClamp:
+      return current == 0u ? current : static_cast<uint8_t>(current - 1u);
+    case StencilOperation::kInvert:
+      return static_cast<uint8_t>(~current);
+    case StencilOperation::kIncrementWrap:
+      return static_cast<uint8_t>(current + 1u);
+    case StencilOperation::kDecrementWrap:
+      return static_cast<uint8_t>(current - 1u);
+  }
+  return current;
+}
+
+}  // namespace impeller
@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/pipeline_library_sw.h"
+
+#include "impeller/base/base.h"
+#include "impeller/renderer/backend/software/pipeline_sw.h"
+
+namespace impeller {
+
+PipelineLibrarySW::PipelineLibrarySW() = default;
+
+PipelineLibrarySW::~PipelineLibrarySW() = default;
+
+PipelineFuture PipelineLibrarySW::GetRenderPipeline(
+    PipelineDescriptor descriptor) {
+  std::scoped_lock lock(pipelines_mutex_);
+  if (auto found = pipelines_.find(descriptor); found != pipelines_.end()) {
+    return found->second;
+  }
+
+  // There is nothing to compile. Native shaders are resolved when the
+  // pipeline is created so the future is always realized.
+  auto pipeline = std::shared_ptr<PipelineSW>(
+      new PipelineSW(weak_from_this(), descriptor));
+  if (!pipeline->IsValid()) {
+    pipeline = nullptr;
+  }
+
+  auto future = PipelineFuture{
+      RealizedFuture<std::shared_ptr<Pipeline>>(std::move(pipeline))};
+  pipelines_[descriptor] = future;
+  return future;
+}
+
+}  // namespace impeller
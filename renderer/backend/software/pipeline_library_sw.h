@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/pipeline_library.h"
+
+namespace impeller {
+
+class ContextSW;
+
+class PipelineLibrarySW final : public PipelineLibrary {
+ public:
+  // |PipelineLibrary|
+  ~PipelineLibrarySW() override;
+
+ private:
+  friend ContextSW;
+
+  using Pipelines =
+      std::unordered_map<PipelineDescriptor,
+                         std::shared_future<std::shared_ptr<Pipeline>>,
+                         ComparableHash<PipelineDescriptor>,
+                         ComparableEqual<PipelineDescriptor>>;
+  std::mutex pipelines_mutex_;
+  Pipelines pipelines_;
+
+  PipelineLibrarySW();
+
+  // |PipelineLibrary|
+  PipelineFuture GetRenderPipeline(PipelineDescriptor descriptor) override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineLibrarySW);
+};
+
+}  // namespace impeller
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/pipeline_sw.h"
+
+#include "impeller/base/validation.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+PipelineSW::PipelineSW(std::weak_ptr<PipelineLibrary> library,
+                       PipelineDescriptor p_desc)
+    : Pipeline(std::move(library), std::move(p_desc)) {
+  const auto& desc = GetDescriptor();
+
+  for (const auto& entry : desc.GetStageEntrypoints()) {
+    if (!entry.second) {
+      continue;
+    }
+    const auto& function = ShaderFunctionSW::Cast(*entry.second);
+    if (entry.first == ShaderStage::kVertex) {
+      vertex_proc_ = function.GetVertexProc();
+      varying_count_ = function.GetVaryingCount();
+    }
+    if (entry.first == ShaderStage::kFragment) {
+      fragment_proc_ = function.GetFragmentProc();
+    }
+  }
+
+  if (!vertex_proc_ || !fragment_proc_) {
+    VALIDATION_LOG << "Pipeline '" << desc.GetLabel()
+                   << "' does not have native vertex and fragment functions.";
+    return;
+  }
+
+  if (const auto& vertex_desc = desc.GetVertexDescriptor()) {
+    vertex_stride_ = vertex_desc->GetStride();
+  }
+
+  // The software backend only renders into the first color attachment.
+  if (const auto* color0 = desc.GetColorAttachmentDescriptor(0u)) {
+    color0_ = *color0;
+  }
+  front_stencil_ = desc.GetFrontStencilAttachmentDescriptor();
+  back_stencil_ = desc.GetBackStencilAttachmentDescriptor();
+
+  is_valid_ = true;
+}
+
+PipelineSW::~PipelineSW() = default;
+
+bool PipelineSW::IsValid() const {
+  return is_valid_;
+}
+
+VertexShaderProcSW PipelineSW::GetVertexProc() const {
+  return vertex_proc_;
+}
+
+FragmentShaderProcSW PipelineSW::GetFragmentProc() const {
+  return fragment_proc_;
+}
+
+size_t PipelineSW::GetVaryingCount() const {
+  return varying_count_;
+}
+
+size_t PipelineSW::GetVertexStride() const {
+  return vertex_stride_;
+}
+
+const ColorAttachmentDescriptor& PipelineSW::GetColorAttachmentDescriptor()
+    const {
+  return color0_;
+}
+
+const std::optional<StencilAttachmentDescriptor>&
+PipelineSW::GetFrontStencilAttachmentDescriptor() const {
+  return front_stencil_;
+}
+
+const std::optional<StencilAttachmentDescriptor>&
+PipelineSW::GetBackStencilAttachmentDescriptor() const {
+  return back_stencil_;
+}
+
+}  // namespace impeller
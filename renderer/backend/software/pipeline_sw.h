@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/renderer/backend/software/shader_function_sw.h"
+#include "impeller/renderer/pipeline.h"
+
+namespace impeller {
+
+class PipelineSW final : public Pipeline,
+                         public BackendCast<PipelineSW, Pipeline> {
+ public:
+  // |Pipeline|
+  ~PipelineSW() override;
+
+  VertexShaderProcSW GetVertexProc() const;
+
+  FragmentShaderProcSW GetFragmentProc() const;
+
+  size_t GetVaryingCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The size of one vertex in the vertex buffer. The stage inputs
+  ///             are interleaved and tightly packed. Zero if the vertex
+  ///             function has no stage inputs.
+  ///
+  size_t GetVertexStride() const;
+
+  const ColorAttachmentDescriptor& GetColorAttachmentDescriptor() const;
+
+  const std::optional<StencilAttachmentDescriptor>&
+  GetFrontStencilAttachmentDescriptor() const;
+
+  const std::optional<StencilAttachmentDescriptor>&
+  GetBackStencilAttachmentDescriptor() const;
+
+ private:
+  friend class PipelineLibrarySW;
+
+  VertexShaderProcSW vertex_proc_ = nullptr;
+  FragmentShaderProcSW fragment_proc_ = nullptr;
+  size_t varying_count_ = 0u;
+  size_t vertex_stride_ = 0u;
+  ColorAttachmentDescriptor color0_;
+  std::optional<StencilAttachmentDescriptor> front_stencil_;
+  std::optional<StencilAttachmentDescriptor> back_stencil_;
+  bool is_valid_ = false;
+
+  PipelineSW(std::weak_ptr<PipelineLibrary> library, PipelineDescriptor desc);
+
+  // |Pipeline|
+  bool IsValid() const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineSW);
+};
+
+}  // namespace impeller
@@ -0,0 +1,482 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/rasterizer_sw.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/software/formats_sw.h"
+#include "impeller/renderer/backend/software/pipeline_sw.h"
+#include "impeller/renderer/backend/software/texture_sw.h"
+
+namespace impeller {
+
+namespace {
+
+struct ShadedVertex {
+  Point position;
+  VaryingsSW varyings;
+};
+
+struct Triangle {
+  const DrawSW* draw = nullptr;
+  const PipelineSW* pipeline = nullptr;
+  const StencilAttachmentDescriptor* stencil = nullptr;
+  // Ordered such that the signed area in framebuffer coordinates is positive.
+  std::array<const ShadedVertex*, 3> vertices = {};
+  Scalar area = 0.0;
+  int64_t min_x = 0;
+  int64_t min_y = 0;
+  int64_t max_x = 0;
+  int64_t max_y = 0;
+};
+
+struct Tile {
+  int64_t min_x = 0;
+  int64_t min_y = 0;
+  int64_t max_x = 0;
+  int64_t max_y = 0;
+  std::vector<const Triangle*> triangles;
+};
+
+struct Attachments {
+  TextureSW* color = nullptr;
+  const ColorAttachment* color_desc = nullptr;
+  TextureSW* resolve = nullptr;
+  TextureSW* stencil = nullptr;
+  const StencilAttachment* stencil_desc = nullptr;
+};
+
+}  // namespace
+
+// Positive for points to the right of the directed edge a -> b in framebuffer
+// coordinates (where Y points down).
+static constexpr Scalar EdgeFunction(Point a, Point b, Point p) {
+  return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+}
+
+// Pixels whose centers lie exactly on an edge are only covered by the
+// triangle for which the edge is a top or left edge. This makes sure that
+// pixels on edges shared by adjacent triangles are covered exactly once.
+static constexpr bool IsTopLeftEdge(Point a, Point b) {
+  const auto dx = b.x - a.x;
+  const auto dy = b.y - a.y;
+  return dy < 0.0 || (dy == 0.0 && dx > 0.0);
+}
+
+static std::optional<Attachments> ResolveAttachments(
+    const RenderTarget& target) {
+  Attachments attachments;
+
+  const auto& colors = target.GetColorAttachments();
+  auto color0 = colors.find(0u);
+  if (color0 == colors.end() || !color0->second.texture) {
+    VALIDATION_LOG << "The software backend requires a color attachment at "
+                      "index zero.";
+    return std::nullopt;
+  }
+  if (colors.size() > 1u) {
+    VALIDATION_LOG << "The software backend only renders to the first color "
+                      "attachment.";
+  }
+  attachments.color = &TextureSW::Cast(*color0->second.texture);
+  attachments.color_desc = &color0->second;
+  if (BytesPerPixelForPixelFormat(
+          attachments.color->GetTextureDescriptor().format) != 4u) {
+    VALIDATION_LOG << "Unsupported color attachment format.";
+    return std::nullopt;
+  }
+
+  const auto size = attachments.color->GetSize();
+
+  if (color0->second.store_action == StoreAction::kMultisampleResolve &&
+      color0->second.resolve_texture) {
+    attachments.resolve = &TextureSW::Cast(*color0->second.resolve_texture);
+    const auto& resolve_desc = attachments.resolve->GetTextureDescriptor();
+    if (resolve_desc.size != size ||
+        resolve_desc.format !=
+            attachments.color->GetTextureDescriptor().format) {
+      VALIDATION_LOG << "The resolve texture must match the size and format "
+                        "of the color attachment.";
+      return std::nullopt;
+    }
+  }
+
+  if (const auto& stencil = target.GetStencilAttachment();
+      stencil.has_value() && stencil->texture) {
+    attachments.stencil = &TextureSW::Cast(*stencil->texture);
+    attachments.stencil_desc = &stencil.value();
+    const auto& stencil_desc = attachments.stencil->GetTextureDescriptor();
+    if (stencil_desc.format != PixelFormat::kS8UInt ||
+        stencil_desc.size != size) {
+      VALIDATION_LOG << "The stencil attachment must be an 8-bit stencil "
+                        "texture the size of the color attachment.";
+      return std::nullopt;
+    }
+  }
+
+  return attachments;
+}
+
+RasterizerSW::RasterizerSW(std::shared_ptr<fml::ConcurrentTaskRunner> workers)
+    : workers_(std::move(workers)) {}
+
+RasterizerSW::~RasterizerSW() = default;
+
+void RasterizerSW::ParallelFor(size_t count,
+                               const std::function<void(size_t)>& task) const {
+  if (!workers_ || count <= 1u) {
+    for (size_t i = 0; i < count; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  fml::CountDownLatch latch(count);
+  for (size_t i = 0; i < count; i++) {
+    workers_->PostTask([&task, &latch, i]() {
+      task(i);
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+}
+
+static bool ShadeVertices(const DrawSW& draw,
+                          const PipelineSW& pipeline,
+                          ISize size,
+                          std::vector<ShadedVertex>& vertices,
+                          std::vector<bool>& visible) {
+  uint32_t max_index = 0u;
+  for (size_t i = 0; i < draw.index_count; i++) {
+    max_index = std::max(max_index, draw.indices[i]);
+  }
+
+  if (draw.vertex_count.has_value() && max_index >= draw.vertex_count.value()) {
+    VALIDATION_LOG << "Draw '" << draw.label << "' references vertex "
+                   << max_index << " but only " << draw.vertex_count.value()
+                   << " vertices are bound. Skipping the draw.";
+    return false;
+  }
+
+  vertices.resize(max_index + 1u);
+  visible.resize(max_index + 1u);
+
+  const auto half_width = size.width * 0.5f;
+  const auto half_height = size.height * 0.5f;
+  const auto vertex_proc = pipeline.GetVertexProc();
+
+  for (size_t i = 0; i <= max_index; i++) {
+    auto& vertex = vertices[i];
+    const auto clip = vertex_proc(draw.vertex_bindings, i, vertex.varyings);
+    visible[i] = clip.w > 0.0f;
+    if (!visible[i]) {
+      continue;
+    }
+    // NDC to framebuffer coordinates. The Y axis of NDC points up.
+    vertex.position = {(clip.x / clip.w + 1.0f) * half_width,
+                       (1.0f - clip.y / clip.w) * half_height};
+  }
+  return true;
+}
+
+static void AssembleTriangles(const DrawSW& draw,
+                              const PipelineSW& pipeline,
+                              ISize size,
+                              const std::vector<ShadedVertex>& vertices,
+                              const std::vector<bool>& visible,
+                              std::vector<Triangle>& triangles) {
+  const auto& front_stencil = pipeline.GetFrontStencilAttachmentDescriptor();
+  const auto& back_stencil = pipeline.GetBackStencilAttachmentDescriptor();
+
+  // Pixels outside the scissor are never touched. The render pass has already
+  // clamped the scissor to the render target.
+  const auto bounds = draw.scissor.value_or(IRect::MakeSize(size)).GetLTRB();
+  const auto bounds_min_x = bounds[0];
+  const auto bounds_min_y = bounds[1];
+  const auto bounds_max_x = bounds[2] - 1;
+  const auto bounds_max_y = bounds[3] - 1;
+
+  auto assemble = [&](uint32_t i0, uint32_t i1, uint32_t i2, bool flipped) {
+    if (!visible[i0] || !visible[i1] || !visible[i2]) {
+      return;
+    }
+    Triangle triangle;
+    triangle.draw = &draw;
+    triangle.pipeline = &pipeline;
+    triangle.vertices = {&vertices[i0], &vertices[i1], &vertices[i2]};
+    const auto& a = triangle.vertices[0]->position;
+    const auto& b = triangle.vertices[1]->position;
+    const auto& c = triangle.vertices[2]->position;
+    triangle.area = EdgeFunction(a, b, c);
+    if (triangle.area == 0.0f || !std::isfinite(triangle.area)) {
+      return;
+    }
+
+    // A positive area in framebuffer coordinates (Y down) is a clockwise
+    // triangle on screen.
+    const auto clockwise = (triangle.area > 0.0f) != flipped;
+    const auto front_facing =
+        clockwise == (draw.winding == WindingOrder::kClockwise);
+    const auto& stencil = front_facing ? front_stencil : back_stencil;
+    triangle.stencil = stencil.has_value() ? &stencil.value() : nullptr;
+
+    if (triangle.area < 0.0f) {
+      std::swap(triangle.vertices[1], triangle.vertices[2]);
+      triangle.area = -triangle.area;
+    }
+
+    triangle.min_x = std::max<int64_t>(
+        bounds_min_x,
+        static_cast<int64_t>(std::floor(std::min({a.x, b.x, c.x}) - 0.5f)));
+    triangle.min_y = std::max<int64_t>(
+        bounds_min_y,
+        static_cast<int64_t>(std::floor(std::min({a.y, b.y, c.y}) - 0.5f)));
+    triangle.max_x = std::min<int64_t>(
+        bounds_max_x,
+        static_cast<int64_t>(std::ceil(std::max({a.x, b.x, c.x}) - 0.5f)));
+    triangle.max_y = std::min<int64_t>(
+        bounds_max_y,
+        static_cast<int64_t>(std::ceil(std::max({a.y, b.y, c.y}) - 0.5f)));
+    if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+      return;
+    }
+    triangles.push_back(triangle);
+  };
+
+  switch (draw.primitive_type) {
+    case PrimitiveType::kTriangle:
+      for (size_t i = 0; i + 2 < draw.index_count; i += 3) {
+        assemble(draw.indices[i], draw.indices[i + 1], draw.indices[i + 2],
+                 false);
+      }
+      return;
+    case PrimitiveType::kTriangleStrip:
+      // Every other triangle in a strip has its winding reversed.
+      for (size_t i = 0; i + 2 < draw.index_count; i++) {
+        assemble(draw.indices[i], draw.indices[i + 1], draw.indices[i + 2],
+                 i % 2 == 1);
+      }
+      return;
+    case PrimitiveType::kLine:
+    case PrimitiveType::kLineStrip:
+    case PrimitiveType::kPoint:
+      VALIDATION_LOG << "The software backend can only rasterize triangles.";
+      return;
+  }
+}
+
+static void ClearTile(const Tile& tile, const Attachments& attachments) {
+  if (attachments.color_desc->load_action == LoadAction::kClear) {
+    const auto& desc = attachments.color->GetTextureDescriptor();
+    const auto bytes_per_row = attachments.color->GetBytesPerRow();
+    std::array<uint8_t, 4> clear = {};
+    WritePixelSW(desc.format, clear.data(),
+                 attachments.color_desc->clear_color,
+                 static_cast<uint64_t>(ColorWriteMask::kAll));
+    for (auto y = tile.min_y; y <= tile.max_y; y++) {
+      auto row = attachments.color->GetPixels() + y * bytes_per_row;
+      for (auto x = tile.min_x; x <= tile.max_x; x++) {
+        ::memcpy(row + x * 4u, clear.data(), clear.size());
+      }
+    }
+  }
+
+  if (attachments.stencil &&
+      attachments.stencil_desc->load_action == LoadAction::kClear) {
+    const auto stride = attachments.stencil->GetBytesPerRow();
+    for (auto y = tile.min_y; y <= tile.max_y; y++) {
+      ::memset(attachments.stencil->GetPixels() + y * stride + tile.min_x,
+               static_cast<uint8_t>(attachments.stencil_desc->clear_stencil),
+               tile.max_x - tile.min_x + 1);
+    }
+  }
+}
+
+static void RasterizeTriangle(const Tile& tile,
+                              const Triangle& triangle,
+                              const Attachments& attachments) {
+  const auto& draw = *triangle.draw;
+  const auto& pipeline = *triangle.pipeline;
+  const auto& color_desc = pipeline.GetColorAttachmentDescriptor();
+  const auto format = attachments.color->GetTextureDescriptor().format;
+  const auto color_stride = attachments.color->GetBytesPerRow();
+  const auto fragment_proc = pipeline.GetFragmentProc();
+  const auto varying_count = pipeline.GetVaryingCount();
+  const auto write_mask = color_desc.write_mask;
+
+  const auto* stencil = attachments.stencil ? triangle.stencil : nullptr;
+  const auto stencil_stride =
+      attachments.stencil ? attachments.stencil->GetBytesPerRow() : 0u;
+  const auto reference = static_cast<uint8_t>(draw.stencil_reference);
+
+  const auto& v0 = *triangle.vertices[0];
+  const auto& v1 = *triangle.vertices[1];
+  const auto& v2 = *triangle.vertices[2];
+  const auto p0 = v0.position;
+  const auto p1 = v1.position;
+  const auto p2 = v2.position;
+  const bool top_left_12 = IsTopLeftEdge(p1, p2);
+  const bool top_left_20 = IsTopLeftEdge(p2, p0);
+  const bool top_left_01 = IsTopLeftEdge(p0, p1);
+  const auto inverse_area = 1.0f / triangle.area;
+
+  const auto min_x = std::max(tile.min_x, triangle.min_x);
+  const auto min_y = std::max(tile.min_y, triangle.min_y);
+  const auto max_x = std::min(tile.max_x, triangle.max_x);
+  const auto max_y = std::min(tile.max_y, triangle.max_y);
+
+  // The edge functions are linear. Step them across the span instead of
+  // evaluating them at each pixel.
+  const auto step_12 = -(p2.y - p1.y);
+  const auto step_20 = -(p0.y - p2.y);
+  const auto step_01 = -(p1.y - p0.y);
+
+  VaryingsSW varyings;
+  for (auto y = min_y; y <= max_y; y++) {
+    const Point start = {min_x + 0.5f, y + 0.5f};
+    auto w0 = EdgeFunction(p1, p2, start);
+    auto w1 = EdgeFunction(p2, p0, start);
+    auto w2 = EdgeFunction(p0, p1, start);
+    auto color_row = attachments.color->GetPixels() + y * color_stride;
+    auto stencil_row =
+        stencil ? attachments.stencil->GetPixels() + y * stencil_stride
+                : nullptr;
+    for (auto x = min_x; x <= max_x;
+         x++, w0 += step_12, w1 += step_20, w2 += step_01) {
+      if ((w0 < 0.0f || (w0 == 0.0f && !top_left_12)) ||
+          (w1 < 0.0f || (w1 == 0.0f && !top_left_20)) ||
+          (w2 < 0.0f || (w2 == 0.0f && !top_left_01))) {
+        continue;
+      }
+
+      if (stencil) {
+        auto& stored = stencil_row[x];
+        const auto passed = StencilCompareSW(stencil->stencil_compare,
+                                             reference & stencil->read_mask,
+                                             stored & stencil->read_mask);
+        const auto updated = StencilOperationSW(
+            passed ? stencil->depth_stencil_pass : stencil->stencil_failure,
+            reference, stored);
+        stored = static_cast<uint8_t>((stored & ~stencil->write_mask) |
+                                      (updated & stencil->write_mask));
+        if (!passed) {
+          continue;
+        }
+      }
+
+      // Stencil-only draws (like clips) don't need to be shaded.
+      if (write_mask == 0u) {
+        continue;
+      }
+
+      const auto l0 = w0 * inverse_area;
+      const auto l1 = w1 * inverse_area;
+      const auto l2 = w2 * inverse_area;
+      for (size_t i = 0; i < varying_count; i++) {
+        varyings.components[i] = v0.varyings.components[i] * l0 +
+                                 v1.varyings.components[i] * l1 +
+                                 v2.varyings.components[i] * l2;
+      }
+
+      const auto src = fragment_proc(draw.fragment_bindings, varyings);
+      auto pixel = color_row + x * 4u;
+      const auto blended =
+          color_desc.blending_enabled
+              ? BlendSW(color_desc, src, ReadPixelSW(format, pixel))
+              : src;
+      WritePixelSW(format, pixel, blended, write_mask);
+    }
+  }
+}
+
+static void ResolveTile(const Tile& tile, const Attachments& attachments) {
+  if (!attachments.resolve) {
+    return;
+  }
+  const auto stride = attachments.color->GetBytesPerRow();
+  const auto length = (tile.max_x - tile.min_x + 1) * 4u;
+  for (auto y = tile.min_y; y <= tile.max_y; y++) {
+    const auto offset = y * stride + tile.min_x * 4u;
+    ::memcpy(attachments.resolve->GetPixels() + offset,
+             attachments.color->GetPixels() + offset, length);
+  }
+}
+
+bool RasterizerSW::Rasterize(const EncodedPassSW& pass) const {
+  TRACE_EVENT0("impeller", "RasterizerSW::Rasterize");
+
+  auto attachments = ResolveAttachments(pass.render_target);
+  if (!attachments.has_value()) {
+    return false;
+  }
+
+  const auto size = attachments->color->GetSize();
+
+  // Geometry phase.
+  const auto draw_count = pass.draws.size();
+  std::vector<std::vector<ShadedVertex>> vertices(draw_count);
+  std::vector<std::vector<Triangle>> triangles(draw_count);
+  {
+    TRACE_EVENT0("impeller", "ShadeVertices");
+    ParallelFor(draw_count, [&](size_t i) {
+      const auto& draw = pass.draws[i];
+      const auto& pipeline = PipelineSW::Cast(*draw.pipeline);
+      std::vector<bool> visible;
+      if (!ShadeVertices(draw, pipeline, size, vertices[i], visible)) {
+        return;
+      }
+      AssembleTriangles(draw, pipeline, size, vertices[i], visible,
+                        triangles[i]);
+    });
+  }
+
+  // Binning.
+  const auto tiles_x = (size.width + kTileSize - 1) / kTileSize;
+  const auto tiles_y = (size.height + kTileSize - 1) / kTileSize;
+  std::vector<Tile> tiles(tiles_x * tiles_y);
+  for (int64_t ty = 0; ty < tiles_y; ty++) {
+    for (int64_t tx = 0; tx < tiles_x; tx++) {
+      auto& tile = tiles[ty * tiles_x + tx];
+      tile.min_x = tx * kTileSize;
+      tile.min_y = ty * kTileSize;
+      tile.max_x = std::min(tile.min_x + kTileSize, size.width) - 1;
+      tile.max_y = std::min(tile.min_y + kTileSize, size.height) - 1;
+    }
+  }
+  for (const auto& draw_triangles : triangles) {
+    for (const auto& triangle : draw_triangles) {
+      for (auto ty = triangle.min_y / kTileSize;
+           ty <= triangle.max_y / kTileSize; ty++) {
+        for (auto tx = triangle.min_x / kTileSize;
+             tx <= triangle.max_x / kTileSize; tx++) {
+          tiles[ty * tiles_x + tx].triangles.push_back(&triangle);
+        }
+      }
+    }
+  }
+
+  // Raster phase.
+  {
+    TRACE_EVENT0("impeller", "RasterizeTiles");
+    ParallelFor(tiles.size(), [&](size_t i) {
+      const auto& tile = tiles[i];
+      ClearTile(tile, attachments.value());
+      for (const auto* triangle : tile.triangles) {
+        RasterizeTriangle(tile, *triangle, attachments.value());
+      }
+      ResolveTile(tile, attachments.value());
+    });
+  }
+
+  return true;
+}
+
+}  // namespace impeller
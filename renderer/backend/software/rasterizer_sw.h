@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/software/shader_function_sw.h"
+#include "impeller/renderer/buffer.h"
+#include "impeller/renderer/formats.h"
+#include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/renderer/sampler.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A single command whose resources have been resolved to host
+///             memory by the render pass.
+///
+struct DrawSW {
+  std::shared_ptr<Pipeline> pipeline;
+  ShaderBindingsSW vertex_bindings;
+  ShaderBindingsSW fragment_bindings;
+  const uint32_t* indices = nullptr;
+  size_t index_count = 0u;
+  // The number of vertices in the bound vertex buffer or none if the pipeline
+  // doesn't read vertices. Every index must be less than this.
+  std::optional<size_t> vertex_count;
+  PrimitiveType primitive_type = PrimitiveType::kTriangle;
+  WindingOrder winding = WindingOrder::kClockwise;
+  uint32_t stencil_reference = 0u;
+  std::optional<IRect> scissor;
+  std::string label;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The result of encoding a render pass. Holds references to every
+///             resource used by the draws so that they outlive the pass that
+///             created them.
+///
+struct EncodedPassSW {
+  RenderTarget render_target;
+  std::vector<DrawSW> draws;
+  std::vector<std::shared_ptr<const Buffer>> buffers;
+  std::vector<std::shared_ptr<const Texture>> textures;
+  std::vector<std::shared_ptr<const Sampler>> samplers;
+  std::string label;
+};
+
+using EncodedPassesSW = std::vector<std::shared_ptr<const EncodedPassSW>>;
+
+//------------------------------------------------------------------------------
+/// @brief      Executes encoded render passes on the host.
+///
+///             Rasterization happens in two phases. First, vertices of each
+///             draw are shaded and assembled into screen space triangles in
+///             parallel. The triangles are then binned into fixed size tiles
+///             in submission order. Each tile is then rasterized in parallel
+///             using half-space edge functions. Since a tile owns all its
+///             pixels (color and stencil), draws within a tile are processed
+///             in order and the results are identical to a serial
+///             rasterization.
+///
+///             Primitives are assumed to not need clipping against the near
+///             and far planes and varyings are interpolated linearly in screen
+///             space. This is sufficient for the 2D orthographic pipelines in
+///             Impeller. Triangles with any vertex behind the eye are dropped.
+///
+class RasterizerSW {
+ public:
+  static constexpr int64_t kTileSize = 64;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a rasterizer that spreads work across the workers of
+  ///             the given task runner. If no task runner is specified, all
+  ///             work is done on the calling thread.
+  ///
+  RasterizerSW(std::shared_ptr<fml::ConcurrentTaskRunner> workers);
+
+  ~RasterizerSW();
+
+  [[nodiscard]] bool Rasterize(const EncodedPassSW& pass) const;
+
+ private:
+  std::shared_ptr<fml::ConcurrentTaskRunner> workers_;
+
+  void ParallelFor(size_t count,
+                   const std::function<void(size_t)>& task) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterizerSW);
+};
+
+}  // namespace impeller
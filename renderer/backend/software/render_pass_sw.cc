@@ -0,0 +1,173 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/render_pass_sw.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/base.h"
+#include "impeller/renderer/backend/software/device_buffer_sw.h"
+#include "impeller/renderer/backend/software/pipeline_sw.h"
+#include "impeller/renderer/backend/software/sampler_sw.h"
+#include "impeller/renderer/backend/software/texture_sw.h"
+#include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+RenderPassSW::RenderPassSW(std::shared_ptr<EncodedPassesSW> encoded_passes,
+                           RenderTarget target)
+    : RenderPass(std::move(target)),
+      encoded_passes_(std::move(encoded_passes)),
+      transients_buffer_(HostBuffer::Create()) {
+  if (!encoded_passes_ || !render_target_.IsValid()) {
+    return;
+  }
+  is_valid_ = true;
+}
+
+RenderPassSW::~RenderPassSW() = default;
+
+HostBuffer& RenderPassSW::GetTransientsBuffer() {
+  return *transients_buffer_;
+}
+
+bool RenderPassSW::IsValid() const {
+  return is_valid_;
+}
+
+void RenderPassSW::SetLabel(std::string label) {
+  if (label.empty()) {
+    return;
+  }
+  label_ = std::move(label);
+  transients_buffer_->SetLabel(SPrintF("%s Transients", label_.c_str()));
+}
+
+static const uint8_t* ResolveBuffer(EncodedPassSW& pass,
+                                    Allocator& allocator,
+                                    const BufferView& view) {
+  if (!view.buffer) {
+    return nullptr;
+  }
+
+  auto device_buffer = view.buffer->GetDeviceBuffer(allocator);
+  if (!device_buffer) {
+    return nullptr;
+  }
+
+  const auto& device_buffer_sw = DeviceBufferSW::Cast(*device_buffer);
+  if (view.range.offset + view.range.length > device_buffer_sw.GetSize()) {
+    VALIDATION_LOG << "Buffer view is out of bounds of its device buffer.";
+    return nullptr;
+  }
+
+  pass.buffers.emplace_back(std::move(device_buffer));
+  return device_buffer_sw.GetContents() + view.range.offset;
+}
+
+static bool ResolveBindings(EncodedPassSW& pass,
+                            Allocator& allocator,
+                            const Bindings& bindings,
+                            ShaderBindingsSW& resolved) {
+  for (const auto& buffer : bindings.buffers) {
+    if (buffer.first >= ShaderBindingsSW::kMaxBindings) {
+      VALIDATION_LOG << "Buffer binding index out of range.";
+      return false;
+    }
+    resolved.buffers[buffer.first] =
+        ResolveBuffer(pass, allocator, buffer.second);
+    if (!resolved.buffers[buffer.first]) {
+      return false;
+    }
+  }
+  for (const auto& texture : bindings.textures) {
+    if (texture.first >= ShaderBindingsSW::kMaxBindings || !texture.second ||
+        !texture.second->IsValid()) {
+      return false;
+    }
+    resolved.textures[texture.first] = &TextureSW::Cast(*texture.second);
+    pass.textures.push_back(texture.second);
+  }
+  for (const auto& sampler : bindings.samplers) {
+    if (sampler.first >= ShaderBindingsSW::kMaxBindings || !sampler.second ||
+        !sampler.second->IsValid()) {
+      return false;
+    }
+    resolved.samplers[sampler.first] = &SamplerSW::Cast(*sampler.second);
+    pass.samplers.push_back(sampler.second);
+  }
+  return true;
+}
+
+bool RenderPassSW::OnEncodeCommands(Allocator& transients_allocator) const {
+  TRACE_EVENT0("impeller", "RenderPassSW::EncodeCommands");
+  if (!IsValid()) {
+    return false;
+  }
+
+  auto pass = std::make_shared<EncodedPassSW>();
+  pass->render_target = render_target_;
+  pass->label = label_;
+  pass->draws.reserve(commands_.size());
+
+  for (const auto& command : commands_) {
+    if (command.index_count == 0u) {
+      VALIDATION_LOG << "Zero index count in render pass command.";
+      continue;
+    }
+
+    DrawSW draw;
+    draw.pipeline = command.pipeline;
+    draw.primitive_type = command.primitive_type;
+    draw.winding = command.winding;
+    draw.stencil_reference = command.stencil_reference;
+    draw.scissor = command.scissor;
+    draw.label = command.label;
+
+    if (!ResolveBindings(*pass, transients_allocator, command.vertex_bindings,
+                         draw.vertex_bindings)) {
+      return false;
+    }
+    if (!ResolveBindings(*pass, transients_allocator,
+                         command.fragment_bindings, draw.fragment_bindings)) {
+      return false;
+    }
+
+    FML_DCHECK(command.index_count * sizeof(uint32_t) ==
+               command.index_buffer.range.length);
+    draw.indices = reinterpret_cast<const uint32_t*>(
+        ResolveBuffer(*pass, transients_allocator, command.index_buffer));
+    if (!draw.indices) {
+      return false;
+    }
+    draw.index_count = command.index_count;
+
+    const auto stride = PipelineSW::Cast(*command.pipeline).GetVertexStride();
+    if (stride > 0u) {
+      auto vertex_buffer = command.vertex_bindings.buffers.find(
+          VertexDescriptor::kReservedVertexBufferIndex);
+      draw.vertex_count = vertex_buffer == command.vertex_bindings.buffers.end()
+                              ? 0u
+                              : vertex_buffer->second.range.length / stride;
+    }
+
+    pass->draws.emplace_back(std::move(draw));
+  }
+
+  encoded_passes_->emplace_back(std::move(pass));
+  return true;
+}
+
+bool RenderPassSW::OnAddCommand(Command command) {
+  if (!command) {
+    VALIDATION_LOG << "Attempted to add an invalid command to the render pass.";
+    return false;
+  }
+
+  commands_.emplace_back(std::move(command));
+  return true;
+}
+
+}  // namespace impeller
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/software/rasterizer_sw.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+class RenderPassSW final : public RenderPass {
+ public:
+  // |RenderPass|
+  ~RenderPassSW() override;
+
+ private:
+  friend class CommandBufferSW;
+
+  std::shared_ptr<EncodedPassesSW> encoded_passes_;
+  std::vector<Command> commands_;
+  std::shared_ptr<HostBuffer> transients_buffer_;
+  std::string label_;
+  bool is_valid_ = false;
+
+  RenderPassSW(std::shared_ptr<EncodedPassesSW> encoded_passes,
+               RenderTarget target);
+
+  // |RenderPass|
+  bool IsValid() const override;
+
+  // |RenderPass|
+  void SetLabel(std::string label) override;
+
+  // |RenderPass|
+  HostBuffer& GetTransientsBuffer() override;
+
+  // |RenderPass|
+  bool OnAddCommand(Command command) override;
+
+  // |RenderPass|
+  bool OnEncodeCommands(Allocator& transients_allocator) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderPassSW);
+};
+
+}  // namespace impeller
@@ -0,0 +1,26 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/sampler_library_sw.h"
+
+#include "impeller/renderer/backend/software/sampler_sw.h"
+
+namespace impeller {
+
+SamplerLibrarySW::SamplerLibrarySW() = default;
+
+SamplerLibrarySW::~SamplerLibrarySW() = default;
+
+std::shared_ptr<const Sampler> SamplerLibrarySW::GetSampler(
+    SamplerDescriptor descriptor) {
+  auto found = samplers_.find(descriptor);
+  if (found != samplers_.end()) {
+    return found->second;
+  }
+  auto sampler = std::shared_ptr<SamplerSW>(new SamplerSW(descriptor));
+  samplers_[descriptor] = sampler;
+  return sampler;
+}
+
+}  // namespace impeller
@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/renderer/comparable.h"
+#include "impeller/renderer/sampler_descriptor.h"
+#include "impeller/renderer/sampler_library.h"
+
+namespace impeller {
+
+class SamplerLibrarySW final
+    : public SamplerLibrary,
+      public BackendCast<SamplerLibrarySW, SamplerLibrary> {
+ public:
+  // |SamplerLibrary|
+  ~SamplerLibrarySW() override;
+
+ private:
+  friend class ContextSW;
+
+  using CachedSamplers = std::unordered_map<SamplerDescriptor,
+                                            std::shared_ptr<const Sampler>,
+                                            ComparableHash<SamplerDescriptor>,
+                                            ComparableEqual<SamplerDescriptor>>;
+  CachedSamplers samplers_;
+
+  SamplerLibrarySW();
+
+  // |SamplerLibrary|
+  std::shared_ptr<const Sampler> GetSampler(
+      SamplerDescriptor descriptor) override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SamplerLibrarySW);
+};
+
+}  // namespace impeller
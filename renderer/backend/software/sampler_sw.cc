@@ -0,0 +1,17 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/sampler_sw.h"
+
+namespace impeller {
+
+SamplerSW::SamplerSW(SamplerDescriptor desc) : Sampler(std::move(desc)) {}
+
+SamplerSW::~SamplerSW() = default;
+
+bool SamplerSW::IsValid() const {
+  return true;
+}
+
+}  // namespace impeller
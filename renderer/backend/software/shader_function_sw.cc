@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/shader_function_sw.h"
+
+#include "impeller/renderer/backend/software/sampler_sw.h"
+#include "impeller/renderer/backend/software/texture_sw.h"
+
+namespace impeller {
+
+Color ShaderBindingsSW::Sample(const SampledImageSlot& slot, Point uv) const {
+  if (!slot.HasTexture() || textures[slot.texture_index] == nullptr) {
+    return {};
+  }
+  static const SamplerDescriptor kDefaultSampler;
+  const auto* sampler =
+      slot.HasSampler() ? samplers[slot.sampler_index] : nullptr;
+  return textures[slot.texture_index]->Sample(
+      uv, sampler ? sampler->GetDescriptor() : kDefaultSampler);
+}
+
+ShaderFunctionSW::ShaderFunctionSW(UniqueID parent_library_id,
+                                   NativeShaderSW native)
+    : ShaderFunction(parent_library_id,
+                     {native.entrypoint.data(), native.entrypoint.size()},
+                     native.stage),
+      native_(native) {}
+
+ShaderFunctionSW::~ShaderFunctionSW() = default;
+
+VertexShaderProcSW ShaderFunctionSW::GetVertexProc() const {
+  return native_.vertex_proc;
+}
+
+FragmentShaderProcSW ShaderFunctionSW::GetFragmentProc() const {
+  return native_.fragment_proc;
+}
+
+size_t ShaderFunctionSW::GetVaryingCount() const {
+  return native_.varying_count;
+}
+
+}  // namespace impeller
@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/geometry/vector.h"
+#include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/shader_types.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+class SamplerSW;
+class TextureSW;
+
+//------------------------------------------------------------------------------
+/// @brief      The resources bound to one stage of a command, resolved to host
+///             memory before rasterization begins. Slots are indexed the same
+///             way as the reflected `ShaderUniformSlot`s and
+///             `SampledImageSlot`s so native shaders can use the structs in
+///             the generated `*.vert.h` and `*.frag.h` headers directly.
+///
+struct ShaderBindingsSW {
+  static constexpr size_t kMaxBindings = 32u;
+
+  std::array<const uint8_t*, kMaxBindings> buffers = {};
+  std::array<const TextureSW*, kMaxBindings> textures = {};
+  std::array<const SamplerSW*, kMaxBindings> samplers = {};
+
+  template <class T>
+  const T& GetUniform(const ShaderUniformSlot<T>& slot) const {
+    return *reinterpret_cast<const T*>(buffers[slot.binding]);
+  }
+
+  template <class T>
+  const T& GetVertex(size_t vertex_index) const {
+    return reinterpret_cast<const T*>(
+        buffers[VertexDescriptor::kReservedVertexBufferIndex])[vertex_index];
+  }
+
+  Color Sample(const SampledImageSlot& slot, Point uv) const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The outputs of a vertex shader invocation that are interpolated
+///             across a primitive and handed to the fragment shader.
+///
+struct VaryingsSW {
+  static constexpr size_t kMaxComponents = 8u;
+
+  std::array<Scalar, kMaxComponents> components = {};
+
+  void Set(size_t offset, Scalar value) { components[offset] = value; }
+
+  void Set(size_t offset, Point value) {
+    components[offset + 0] = value.x;
+    components[offset + 1] = value.y;
+  }
+
+  void Set(size_t offset, const Vector4& value) {
+    components[offset + 0] = value.x;
+    components[offset + 1] = value.y;
+    components[offset + 2] = value.z;
+    components[offset + 3] = value.w;
+  }
+
+  Scalar GetScalar(size_t offset) const { return components[offset]; }
+
+  Point GetPoint(size_t offset) const {
+    return {components[offset + 0], components[offset + 1]};
+  }
+
+  Color GetColor(size_t offset) const {
+    return {components[offset + 0], components[offset + 1],
+            components[offset + 2], components[offset + 3]};
+  }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A native vertex shader. Returns the clip space position of the
+///             vertex and writes the stage outputs into the varyings.
+///
+using VertexShaderProcSW = Vector4 (*)(const ShaderBindingsSW& bindings,
+                                       size_t vertex_index,
+                                       VaryingsSW& varyings);
+
+//------------------------------------------------------------------------------
+/// @brief      A native fragment shader. Returns the color of the fragment
+///             given the interpolated varyings.
+///
+using FragmentShaderProcSW = Color (*)(const ShaderBindingsSW& bindings,
+                                       const VaryingsSW& varyings);
+
+//------------------------------------------------------------------------------
+/// @brief      Describes a native implementation of a shader function. These
+///             are registered with the software shader library using the same
+///             entrypoint names `impellerc` generates for the GPU backends.
+///
+struct NativeShaderSW {
+  std::string_view entrypoint;
+  ShaderStage stage = ShaderStage::kUnknown;
+  VertexShaderProcSW vertex_proc = nullptr;
+  FragmentShaderProcSW fragment_proc = nullptr;
+  //----------------------------------------------------------------------------
+  /// The number of varying components written by the vertex shader.
+  ///
+  size_t varying_count = 0u;
+
+  static constexpr NativeShaderSW Vertex(std::string_view entrypoint,
+                                         VertexShaderProcSW proc,
+                                         size_t varying_count) {
+    return {entrypoint, ShaderStage::kVertex, proc, nullptr, varying_count};
+  }
+
+  static constexpr NativeShaderSW Fragment(std::string_view entrypoint,
+                                           FragmentShaderProcSW proc) {
+    return {entrypoint, ShaderStage::kFragment, nullptr, proc, 0u};
+  }
+};
+
+class ShaderFunctionSW final
+    : public ShaderFunction,
+      public BackendCast<ShaderFunctionSW, ShaderFunction> {
+ public:
+  // |ShaderFunction|
+  ~ShaderFunctionSW() override;
+
+  VertexShaderProcSW GetVertexProc() const;
+
+  FragmentShaderProcSW GetFragmentProc() const;
+
+  size_t GetVaryingCount() const;
+
+ private:
+  friend class ShaderLibrarySW;
+
+  const NativeShaderSW native_;
+
+  ShaderFunctionSW(UniqueID parent_library_id, NativeShaderSW native);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShaderFunctionSW);
+};
+
+}  // namespace impeller
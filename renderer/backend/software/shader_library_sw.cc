@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/shader_library_sw.h"
+
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+static bool IsValidNativeShader(const NativeShaderSW& shader) {
+  switch (shader.stage) {
+    case ShaderStage::kVertex:
+      return shader.vertex_proc != nullptr &&
+             shader.varying_count <= VaryingsSW::kMaxComponents;
+    case ShaderStage::kFragment:
+      return shader.fragment_proc != nullptr;
+    case ShaderStage::kUnknown:
+      return false;
+  }
+  return false;
+}
+
+ShaderLibrarySW::ShaderLibrarySW(const std::vector<NativeShaderSW>& shaders) {
+  for (const auto& shader : shaders) {
+    if (!IsValidNativeShader(shader)) {
+      VALIDATION_LOG << "Invalid native shader '" << shader.entrypoint
+                     << "' could not be added to the shader library.";
+      return;
+    }
+    functions_[ShaderKey{shader.entrypoint, shader.stage}] =
+        std::shared_ptr<ShaderFunctionSW>(
+            new ShaderFunctionSW(library_id_, shader));
+  }
+
+  is_valid_ = true;
+}
+
+ShaderLibrarySW::~ShaderLibrarySW() = default;
+
+bool ShaderLibrarySW::IsValid() const {
+  return is_valid_;
+}
+
+std::shared_ptr<const ShaderFunction> ShaderLibrarySW::GetFunction(
+    const std::string_view& name,
+    ShaderStage stage) {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  if (auto found = functions_.find(ShaderKey{name, stage});
+      found != functions_.end()) {
+    return found->second;
+  }
+
+  return nullptr;
+}
+
+}  // namespace impeller
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/software/shader_function_sw.h"
+#include "impeller/renderer/comparable.h"
+#include "impeller/renderer/shader_library.h"
+
+namespace impeller {
+
+class ShaderLibrarySW final : public ShaderLibrary {
+ public:
+  // |ShaderLibrary|
+  ~ShaderLibrarySW() override;
+
+  // |ShaderLibrary|
+  bool IsValid() const override;
+
+ private:
+  friend class ContextSW;
+
+  struct ShaderKey {
+    std::string name;
+    ShaderStage stage = ShaderStage::kUnknown;
+
+    ShaderKey(const std::string_view& p_name, ShaderStage p_stage)
+        : name({p_name.data(), p_name.size()}), stage(p_stage) {}
+
+    struct Hash {
+      size_t operator()(const ShaderKey& key) const {
+        return fml::HashCombine(key.name, key.stage);
+      }
+    };
+
+    struct Equal {
+      constexpr bool operator()(const ShaderKey& k1,
+                                const ShaderKey& k2) const {
+        return k1.stage == k2.stage && k1.name == k2.name;
+      }
+    };
+  };
+
+  using Functions = std::unordered_map<ShaderKey,
+                                       std::shared_ptr<const ShaderFunction>,
+                                       ShaderKey::Hash,
+                                       ShaderKey::Equal>;
+
+  UniqueID library_id_;
+  Functions functions_;
+  bool is_valid_ = false;
+
+  ShaderLibrarySW(const std::vector<NativeShaderSW>& shaders);
+
+  // |ShaderLibrary|
+  std::shared_ptr<const ShaderFunction> GetFunction(
+      const std::string_view& name,
+      ShaderStage stage) override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShaderLibrarySW);
+};
+
+}  // namespace impeller
@@ -0,0 +1,271 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
+#include "impeller/renderer/backend/software/context_sw.h"
+#include "impeller/renderer/command.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/frame_capture.h"
+#include "impeller/renderer/frame_replay.h"
+#include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/pipeline_cache.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+static constexpr ShaderUniformSlot<Color> kFillColorSlot = {"FillColor", 0u};
+
+static Vector4 FillVertex(const ShaderBindingsSW& bindings,
+                          size_t vertex_index,
+                          VaryingsSW& varyings) {
+  const auto& position = bindings.GetVertex<Point>(vertex_index);
+  varyings.Set(0u, position);
+  return {position.x, position.y, 0.0, 1.0};
+}
+
+static Color FillFragment(const ShaderBindingsSW& bindings,
+                          const VaryingsSW& varyings) {
+  auto color = bindings.GetUniform(kFillColorSlot);
+  color.alpha *= (varyings.GetScalar(0u) + 1.0f) * 0.5f;
+  return color;
+}
+
+struct BenchmarkSetupSW {
+  std::shared_ptr<Context> context;
+  std::shared_ptr<Pipeline> pipeline;
+  RenderTarget target;
+};
+
+static BenchmarkSetupSW CreateBenchmarkSetup(size_t worker_count, ISize size) {
+  BenchmarkSetupSW setup;
+  setup.context = ContextSW::Create(
+      {
+          NativeShaderSW::Vertex("fill_vertex_main", FillVertex, 2u),
+          NativeShaderSW::Fragment("fill_fragment_main", FillFragment),
+      },
+      worker_count);
+  FML_CHECK(setup.context);
+  auto library = setup.context->GetShaderLibrary();
+  PipelineDescriptor desc;
+  desc.SetLabel("Fill Pipeline");
+  desc.AddStageEntrypoint(
+      library->GetFunction("fill_vertex_main", ShaderStage::kVertex));
+  desc.AddStageEntrypoint(
+      library->GetFunction("fill_fragment_main", ShaderStage::kFragment));
+  ColorAttachmentDescriptor color0;
+  color0.format = PixelFormat::kDefaultColor;
+  color0.blending_enabled = true;
+  desc.SetColorAttachmentDescriptor(0u, color0);
+  setup.pipeline =
+      setup.context->GetPipelineLibrary()->GetRenderPipeline(desc).get();
+  FML_CHECK(setup.pipeline);
+  setup.target = RenderTarget::CreateOffscreen(*setup.context, size);
+  FML_CHECK(setup.target.IsValid());
+  return setup;
+}
+
+static void RenderFrame(const BenchmarkSetupSW& setup, const Command& cmd) {
+  auto command_buffer = setup.context->CreateRenderCommandBuffer();
+  auto pass = command_buffer->CreateRenderPass(setup.target);
+  FML_CHECK(pass->AddCommand(cmd));
+  FML_CHECK(pass->EncodeCommands(*setup.context->GetTransientsAllocator()));
+  FML_CHECK(command_buffer->SubmitCommands());
+}
+
+static Command CreateFillCommand(const BenchmarkSetupSW& setup,
+                                 HostBuffer& buffer,
+                                 const std::vector<Point>& vertices) {
+  Command cmd;
+  cmd.pipeline = setup.pipeline;
+  VertexBufferBuilder<Point> builder;
+  builder.Reserve(vertices.size());
+  for (const auto& vertex : vertices) {
+    builder.AppendVertex(vertex);
+  }
+  cmd.BindVertices(builder.CreateVertexBuffer(buffer));
+  cmd.BindResource(ShaderStage::kFragment, kFillColorSlot,
+                   buffer.EmplaceUniform(Color::Red()));
+  return cmd;
+}
+
+//------------------------------------------------------------------------------
+/// Fills the entire render target with a single quad. Measures the fill rate
+/// of the rasterizer.
+///
+static void BM_SoftwareFillRate(benchmark::State& state) {
+  const auto worker_count = static_cast<size_t>(state.range(0));
+  const ISize size = {1024, 1024};
+  auto setup = CreateBenchmarkSetup(worker_count, size);
+  auto buffer = HostBuffer::Create();
+  auto cmd = CreateFillCommand(setup, *buffer,
+                               {{-1, 1}, {1, 1}, {-1, -1}, {1, -1}});
+  cmd.primitive_type = PrimitiveType::kTriangleStrip;
+  for (auto _ : state) {
+    RenderFrame(setup, cmd);
+  }
+  state.SetItemsProcessed(state.iterations() * size.Area());
+}
+
+//------------------------------------------------------------------------------
+/// Draws a grid of small triangles covering the render target. Measures the
+/// per-triangle setup and binning overhead.
+///
+static void BM_SoftwareTriangleThroughput(benchmark::State& state) {
+  const auto worker_count = static_cast<size_t>(state.range(0));
+  const auto grid = state.range(1);
+  auto setup = CreateBenchmarkSetup(worker_count, {1024, 1024});
+  std::vector<Point> vertices;
+  vertices.reserve(grid * grid * 3);
+  const Scalar step = 2.0f / grid;
+  for (int64_t y = 0; y < grid; y++) {
+    for (int64_t x = 0; x < grid; x++) {
+      const Point origin = {-1.0f + x * step, -1.0f + y * step};
+      vertices.push_back(origin);
+      vertices.push_back(origin + Point{step, 0.0f});
+      vertices.push_back(origin + Point{0.0f, step});
+    }
+  }
+  auto buffer = HostBuffer::Create();
+  auto cmd = CreateFillCommand(setup, *buffer, vertices);
+  for (auto _ : state) {
+    RenderFrame(setup, cmd);
+  }
+  state.SetItemsProcessed(state.iterations() * grid * grid);
+}
+
+//------------------------------------------------------------------------------
+/// Captures a frame made of many small commands and replays it. Measures the
+/// recording and encoding overhead per command on top of the rasterization
+/// costs.
+///
+static void BM_SoftwareReplay(benchmark::State& state) {
+  const auto command_count = state.range(0);
+  auto setup = CreateBenchmarkSetup(0u, {256, 256});
+
+  auto capture = std::make_shared<FrameCapture>();
+  {
+    auto command_buffer = setup.context->CreateRenderCommandBuffer();
+    auto pass = command_buffer->CreateRenderPass(setup.target);
+    pass->SetCapture(capture);
+    const Scalar step = 2.0f / command_count;
+    for (int64_t i = 0; i < command_count; i++) {
+      const Point origin = {-1.0f + i * step, -1.0f + i * step};
+      FML_CHECK(pass->AddCommand(CreateFillCommand(
+          setup, pass->GetTransientsBuffer(),
+          {origin, origin + Point{step, 0.0f}, origin + Point{0.0f, step}})));
+    }
+    FML_CHECK(pass->EncodeCommands(*setup.context->GetTransientsAllocator()));
+    FML_CHECK(command_buffer->SubmitCommands());
+  }
+
+  auto mapping = capture->CreateMapping();
+  FrameReplay replay(setup.context, FrameCapture::CreateFromMapping(*mapping));
+  FML_CHECK(replay.IsValid());
+  for (auto _ : state) {
+    FML_CHECK(replay.Replay());
+  }
+  state.SetItemsProcessed(state.iterations() * command_count);
+  state.SetBytesProcessed(state.iterations() * mapping->GetSize());
+}
+
+//------------------------------------------------------------------------------
+/// Opens a pipeline cache and loads the data of a set of pipeline variants,
+/// storing it for the variants that are missing. Cold starts begin with an
+/// empty cache. Warm starts find the data stored by a previous launch. The
+/// software backend has nothing to compile, so the data is a stand-in of
+/// typical size. This measures what backends with compilers pay for the cache
+/// instead of compiling.
+///
+static void BM_PipelineCacheStartup(benchmark::State& state) {
+  const bool warm = state.range(0) != 0;
+  const auto variant_count = state.range(1);
+  auto setup = CreateBenchmarkSetup(0u, {16, 16});
+  std::vector<PipelineDescriptor> descs;
+  for (int64_t i = 0; i < variant_count; i++) {
+    auto desc = setup.pipeline->GetDescriptor();
+    StencilAttachmentDescriptor stencil;
+    stencil.read_mask = static_cast<uint32_t>(i);
+    desc.SetStencilAttachmentDescriptors(stencil);
+    descs.emplace_back(std::move(desc));
+  }
+  const std::vector<uint8_t> bytes(64u * 1024u, 0xAB);
+  const fml::NonOwnedMapping data(bytes.data(), bytes.size());
+
+  fml::ScopedTemporaryDirectory temp_dir;
+  size_t launch = 0u;
+  auto next_path = [&]() {
+    return fml::paths::JoinPaths(
+        {temp_dir.path(), "pipelines_" + std::to_string(launch++) + ".db"});
+  };
+  auto path = next_path();
+  if (warm) {
+    PipelineCache cache(path);
+    for (const auto& desc : descs) {
+      FML_CHECK(cache.Store(desc, data));
+    }
+  }
+
+  for (auto _ : state) {
+    if (!warm) {
+      state.PauseTiming();
+      path = next_path();
+      state.ResumeTiming();
+    }
+    PipelineCache cache(path);
+    FML_CHECK(cache.IsValid());
+    for (const auto& desc : descs) {
+      if (!cache.Load(desc)) {
+        FML_CHECK(cache.Store(desc, data));
+      }
+    }
+    FML_CHECK(cache.GetHitCount() == (warm ? descs.size() : 0u));
+  }
+  state.SetItemsProcessed(state.iterations() * variant_count);
+}
+
+BENCHMARK(BM_SoftwareFillRate)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_SoftwareTriangleThroughput)
+    ->Args({0, 16})
+    ->Args({4, 16})
+    ->Args({0, 128})
+    ->Args({1, 128})
+    ->Args({2, 128})
+    ->Args({4, 128})
+    ->Args({8, 128})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_SoftwareReplay)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Cold and warm starts of a few dozen pipeline variants.
+BENCHMARK(BM_PipelineCacheStartup)
+    ->Args({0, 32})
+    ->Args({1, 32})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace impeller
@@ -0,0 +1,629 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <chrono>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "flutter/impeller/fixtures/vertex_color.frag.h"
+#include "flutter/impeller/fixtures/vertex_color.vert.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/backend/software/context_sw.h"
+#include "impeller/renderer/backend/software/texture_sw.h"
+#include "impeller/renderer/command.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/frame_capture.h"
+#include "impeller/renderer/frame_replay.h"
+#include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/pipeline_builder.h"
+#include "impeller/renderer/pipeline_cache.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/renderer/renderer.h"
+#include "impeller/renderer/surface.h"
+#include "impeller/renderer/texture_pool.h"
+#include "impeller/renderer/texture_upload_queue.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+namespace testing {
+
+static constexpr ShaderUniformSlot<Color> kFillColorSlot = {"FillColor", 0u};
+static constexpr ShaderStageIOSlot kFillPositionSlot = {
+    "position", 0u, 0u, 0u, ShaderType::kFloat, 32u, 2u, 1u};
+
+static Vector4 FillVertex(const ShaderBindingsSW& bindings,
+                          size_t vertex_index,
+                          VaryingsSW& varyings) {
+  const auto& position = bindings.GetVertex<Point>(vertex_index);
+  return {position.x, position.y, 0.0, 1.0};
+}
+
+static Color FillFragment(const ShaderBindingsSW& bindings,
+                          const VaryingsSW& varyings) {
+  return bindings.GetUniform(kFillColorSlot);
+}
+
+static std::shared_ptr<Context> CreateTestContext(size_t worker_count) {
+  return ContextSW::Create(
+      {
+          NativeShaderSW::Vertex("fill_vertex_main", FillVertex, 0u),
+          NativeShaderSW::Fragment("fill_fragment_main", FillFragment),
+      },
+      worker_count);
+}
+
+static std::shared_ptr<Pipeline> CreateFillPipeline(
+    const Context& context,
+    std::optional<StencilAttachmentDescriptor> stencil) {
+  auto library = context.GetShaderLibrary();
+  PipelineDescriptor desc;
+  desc.SetLabel("Fill Pipeline");
+  desc.AddStageEntrypoint(
+      library->GetFunction("fill_vertex_main", ShaderStage::kVertex));
+  desc.AddStageEntrypoint(
+      library->GetFunction("fill_fragment_main", ShaderStage::kFragment));
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  const ShaderStageIOSlot* inputs[] = {&kFillPositionSlot};
+  vertex_descriptor->SetStageInputs(inputs, 1u);
+  desc.SetVertexDescriptor(std::move(vertex_descriptor));
+  ColorAttachmentDescriptor color0;
+  color0.format = PixelFormat::kDefaultColor;
+  desc.SetColorAttachmentDescriptor(0u, color0);
+  if (stencil.has_value()) {
+    desc.SetStencilPixelFormat(PixelFormat::kDefaultStencil);
+    desc.SetStencilAttachmentDescriptors(stencil.value());
+  }
+  return context.GetPipelineLibrary()->GetRenderPipeline(desc).get();
+}
+
+static Command CreateFillCommand(std::shared_ptr<Pipeline> pipeline,
+                                 HostBuffer& buffer,
+                                 const std::vector<Point>& vertices,
+                                 Color color) {
+  Command cmd;
+  cmd.label = "Fill";
+  cmd.pipeline = std::move(pipeline);
+  VertexBufferBuilder<Point> builder;
+  builder.Reserve(vertices.size());
+  for (const auto& vertex : vertices) {
+    builder.AppendVertex(vertex);
+  }
+  cmd.BindVertices(builder.CreateVertexBuffer(buffer));
+  cmd.BindResource(ShaderStage::kFragment, kFillColorSlot,
+                   buffer.EmplaceUniform(color));
+  return cmd;
+}
+
+static bool Render(const Context& context,
+                   const RenderTarget& target,
+                   const std::vector<Command>& commands) {
+  auto command_buffer = context.CreateRenderCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  auto pass = command_buffer->CreateRenderPass(target);
+  if (!pass) {
+    return false;
+  }
+  for (const auto& command : commands) {
+    if (!pass->AddCommand(command)) {
+      return false;
+    }
+  }
+  return pass->EncodeCommands(*context.GetTransientsAllocator()) &&
+         command_buffer->SubmitCommands();
+}
+
+class TestSurface final : public Surface {
+ public:
+  TestSurface(RenderTarget target) : Surface(std::move(target)) {}
+
+  // |Surface|
+  bool Present() const override { return true; }
+};
+
+static Color ReadPixel(const RenderTarget& target, int64_t x, int64_t y) {
+  return TextureSW::Cast(*target.GetRenderTargetTexture()).ReadPixel(x, y);
+}
+
+TEST(SoftwareBackendTest, CanCreateContext) {
+  auto context = CreateTestContext(0u);
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->IsValid());
+  ASSERT_TRUE(context->GetShaderLibrary()->GetFunction("fill_vertex_main",
+                                                       ShaderStage::kVertex));
+  ASSERT_FALSE(context->GetShaderLibrary()->GetFunction(
+      "fill_vertex_main", ShaderStage::kFragment));
+}
+
+TEST(SoftwareBackendTest, CanClearRenderTarget) {
+  auto context = CreateTestContext(0u);
+  ASSERT_TRUE(context);
+  auto target = RenderTarget::CreateOffscreen(*context, {16, 16});
+  ASSERT_TRUE(target.IsValid());
+  ASSERT_TRUE(Render(*context, target, {}));
+  ASSERT_EQ(ReadPixel(target, 0, 0), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(target, 15, 15), Color::BlackTransparent());
+}
+
+TEST(SoftwareBackendTest, RasterizesTrianglesAcrossTiles) {
+  for (auto worker_count : {0u, 4u}) {
+    auto context = CreateTestContext(worker_count);
+    ASSERT_TRUE(context);
+    // Large enough to span multiple tiles.
+    auto target = RenderTarget::CreateOffscreen(*context, {200, 100});
+    ASSERT_TRUE(target.IsValid());
+    auto pipeline = CreateFillPipeline(*context, std::nullopt);
+    ASSERT_TRUE(pipeline);
+    auto buffer = HostBuffer::Create();
+    // Covers the left half of the target.
+    auto cmd = CreateFillCommand(pipeline, *buffer,
+                                 {
+                                     {-1, 1},
+                                     {0, 1},
+                                     {-1, -1},
+                                     {0, 1},
+                                     {0, -1},
+                                     {-1, -1},
+                                 },
+                                 Color::Red());
+    ASSERT_TRUE(Render(*context, target, {cmd}));
+    ASSERT_EQ(ReadPixel(target, 0, 0), Color::Red());
+    ASSERT_EQ(ReadPixel(target, 99, 99), Color::Red());
+    ASSERT_EQ(ReadPixel(target, 100, 0), Color::BlackTransparent());
+    ASSERT_EQ(ReadPixel(target, 199, 99), Color::BlackTransparent());
+  }
+}
+
+TEST(SoftwareBackendTest, SkipsDrawsWithIndicesPastTheVertexBuffer) {
+  auto context = CreateTestContext(0u);
+  ASSERT_TRUE(context);
+  auto target = RenderTarget::CreateOffscreen(*context, {16, 16});
+  auto pipeline = CreateFillPipeline(*context, std::nullopt);
+  ASSERT_TRUE(pipeline);
+  auto buffer = HostBuffer::Create();
+  auto cmd = CreateFillCommand(pipeline, *buffer,
+                               {
+                                   {-1, 1},
+                                   {1, 1},
+                                   {-1, -1},
+                                   {1, 1},
+                                   {1, -1},
+                                   {-1, -1},
+                               },
+                               Color::Red());
+  // Only the first triangle is backed by the vertex buffer now.
+  cmd.vertex_bindings.buffers[VertexDescriptor::kReservedVertexBufferIndex]
+      .range.length = 3u * sizeof(Point);
+  ASSERT_TRUE(Render(*context, target, {cmd}));
+  ASSERT_EQ(ReadPixel(target, 0, 0), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(target, 15, 15), Color::BlackTransparent());
+}
+
+TEST(SoftwareBackendTest, StencilMasksFragments) {
+  auto context = CreateTestContext(2u);
+  ASSERT_TRUE(context);
+  auto target = RenderTarget::CreateOffscreen(*context, {16, 16});
+  ASSERT_TRUE(target.IsValid());
+
+  // Writes the reference value into the stencil buffer for the left half.
+  StencilAttachmentDescriptor write_stencil;
+  write_stencil.stencil_compare = CompareFunction::kAlways;
+  write_stencil.depth_stencil_pass = StencilOperation::kSetToReferenceValue;
+  auto write_pipeline = CreateFillPipeline(*context, write_stencil);
+  ASSERT_TRUE(write_pipeline);
+
+  // Only draws where the stencil buffer matches the reference value.
+  StencilAttachmentDescriptor test_stencil;
+  test_stencil.stencil_compare = CompareFunction::kEqual;
+  auto test_pipeline = CreateFillPipeline(*context, test_stencil);
+  ASSERT_TRUE(test_pipeline);
+
+  auto buffer = HostBuffer::Create();
+  auto write_cmd = CreateFillCommand(
+      write_pipeline, *buffer, {{-1, 1}, {0, 1}, {-1, -1}, {0, -1}},
+      Color::Blue());
+  write_cmd.primitive_type = PrimitiveType::kTriangleStrip;
+  write_cmd.stencil_reference = 1u;
+  auto test_cmd = CreateFillCommand(
+      test_pipeline, *buffer, {{-1, 1}, {1, 1}, {-1, -1}, {1, -1}},
+      Color::Red());
+  test_cmd.primitive_type = PrimitiveType::kTriangleStrip;
+  test_cmd.stencil_reference = 1u;
+
+  ASSERT_TRUE(Render(*context, target, {write_cmd, test_cmd}));
+  ASSERT_EQ(ReadPixel(target, 2, 8), Color::Red());
+  ASSERT_EQ(ReadPixel(target, 12, 8), Color::BlackTransparent());
+}
+
+TEST(SoftwareBackendTest, ScissorMasksFragments) {
+  auto context = CreateTestContext(2u);
+  ASSERT_TRUE(context);
+  // Large enough for the scissor to span multiple tiles.
+  auto target = RenderTarget::CreateOffscreen(*context, {200, 100});
+  ASSERT_TRUE(target.IsValid());
+  auto pipeline = CreateFillPipeline(*context, std::nullopt);
+  ASSERT_TRUE(pipeline);
+
+  auto buffer = HostBuffer::Create();
+  auto cmd = CreateFillCommand(pipeline, *buffer,
+                               {{-1, 1}, {1, 1}, {-1, -1}, {1, -1}},
+                               Color::Red());
+  cmd.primitive_type = PrimitiveType::kTriangleStrip;
+  cmd.scissor = IRect::MakeLTRB(50, 10, 150, 300);
+  // Scissors that miss the render target drop the command.
+  auto dropped = cmd;
+  dropped.scissor = IRect::MakeXYWH(200, 0, 10, 10);
+
+  ASSERT_TRUE(Render(*context, target, {cmd, dropped}));
+  ASSERT_EQ(ReadPixel(target, 50, 10), Color::Red());
+  ASSERT_EQ(ReadPixel(target, 149, 99), Color::Red());
+  ASSERT_EQ(ReadPixel(target, 49, 10), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(target, 150, 50), Color::BlackTransparent());
+  ASSERT_EQ(ReadPixel(target, 100, 9), Color::BlackTransparent());
+}
+
+TEST(SoftwareBackendTest, CanRenderWithGeneratedShaders) {
+  using VS = VertexColorVertexShader;
+  using FS = VertexColorFragmentShader;
+  auto context = ContextSW::Create(
+      {VS::GetNativeShaderSW(), FS::GetNativeShaderSW()}, 2u);
+  ASSERT_TRUE(context && context->IsValid());
+  auto target = RenderTarget::CreateOffscreen(*context, {16, 16});
+  ASSERT_TRUE(target.IsValid());
+  auto desc = PipelineBuilder<VS, FS>::MakeDefaultPipelineDescriptor(*context);
+  ASSERT_TRUE(desc.has_value());
+  auto pipeline = context->GetPipelineLibrary()->GetRenderPipeline(*desc).get();
+  ASSERT_TRUE(pipeline);
+
+  auto buffer = HostBuffer::Create();
+  VertexBufferBuilder<VS::PerVertexData> builder;
+  // The left half is red and the right half blue.
+  const Vector4 red = {1.0, 0.0, 0.0, 1.0};
+  const Vector4 blue = {0.0, 0.0, 1.0, 1.0};
+  builder.AddVertices({
+      {{0, 0}, red},
+      {{8, 0}, red},
+      {{0, 16}, red},
+      {{8, 0}, red},
+      {{8, 16}, red},
+      {{0, 16}, red},
+      {{8, 0}, blue},
+      {{16, 0}, blue},
+      {{8, 16}, blue},
+      {{16, 0}, blue},
+      {{16, 16}, blue},
+      {{8, 16}, blue},
+  });
+  Command cmd;
+  cmd.label = "Vertex Color";
+  cmd.pipeline = pipeline;
+  cmd.BindVertices(builder.CreateVertexBuffer(*buffer));
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(target.GetRenderTargetSize());
+  VS::BindFrameInfo(cmd, buffer->EmplaceUniform(frame_info));
+
+  ASSERT_TRUE(Render(*context, target, {cmd}));
+  ASSERT_EQ(ReadPixel(target, 2, 8), Color::Red());
+  ASSERT_EQ(ReadPixel(target, 12, 8), Color::Blue());
+}
+
+TEST(SoftwareBackendTest, RendererCollectsFrameStats) {
+  auto context = CreateTestContext(0u);
+  ASSERT_TRUE(context);
+  Renderer renderer(context);
+  ASSERT_TRUE(renderer.IsValid());
+  ASSERT_EQ(renderer.GetLastFrameStats().commands_recorded, 0u);
+
+  auto target = RenderTarget::CreateOffscreen(*context, {16, 16});
+  auto pipeline = CreateFillPipeline(*context, std::nullopt);
+  ASSERT_TRUE(pipeline);
+  ASSERT_TRUE(renderer.Render(
+      std::make_unique<TestSurface>(target), [&](RenderPass& pass) {
+        auto& buffer = pass.GetTransientsBuffer();
+        auto command = CreateFillCommand(pipeline, buffer,
+                                         {{-1, 1}, {1, 1}, {-1, -1}},
+                                         Color::Red());
+        // Invalid commands are rejected and not accounted for.
+        return pass.AddCommand(command) && pass.AddCommand(command) &&
+               !pass.AddCommand(Command{});
+      }));
+
+  const auto stats = renderer.GetLastFrameStats();
+  ASSERT_EQ(stats.commands_recorded, 2u);
+  ASSERT_EQ(stats.draw_calls, 2u);
+  ASSERT_EQ(stats.index_count, 6u);
+  ASSERT_EQ(stats.vertex_count, 6u);
+  // The vertices, indices and color of the command. Padding isn't counted.
+  ASSERT_EQ(stats.transient_bytes,
+            3u * sizeof(Point) + 3u * sizeof(uint32_t) + sizeof(Color));
+  ASSERT_EQ(stats.pipeline_switches, 1u);
+  ASSERT_EQ(stats.textures_bound, 0u);
+  // The transients buffer of the pass is uploaded into one device buffer.
+  ASSERT_EQ(stats.device_buffers_created, 1u);
+  ASSERT_EQ(stats.textures_created, 0u);
+  ASSERT_EQ(stats.offscreen_subpasses, 0u);
+  ASSERT_EQ(stats.command_buffers_submitted, 1u);
+  ASSERT_EQ(ReadPixel(target, 2, 2), Color::Red());
+}
+
+TEST(SoftwareBackendTest, CanCaptureAndReplayFrames) {
+  auto context = CreateTestContext(0u);
+  ASSERT_TRUE(context);
+  Renderer renderer(context);
+  ASSERT_TRUE(renderer.IsValid());
+
+  auto target = RenderTarget::CreateOffscreen(*context, {16, 16});
+  auto pipeline = CreateFillPipeline(*context, std::nullopt);
+  ASSERT_TRUE(pipeline);
+  auto capture = renderer.CaptureNextFrame();
+  ASSERT_TRUE(renderer.Render(
+      std::make_unique<TestSurface>(target), [&](RenderPass& pass) {
+        auto& buffer = pass.GetTransientsBuffer();
+        // Covers the top half of the target.
+        return pass.AddCommand(CreateFillCommand(pipeline, buffer,
+                                                 {
+                                                     {-1, 1},
+                                                     {1, 1},
+                                                     {-1, 0},
+                                                     {1, 1},
+                                                     {1, 0},
+                                                     {-1, 0},
+                                                 },
+                                                 Color::Blue()));
+      }));
+  ASSERT_EQ(capture->GetPasses().size(), 1u);
+  ASSERT_EQ(capture->GetPasses()[0].commands.size(), 1u);
+  ASSERT_EQ(capture->GetPipelines().size(), 1u);
+
+  // Subsequent frames are not captured.
+  ASSERT_TRUE(renderer.Render(std::make_unique<TestSurface>(target),
+                              [](RenderPass& pass) { return true; }));
+  ASSERT_EQ(capture->GetPasses().size(), 1u);
+
+  auto mapping = capture->CreateMapping();
+  ASSERT_TRUE(mapping);
+  auto decoded = FrameCapture::CreateFromMapping(*mapping);
+  ASSERT_TRUE(decoded);
+  ASSERT_FALSE(FrameCapture::CreateFromMapping(
+      fml::NonOwnedMapping(mapping->GetMapping(), mapping->GetSize() - 1u)));
+
+  // Out of range enum values are rejected. The stage of the first entrypoint
+  // follows the magic, version, pipeline count, label and sample count.
+  std::vector<uint8_t> corrupt(mapping->GetMapping(),
+                               mapping->GetMapping() + mapping->GetSize());
+  const auto stage_offset =
+      4u + 4u + 8u + 8u + decoded->GetPipelines()[0].label.size() + 8u + 8u;
+  corrupt[stage_offset] = 7u;
+  ASSERT_FALSE(FrameCapture::CreateFromMapping(
+      fml::NonOwnedMapping(corrupt.data(), corrupt.size())));
+
+  // Replay against an entirely different context.
+  FrameReplay replay(CreateTestContext(2u), decoded);
+  ASSERT_TRUE(replay.IsValid());
+  ASSERT_TRUE(replay.Replay());
+  const auto& color = decoded->GetPasses()[0].colors.at(0u);
+  auto replayed = RenderTarget{}.SetColorAttachment(
+      ColorAttachment{{replay.GetTexture(color.texture)}}, 0u);
+  ASSERT_EQ(ReadPixel(replayed, 8, 2), Color::Blue());
+  ASSERT_EQ(ReadPixel(replayed, 8, 13), Color::BlackTransparent());
+}
+
+TEST(SoftwareBackendTest, PipelineCacheEntriesOutliveTheProcess) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  const auto path = fml::paths::JoinPaths({temp_dir.path(), "pipelines.db"});
+  const std::string data = "compiled pipeline";
+  {
+    auto context = CreateTestContext(0u);
+    auto desc = CreateFillPipeline(*context, std::nullopt)->GetDescriptor();
+    PipelineCache cache(path);
+    ASSERT_TRUE(cache.IsValid());
+    ASSERT_FALSE(cache.Load(desc));
+    ASSERT_TRUE(cache.Store(
+        desc, fml::NonOwnedMapping(
+                  reinterpret_cast<const uint8_t*>(data.data()), data.size())));
+  }
+
+  // The shader functions of a new context have different identities. Labels
+  // don't matter either.
+  auto context = CreateTestContext(0u);
+  auto desc = CreateFillPipeline(*context, std::nullopt)->GetDescriptor();
+  desc.SetLabel("Another Fill Pipeline");
+  PipelineCache cache(path);
+  auto loaded = cache.Load(desc);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(loaded->GetMapping()),
+                        loaded->GetSize()),
+            data);
+
+  desc.SetSampleCount(SampleCount::kCount4);
+  ASSERT_FALSE(cache.Load(desc));
+  ASSERT_EQ(cache.GetHitCount(), 1u);
+  ASSERT_EQ(cache.GetMissCount(), 1u);
+}
+
+TEST(SoftwareBackendTest, PipelineCacheKeysDontDependOnAddresses) {
+  using VS = VertexColorVertexShader;
+  using FS = VertexColorFragmentShader;
+  auto context = ContextSW::Create(
+      {VS::GetNativeShaderSW(), FS::GetNativeShaderSW()}, 0u);
+  ASSERT_TRUE(context && context->IsValid());
+  auto desc = PipelineBuilder<VS, FS>::MakeDefaultPipelineDescriptor(*context);
+  ASSERT_TRUE(desc.has_value());
+  ASSERT_TRUE(desc->GetVertexDescriptor());
+
+  // Another process has the same slots with the names at other addresses.
+  auto copy_vertex_descriptor = [&desc](const std::string& suffix) {
+    const auto& inputs = desc->GetVertexDescriptor()->GetStageInputs();
+    auto names = std::make_shared<std::vector<std::string>>();
+    std::vector<ShaderStageIOSlot> slots;
+    for (const auto& input : inputs) {
+      names->push_back(std::string{input.name} + suffix);
+    }
+    for (size_t i = 0; i < inputs.size(); i++) {
+      auto slot = inputs[i];
+      slot.name = names->at(i).c_str();
+      slots.push_back(slot);
+    }
+    std::vector<const ShaderStageIOSlot*> slot_pointers;
+    for (const auto& slot : slots) {
+      slot_pointers.push_back(&slot);
+    }
+    auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+    FML_CHECK(vertex_descriptor->SetStageInputs(slot_pointers.data(),
+                                                slot_pointers.size()));
+    return std::make_pair(names, vertex_descriptor);
+  };
+
+  const auto [names, vertex_descriptor] = copy_vertex_descriptor("");
+  ASSERT_NE(vertex_descriptor->GetStageInputs()[0].name,
+            desc->GetVertexDescriptor()->GetStageInputs()[0].name);
+  auto copy = desc.value();
+  copy.SetVertexDescriptor(vertex_descriptor);
+  ASSERT_EQ(PipelineCache::GetKey(copy), PipelineCache::GetKey(desc.value()));
+
+  // Renamed inputs are different pipelines.
+  const auto [renamed_names, renamed] = copy_vertex_descriptor("_renamed");
+  copy.SetVertexDescriptor(renamed);
+  ASSERT_NE(PipelineCache::GetKey(copy), PipelineCache::GetKey(desc.value()));
+}
+
+static bool IsReady(const TextureUploadQueue::UploadFuture& future) {
+  return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+TEST(SoftwareBackendTest, TexturesAreUploadedOnFlush) {
+  auto context = CreateTestContext(0u);
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {4, 4};
+  auto texture = context->GetPermanentsAllocator()->CreateTexture(
+      StorageMode::kHostVisible, desc);
+  ASSERT_TRUE(texture);
+
+  TextureUploadQueue queue(context);
+  ASSERT_TRUE(queue.IsValid());
+
+  const std::vector<uint8_t> red = {
+      255, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255,  //
+      255, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255,  //
+      255, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255,  //
+      255, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255,  //
+  };
+  auto upload = queue.EnqueueUpload(texture, red.data(), red.size());
+  ASSERT_TRUE(upload.valid());
+  ASSERT_FALSE(IsReady(upload));
+  ASSERT_EQ(queue.GetPendingUploadCount(), 1u);
+
+  ASSERT_TRUE(queue.Flush());
+  ASSERT_TRUE(IsReady(upload));
+  ASSERT_TRUE(upload.get());
+  ASSERT_EQ(queue.GetPendingUploadCount(), 0u);
+  ASSERT_EQ(TextureSW::Cast(*texture).ReadPixel(3, 3), Color::Red());
+
+  // Sub-regions only overwrite the texels in the region.
+  const std::vector<uint8_t> green = {
+      0, 255, 0, 255, 0, 255, 0, 255,  //
+      0, 255, 0, 255, 0, 255, 0, 255,  //
+  };
+  upload = queue.EnqueueUpload(texture, green.data(), green.size(),
+                               IRect::MakeXYWH(1, 2, 2, 2));
+  ASSERT_TRUE(queue.Flush());
+  ASSERT_TRUE(upload.get());
+  ASSERT_EQ(TextureSW::Cast(*texture).ReadPixel(0, 2), Color::Red());
+  ASSERT_EQ(TextureSW::Cast(*texture).ReadPixel(1, 2), Color::Green());
+  ASSERT_EQ(TextureSW::Cast(*texture).ReadPixel(2, 3), Color::Green());
+  ASSERT_EQ(TextureSW::Cast(*texture).ReadPixel(3, 3), Color::Red());
+
+  // The staging buffer is reused once the previous upload has completed.
+  ASSERT_EQ(queue.GetStagingBuffersCreated(), 1u);
+
+  // Regions out of bounds and contents of the wrong size are rejected.
+  upload = queue.EnqueueUpload(texture, green.data(), green.size(),
+                               IRect::MakeXYWH(3, 3, 2, 2));
+  ASSERT_TRUE(IsReady(upload));
+  ASSERT_FALSE(upload.get());
+  upload = queue.EnqueueUpload(texture, green.data(), green.size());
+  ASSERT_FALSE(upload.get());
+  ASSERT_EQ(queue.GetPendingUploadCount(), 0u);
+}
+
+TEST(SoftwareBackendTest, PendingTextureUploadsFailWithTheQueue) {
+  auto context = CreateTestContext(0u);
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {1, 1};
+  auto texture = context->GetPermanentsAllocator()->CreateTexture(
+      StorageMode::kHostVisible, desc);
+  const uint8_t texel[] = {0, 0, 255, 255};
+  TextureUploadQueue::UploadFuture upload;
+  {
+    TextureUploadQueue queue(context);
+    upload = queue.EnqueueUpload(texture, texel, sizeof(texel));
+    ASSERT_FALSE(IsReady(upload));
+  }
+  ASSERT_TRUE(IsReady(upload));
+  ASSERT_FALSE(upload.get());
+}
+
+TEST(SoftwareBackendTest, TexturePoolRecyclesIdleTextures) {
+  auto context = CreateTestContext(0u);
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {10, 10};
+  const auto bucket_bytes = 64u * 64u * 4u;
+  TexturePool pool(context->GetPermanentsAllocator(), 2u * bucket_bytes);
+
+  auto a = pool.CreateTexture(StorageMode::kDevicePrivate, desc);
+  ASSERT_TRUE(a);
+  ASSERT_EQ(a->GetSize(), ISize(64, 64));
+  // Textures in use are never handed out twice.
+  auto b = pool.CreateTexture(StorageMode::kDevicePrivate, desc);
+  ASSERT_TRUE(b);
+  ASSERT_NE(a, b);
+  ASSERT_EQ(pool.GetTexturesCreated(), 2u);
+
+  // Idle textures in the same size bucket are reused.
+  auto a_texture = a.get();
+  a.reset();
+  desc.size = {12, 9};
+  a = pool.CreateTexture(StorageMode::kDevicePrivate, desc);
+  ASSERT_EQ(a.get(), a_texture);
+  ASSERT_EQ(pool.GetTexturesReused(), 1u);
+
+  // The storage mode is part of the key. The idle texture is evicted to keep
+  // the pool within its budget.
+  b.reset();
+  ASSERT_NE(pool.CreateTexture(StorageMode::kHostVisible, desc), nullptr);
+  ASSERT_EQ(pool.GetTexturesCreated(), 3u);
+  ASSERT_EQ(pool.GetTexturesEvicted(), 1u);
+  ASSERT_EQ(pool.GetPooledBytes(), 2u * bucket_bytes);
+
+  // Textures left idle are evicted after a few frames.
+  a.reset();
+  for (size_t i = 0; i <= TexturePool::kMaxUnusedFrames; i++) {
+    pool.EndFrame();
+  }
+  ASSERT_EQ(pool.GetPooledBytes(), 0u);
+  ASSERT_EQ(pool.GetTexturesEvicted(), 3u);
+
+  // Released textures are neither recycled nor accounted for.
+  auto released = pool.CreateTexture(StorageMode::kDevicePrivate, desc);
+  ASSERT_EQ(pool.GetPooledBytes(), bucket_bytes);
+  ASSERT_TRUE(pool.Release(released));
+  ASSERT_FALSE(pool.Release(released));
+  ASSERT_EQ(pool.GetPooledBytes(), 0u);
+  released.reset();
+  const auto reused = pool.GetTexturesReused();
+  ASSERT_TRUE(pool.CreateTexture(StorageMode::kDevicePrivate, desc));
+  ASSERT_EQ(pool.GetTexturesReused(), reused);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/software/texture_sw.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/software/device_buffer_sw.h"
+#include "impeller/renderer/backend/software/formats_sw.h"
+
+namespace impeller {
+
+TextureSW::TextureSW(TextureDescriptor p_desc,
+                     std::shared_ptr<const DeviceBufferSW> backing,
+                     size_t offset)
+    : Texture(std::move(p_desc)),
+      backing_(std::move(backing)),
+      offset_(offset) {
+  const auto& desc = GetTextureDescriptor();
+
+  if (!desc.IsValid() || !backing_) {
+    return;
+  }
+
+  if (offset_ + desc.GetSizeOfBaseMipLevel() > backing_->GetSize()) {
+    VALIDATION_LOG << "The texture backing store is too small for its "
+                      "descriptor.";
+    return;
+  }
+
+  is_valid_ = true;
+}
+
+TextureSW::~TextureSW() = default;
+
+void TextureSW::SetLabel(const std::string_view& label) {
+  label_ = {label.data(), label.size()};
+}
+
+bool TextureSW::OnSetContents(const uint8_t* contents, size_t length) {
+  if (!IsValid() || !contents) {
+    return false;
+  }
+
+  // Out of bounds access.
+  if (length != GetTextureDescriptor().GetSizeOfBaseMipLevel()) {
+    return false;
+  }
+
+  ::memmove(GetPixels(), contents, length);
+  return true;
+}
+
+bool TextureSW::GetContents(uint8_t* contents, size_t length) const {
+  if (!IsValid() || !contents) {
+    return false;
+  }
+
+  // Out of bounds access.
+  if (length != GetTextureDescriptor().GetSizeOfBaseMipLevel()) {
+    return false;
+  }
+
+  ::memmove(contents, GetPixels(), length);
+  return true;
+}
+
+bool TextureSW::IsValid() const {
+  return is_valid_;
+}
+
+ISize TextureSW::GetSize() const {
+  return GetTextureDescriptor().size;
+}
+
+uint8_t* TextureSW::GetPixels() const {
+  return backing_->GetContents() + offset_;
+}
+
+size_t TextureSW::GetBytesPerRow() const {
+  return GetTextureDescriptor().GetBytesPerRow();
+}
+
+Color TextureSW::ReadPixel(int64_t x, int64_t y) const {
+  const auto& desc = GetTextureDescriptor();
+  return ReadPixelSW(desc.format,
+                     GetPixels() + y * GetBytesPerRow() +
+                         x * BytesPerPixelForPixelFormat(desc.format));
+}
+
+static int64_t ApplyAddressMode(SamplerAddressMode mode,
+                                int64_t texel,
+                                int64_t size) {
+  switch (mode) {
+    case SamplerAddressMode::kClampToEdge:
+      return std::clamp<int64_t>(texel, 0, size - 1);
+    case SamplerAddressMode::kRepeat: {
+      const auto wrapped = texel % size;
+      return wrapped < 0 ? wrapped + size : wrapped;
+    }
+    case SamplerAddressMode::kMirror: {
+      const auto period = size * 2;
+      auto wrapped = texel % period;
+      wrapped = wrapped < 0 ? wrapped + period : wrapped;
+      return wrapped < size ? wrapped : period - 1 - wrapped;
+    }
+  }
+  return std::clamp<int64_t>(texel, 0, size - 1);
+}
+
+static Color Lerp(const Color& a, const Color& b, Scalar t) {
+  return {a.red + (b.red - a.red) * t,        //
+          a.green + (b.green - a.green) * t,  //
+          a.blue + (b.blue - a.blue) * t,     //
+          a.alpha + (b.alpha - a.alpha) * t};
+}
+
+Color TextureSW::Sample(Point uv, const SamplerDescriptor& sampler) const {
+  if (!IsValid()) {
+    return {};
+  }
+
+  const auto size = GetSize();
+  const auto texel = uv * Point{static_cast<Scalar>(size.width),
+                                static_cast<Scalar>(size.height)};
+
+  auto read = [&](int64_t x, int64_t y) {
+    return ReadPixel(
+        ApplyAddressMode(sampler.width_address_mode, x, size.width),
+        ApplyAddressMode(sampler.height_address_mode, y, size.height));
+  };
+
+  // Impeller does not generate mips yet. The texel footprint is not known here
+  // either so the magnification filter is always used.
+  if (sampler.mag_filter == MinMagFilter::kNearest) {
+    return read(static_cast<int64_t>(std::floor(texel.x)),
+                static_cast<int64_t>(std::floor(texel.y)));
+  }
+
+  const auto x = texel.x - 0.5f;
+  const auto y = texel.y - 0.5f;
+  const auto x0 = static_cast<int64_t>(std::floor(x));
+  const auto y0 = static_cast<int64_t>(std::floor(y));
+  const auto tx = x - x0;
+  const auto ty = y - y0;
+  return Lerp(Lerp(read(x0, y0), read(x0 + 1, y0), tx),
+              Lerp(read(x0, y0 + 1), read(x0 + 1, y0 + 1), tx), ty);
+}
+
+}  // namespace impeller
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/geometry/point.h"
+#include "impeller/renderer/sampler_descriptor.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+class DeviceBufferSW;
+
+//------------------------------------------------------------------------------
+/// @brief      A texture whose base mip level lives in host memory. The texels
+///             are tightly packed rows of the pixel format in the descriptor.
+///
+///             Multisample textures are stored (and rasterized) with a single
+///             sample per pixel. Only the base mip level is allocated.
+///
+class TextureSW final : public Texture,
+                        public BackendCast<TextureSW, Texture> {
+ public:
+  TextureSW(TextureDescriptor desc,
+            std::shared_ptr<const DeviceBufferSW> backing,
+            size_t offset);
+
+  // |Texture|
+  ~TextureSW() override;
+
+  // |Texture|
+  void SetLabel(const std::string_view& label) override;
+
+  // |Texture|
+  bool GetContents(uint8_t* contents, size_t length) const override;
+
+  // |Texture|
+  bool IsValid() const override;
+
+  // |Texture|
+  ISize GetSize() const override;
+
+  uint8_t* GetPixels() const;
+
+  size_t GetBytesPerRow() const;
+
+  Color ReadPixel(int64_t x, int64_t y) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sample the texture at the given normalized texture coordinate
+  ///             with the filtering and address modes of the sampler. The
+  ///             origin is the top-left corner of the texture.
+  ///
+  Color Sample(Point uv, const SamplerDescriptor& sampler) const;
+
+ private:
+  std::shared_ptr<const DeviceBufferSW> backing_;
+  const size_t offset_;
+  std::string label_;
+  bool is_valid_ = false;
+
+  // |Texture|
+  bool OnSetContents(const uint8_t* contents, size_t length) override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextureSW);
+};
+
+}  // namespace impeller
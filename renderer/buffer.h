@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace impeller {
@@ -17,6 +18,16 @@ class Buffer {
 
   virtual std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
       Allocator& allocator) const = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The contents of the buffer if they can be read directly from
+  ///             the host. This is used to capture frames for replay and is
+  ///             not meant to be used on the hot path.
+  ///
+  /// @return     The host visible contents or null if the buffer contents
+  ///             reside in device private memory.
+  ///
+  virtual const uint8_t* GetHostContents() const = 0;
 };
 
 }  // namespace impeller
@@ -6,10 +6,12 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/renderer/buffer_view.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/pipeline.h"
@@ -68,6 +70,17 @@ struct Command {
   PrimitiveType primitive_type = PrimitiveType::kTriangle;
   WindingOrder winding = WindingOrder::kClockwise;
   uint32_t stencil_reference = 0u;
+  //----------------------------------------------------------------------------
+  /// The region of the render target (in pixels) outside of which nothing is
+  /// drawn. The entire render target if absent.
+  ///
+  std::optional<IRect> scissor;
+  //----------------------------------------------------------------------------
+  /// The binding of the vertex stage uniform that starts with the model view
+  /// projection matrix, as reflected from the vertex shader. Only commands that
+  /// record it can be replayed with another transformation.
+  ///
+  std::optional<size_t> mvp_binding;
 
   bool BindVertices(const VertexBuffer& buffer);
 
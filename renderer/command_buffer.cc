@@ -4,6 +4,11 @@
 
 #include "impeller/renderer/command_buffer.h"
 
+#include "impeller/base/validation.h"
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/formats.h"
+#include "impeller/renderer/texture.h"
+
 namespace impeller {
 
 CommandBuffer::CommandBuffer() = default;
@@ -14,4 +19,38 @@ bool CommandBuffer::SubmitCommands() {
   return SubmitCommands(nullptr);
 }
 
+bool CommandBuffer::CopyBufferToTexture(
+    std::shared_ptr<const DeviceBuffer> source,
+    Range source_range,
+    std::shared_ptr<Texture> destination,
+    IRect region) {
+  if (!source || !destination || !destination->IsValid()) {
+    VALIDATION_LOG << "Invalid source or destination for texture copy.";
+    return false;
+  }
+
+  if (region.IsEmpty() ||
+      !(IRect::MakeSize(destination->GetSize()).Intersection(region) ==
+        region)) {
+    VALIDATION_LOG << "Texture copy region is out of bounds of the texture.";
+    return false;
+  }
+
+  const auto bytes_per_pixel = BytesPerPixelForPixelFormat(
+      destination->GetTextureDescriptor().format);
+  if (source_range.length !=
+      region.size.width * region.size.height * bytes_per_pixel) {
+    VALIDATION_LOG << "Texture copy source does not match the region size.";
+    return false;
+  }
+
+  auto& texture = *destination;
+  if (!OnCopyBufferToTexture(std::move(source), source_range,
+                             std::move(destination), region)) {
+    return false;
+  }
+  texture.MarkContentsModified();
+  return true;
+}
+
 }  // namespace impeller
@@ -8,12 +8,16 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/range.h"
 
 namespace impeller {
 
 class Context;
+class DeviceBuffer;
 class RenderPass;
 class RenderTarget;
+class Texture;
 
 //------------------------------------------------------------------------------
 /// @brief      A collection of encoded commands to be submitted to the GPU for
@@ -75,9 +79,38 @@ class CommandBuffer {
   virtual std::shared_ptr<RenderPass> CreateRenderPass(
       RenderTarget render_target) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Encode a copy of tightly packed texels in a host visible
+  ///             buffer into a region of the base mip level of a texture.
+  ///             Copies are usually encoded into command buffers obtained via
+  ///             `Context::CreateTransferCommandBuffer`.
+  ///
+  ///             The copy is ordered with respect to the render passes in this
+  ///             command buffer by the time at which it was encoded.
+  ///
+  /// @param[in]  source        The buffer containing the texels.
+  /// @param[in]  source_range  The range of the texels in the source. This
+  ///                           must be exactly the size of the region.
+  /// @param[in]  destination   The texture to copy into.
+  /// @param[in]  region        The region of the texture to overwrite.
+  ///
+  /// @return     If the copy could be encoded.
+  ///
+  [[nodiscard]] bool CopyBufferToTexture(
+      std::shared_ptr<const DeviceBuffer> source,
+      Range source_range,
+      std::shared_ptr<Texture> destination,
+      IRect region);
+
  protected:
   CommandBuffer();
 
+  virtual bool OnCopyBufferToTexture(
+      std::shared_ptr<const DeviceBuffer> source,
+      Range source_range,
+      std::shared_ptr<Texture> destination,
+      IRect region) = 0;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(CommandBuffer);
 };
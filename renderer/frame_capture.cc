@@ -0,0 +1,926 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/frame_capture.h"
+
+#include <cstring>
+#include <type_traits>
+
+#include "impeller/base/validation.h"
+#include "impeller/renderer/buffer.h"
+#include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/sampler.h"
+#include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/texture.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+// "IMPC" in little endian.
+static constexpr uint32_t kCaptureMagic = 0x43504d49;
+static constexpr uint32_t kCaptureVersion = 3u;
+
+FrameCapture::FrameCapture() = default;
+
+FrameCapture::~FrameCapture() = default;
+
+const std::vector<FrameCapture::PipelineInfo>& FrameCapture::GetPipelines()
+    const {
+  return pipelines_;
+}
+
+const std::vector<FrameCapture::TextureInfo>& FrameCapture::GetTextures()
+    const {
+  return textures_;
+}
+
+const std::vector<SamplerDescriptor>& FrameCapture::GetSamplers() const {
+  return samplers_;
+}
+
+const std::vector<std::vector<uint8_t>>& FrameCapture::GetBuffers() const {
+  return buffers_;
+}
+
+const std::vector<FrameCapture::PassInfo>& FrameCapture::GetPasses() const {
+  return passes_;
+}
+
+size_t FrameCapture::RecordPipeline(const std::shared_ptr<Pipeline>& pipeline) {
+  if (!pipeline) {
+    return kInvalidIndex;
+  }
+  if (auto found = pipeline_indices_.find(pipeline);
+      found != pipeline_indices_.end()) {
+    return found->second;
+  }
+
+  const auto& desc = pipeline->GetDescriptor();
+  PipelineInfo info;
+  info.label = desc.GetLabel();
+  info.sample_count = desc.GetSampleCount();
+  for (const auto& [stage, function] : desc.GetStageEntrypoints()) {
+    info.entrypoints.emplace_back(stage, function->GetName());
+  }
+  if (const auto& vertex_desc = desc.GetVertexDescriptor()) {
+    for (const auto& input : vertex_desc->GetStageInputs()) {
+      StageInput stage_input;
+      stage_input.name = input.name ? input.name : "";
+      stage_input.location = input.location;
+      stage_input.set = input.set;
+      stage_input.binding = input.binding;
+      stage_input.type = input.type;
+      stage_input.bit_width = input.bit_width;
+      stage_input.vec_size = input.vec_size;
+      stage_input.columns = input.columns;
+      info.stage_inputs.emplace_back(std::move(stage_input));
+    }
+  }
+  info.color_attachments = desc.GetColorAttachmentDescriptors();
+  info.depth_format = desc.GetDepthPixelFormat();
+  info.stencil_format = desc.GetStencilPixelFormat();
+  info.depth = desc.GetDepthStencilAttachmentDescriptor();
+  info.front_stencil = desc.GetFrontStencilAttachmentDescriptor();
+  info.back_stencil = desc.GetBackStencilAttachmentDescriptor();
+
+  const auto index = pipelines_.size();
+  pipelines_.emplace_back(std::move(info));
+  pipeline_indices_[pipeline] = index;
+  return index;
+}
+
+size_t FrameCapture::RecordTexture(
+    const std::shared_ptr<const Texture>& texture,
+    bool read_contents) {
+  if (!texture) {
+    return kInvalidIndex;
+  }
+  if (auto found = texture_indices_.find(texture);
+      found != texture_indices_.end()) {
+    return found->second;
+  }
+
+  TextureInfo info;
+  info.desc = texture->GetTextureDescriptor();
+  if (read_contents) {
+    info.contents.resize(info.desc.GetSizeOfBaseMipLevel());
+    if (!texture->GetContents(info.contents.data(), info.contents.size())) {
+      info.contents.clear();
+    }
+  }
+
+  const auto index = textures_.size();
+  textures_.emplace_back(std::move(info));
+  texture_indices_[texture] = index;
+  return index;
+}
+
+size_t FrameCapture::RecordSampler(
+    const std::shared_ptr<const Sampler>& sampler) {
+  if (!sampler) {
+    return kInvalidIndex;
+  }
+  if (auto found = sampler_indices_.find(sampler);
+      found != sampler_indices_.end()) {
+    return found->second;
+  }
+
+  const auto index = samplers_.size();
+  samplers_.push_back(sampler->GetDescriptor());
+  sampler_indices_[sampler] = index;
+  return index;
+}
+
+size_t FrameCapture::RecordBuffer(const BufferView& view) {
+  if (!view) {
+    return kInvalidIndex;
+  }
+  BufferKey key = {view.buffer, view.range.offset, view.range.length};
+  if (auto found = buffer_indices_.find(key); found != buffer_indices_.end()) {
+    return found->second;
+  }
+
+  std::vector<uint8_t> contents(view.range.length, 0u);
+  if (auto host_contents = view.buffer->GetHostContents()) {
+    ::memcpy(contents.data(), host_contents + view.range.offset,
+             view.range.length);
+  }
+
+  const auto index = buffers_.size();
+  buffers_.emplace_back(std::move(contents));
+  buffer_indices_[std::move(key)] = index;
+  return index;
+}
+
+FrameCapture::BindingsInfo FrameCapture::RecordBindings(
+    const Bindings& bindings) {
+  BindingsInfo info;
+  for (const auto& [slot, view] : bindings.buffers) {
+    info.buffers[slot] = RecordBuffer(view);
+  }
+  for (const auto& [slot, texture] : bindings.textures) {
+    info.textures[slot] = RecordTexture(texture, true);
+  }
+  for (const auto& [slot, sampler] : bindings.samplers) {
+    info.samplers[slot] = RecordSampler(sampler);
+  }
+  return info;
+}
+
+FrameCapture::AttachmentInfo FrameCapture::RecordAttachment(
+    const Attachment& attachment) {
+  AttachmentInfo info;
+  // Attachments with loaded contents need them for a faithful replay.
+  const auto read_contents = attachment.load_action == LoadAction::kLoad;
+  info.texture = RecordTexture(attachment.texture, read_contents);
+  info.resolve_texture = RecordTexture(attachment.resolve_texture, false);
+  info.load_action = attachment.load_action;
+  info.store_action = attachment.store_action;
+  return info;
+}
+
+void FrameCapture::RecordPass(const RenderTarget& target,
+                              const std::vector<Command>& commands) {
+  std::scoped_lock lock(mutex_);
+
+  PassInfo pass;
+  for (const auto& [index, color] : target.GetColorAttachments()) {
+    auto info = RecordAttachment(color);
+    info.clear_color = color.clear_color;
+    pass.colors[index] = info;
+  }
+  if (const auto& depth = target.GetDepthAttachment(); depth.has_value()) {
+    auto info = RecordAttachment(depth.value());
+    info.clear_depth = depth->clear_depth;
+    pass.depth = info;
+  }
+  if (const auto& stencil = target.GetStencilAttachment();
+      stencil.has_value()) {
+    auto info = RecordAttachment(stencil.value());
+    info.clear_stencil = stencil->clear_stencil;
+    pass.stencil = info;
+  }
+
+  for (const auto& command : commands) {
+    CommandInfo info;
+    info.label = command.label;
+    info.pipeline = RecordPipeline(command.pipeline);
+    info.vertex_bindings = RecordBindings(command.vertex_bindings);
+    info.fragment_bindings = RecordBindings(command.fragment_bindings);
+    info.index_buffer = RecordBuffer(command.index_buffer);
+    info.index_count = command.index_count;
+    info.primitive_type = command.primitive_type;
+    info.winding = command.winding;
+    info.stencil_reference = command.stencil_reference;
+    info.scissor = command.scissor;
+    pass.commands.emplace_back(std::move(info));
+  }
+
+  passes_.emplace_back(std::move(pass));
+}
+
+namespace {
+
+// Values are written field by field so that neither struct padding nor the
+// layout of the structs in memory ends up in the capture.
+class CaptureWriter {
+ public:
+  template <class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+  void Write(T value) {
+    Write(&value, sizeof(T));
+  }
+
+  template <class T, class = std::enable_if_t<std::is_enum_v<T>>>
+  void WriteEnum(T value) {
+    Write(static_cast<uint64_t>(value));
+  }
+
+  void Write(const void* data, size_t length) {
+    const auto offset = data_.size();
+    data_.resize(offset + length);
+    if (length > 0u) {
+      ::memcpy(data_.data() + offset, data, length);
+    }
+  }
+
+  void WriteSize(size_t size) { Write(static_cast<uint64_t>(size)); }
+
+  void WriteString(const std::string& string) {
+    WriteSize(string.size());
+    Write(string.data(), string.size());
+  }
+
+  void WriteBytes(const std::vector<uint8_t>& bytes) {
+    WriteSize(bytes.size());
+    Write(bytes.data(), bytes.size());
+  }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+class CaptureReader {
+ public:
+  CaptureReader(const uint8_t* data, size_t length)
+      : data_(data), length_(length) {}
+
+  template <class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+  [[nodiscard]] bool Read(T& value) {
+    return Read(&value, sizeof(T));
+  }
+
+  [[nodiscard]] bool Read(bool& value) {
+    uint8_t raw = 0u;
+    if (!Read(raw)) {
+      return false;
+    }
+    if (raw > 1u) {
+      VALIDATION_LOG << "Frame capture contains an invalid boolean.";
+      return false;
+    }
+    value = raw == 1u;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads an enum value written by `CaptureWriter::WriteEnum`
+  ///             and checks that it is in the contiguous range from zero to
+  ///             `last`.
+  ///
+  template <class T, class = std::enable_if_t<std::is_enum_v<T>>>
+  [[nodiscard]] bool ReadEnum(T& value, T last) {
+    uint64_t raw = 0u;
+    if (!Read(raw)) {
+      return false;
+    }
+    if (raw > static_cast<uint64_t>(last)) {
+      VALIDATION_LOG << "Frame capture contains an out of range value " << raw
+                     << ".";
+      return false;
+    }
+    value = static_cast<T>(raw);
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads a bitmask and checks that no bits outside of `valid`
+  ///             are set.
+  ///
+  [[nodiscard]] bool ReadMask(uint64_t& value, uint64_t valid) {
+    if (!Read(value)) {
+      return false;
+    }
+    if ((value & ~valid) != 0u) {
+      VALIDATION_LOG << "Frame capture contains an invalid mask " << value
+                     << ".";
+      return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool Read(void* data, size_t length) {
+    if (length > length_ - offset_) {
+      return false;
+    }
+    if (length > 0u) {
+      ::memcpy(data, data_ + offset_, length);
+    }
+    offset_ += length;
+    return true;
+  }
+
+  [[nodiscard]] bool ReadSize(size_t& size) {
+    uint64_t value = 0u;
+    if (!Read(value)) {
+      return false;
+    }
+    size = static_cast<size_t>(value);
+    return true;
+  }
+
+  [[nodiscard]] bool ReadString(std::string& string) {
+    size_t size = 0u;
+    if (!ReadSize(size) || size > length_ - offset_) {
+      return false;
+    }
+    string.assign(reinterpret_cast<const char*>(data_ + offset_), size);
+    offset_ += size;
+    return true;
+  }
+
+  [[nodiscard]] bool ReadBytes(std::vector<uint8_t>& bytes) {
+    size_t size = 0u;
+    if (!ReadSize(size) || size > length_ - offset_) {
+      return false;
+    }
+    bytes.assign(data_ + offset_, data_ + offset_ + size);
+    offset_ += size;
+    return true;
+  }
+
+  bool IsAtEnd() const { return offset_ == length_; }
+
+ private:
+  const uint8_t* data_ = nullptr;
+  const size_t length_ = 0u;
+  size_t offset_ = 0u;
+};
+
+}  // namespace
+
+static constexpr uint64_t kValidTextureUsage =
+    static_cast<TextureUsageMask>(TextureUsage::kShaderRead) |
+    static_cast<TextureUsageMask>(TextureUsage::kShaderWrite) |
+    static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+
+static bool ReadSampleCount(CaptureReader& reader, SampleCount& sample_count) {
+  if (!reader.ReadEnum(sample_count, SampleCount::kCount4)) {
+    return false;
+  }
+  if (sample_count != SampleCount::kCount1 &&
+      sample_count != SampleCount::kCount4) {
+    VALIDATION_LOG << "Frame capture contains an invalid sample count.";
+    return false;
+  }
+  return true;
+}
+
+static void WriteValue(CaptureWriter& writer, const Color& color) {
+  writer.Write(color.red);
+  writer.Write(color.green);
+  writer.Write(color.blue);
+  writer.Write(color.alpha);
+}
+
+static bool ReadValue(CaptureReader& reader, Color& color) {
+  return reader.Read(color.red) && reader.Read(color.green) &&
+         reader.Read(color.blue) && reader.Read(color.alpha);
+}
+
+static void WriteValue(CaptureWriter& writer, const IRect& rect) {
+  writer.Write(rect.origin.x);
+  writer.Write(rect.origin.y);
+  writer.Write(rect.size.width);
+  writer.Write(rect.size.height);
+}
+
+static bool ReadValue(CaptureReader& reader, IRect& rect) {
+  return reader.Read(rect.origin.x) && reader.Read(rect.origin.y) &&
+         reader.Read(rect.size.width) && reader.Read(rect.size.height);
+}
+
+static void WriteValue(CaptureWriter& writer, const TextureDescriptor& desc) {
+  writer.WriteEnum(desc.type);
+  writer.WriteEnum(desc.format);
+  writer.Write(desc.size.width);
+  writer.Write(desc.size.height);
+  writer.WriteSize(desc.mip_count);
+  writer.Write(desc.usage);
+  writer.WriteEnum(desc.sample_count);
+}
+
+static bool ReadValue(CaptureReader& reader, TextureDescriptor& desc) {
+  return reader.ReadEnum(desc.type, TextureType::kTexture2DMultisample) &&
+         reader.ReadEnum(desc.format, PixelFormat::kS8UInt) &&
+         reader.Read(desc.size.width) && reader.Read(desc.size.height) &&
+         reader.ReadSize(desc.mip_count) &&
+         reader.ReadMask(desc.usage, kValidTextureUsage) &&
+         ReadSampleCount(reader, desc.sample_count);
+}
+
+static void WriteValue(CaptureWriter& writer,
+                       const ColorAttachmentDescriptor& desc) {
+  writer.WriteEnum(desc.format);
+  writer.Write(desc.blending_enabled);
+  writer.WriteEnum(desc.src_color_blend_factor);
+  writer.WriteEnum(desc.color_blend_op);
+  writer.WriteEnum(desc.dst_color_blend_factor);
+  writer.WriteEnum(desc.src_alpha_blend_factor);
+  writer.WriteEnum(desc.alpha_blend_op);
+  writer.WriteEnum(desc.dst_alpha_blend_factor);
+  writer.Write(desc.write_mask);
+}
+
+static bool ReadValue(CaptureReader& reader, ColorAttachmentDescriptor& desc) {
+  constexpr auto kLastFactor = BlendFactor::kOneMinusBlendAlpha;
+  constexpr auto kLastOperation = BlendOperation::kMax;
+  return reader.ReadEnum(desc.format, PixelFormat::kS8UInt) &&
+         reader.Read(desc.blending_enabled) &&
+         reader.ReadEnum(desc.src_color_blend_factor, kLastFactor) &&
+         reader.ReadEnum(desc.color_blend_op, kLastOperation) &&
+         reader.ReadEnum(desc.dst_color_blend_factor, kLastFactor) &&
+         reader.ReadEnum(desc.src_alpha_blend_factor, kLastFactor) &&
+         reader.ReadEnum(desc.alpha_blend_op, kLastOperation) &&
+         reader.ReadEnum(desc.dst_alpha_blend_factor, kLastFactor) &&
+         reader.ReadMask(desc.write_mask,
+                         static_cast<uint64_t>(ColorWriteMask::kAll));
+}
+
+static void WriteValue(CaptureWriter& writer,
+                       const DepthAttachmentDescriptor& desc) {
+  writer.WriteEnum(desc.depth_compare);
+  writer.Write(desc.depth_write_enabled);
+}
+
+static bool ReadValue(CaptureReader& reader, DepthAttachmentDescriptor& desc) {
+  return reader.ReadEnum(desc.depth_compare, CompareFunction::kGreaterEqual) &&
+         reader.Read(desc.depth_write_enabled);
+}
+
+static void WriteValue(CaptureWriter& writer,
+                       const StencilAttachmentDescriptor& desc) {
+  writer.WriteEnum(desc.stencil_compare);
+  writer.WriteEnum(desc.stencil_failure);
+  writer.WriteEnum(desc.depth_failure);
+  writer.WriteEnum(desc.depth_stencil_pass);
+  writer.Write(desc.read_mask);
+  writer.Write(desc.write_mask);
+}
+
+static bool ReadValue(CaptureReader& reader,
+                      StencilAttachmentDescriptor& desc) {
+  constexpr auto kLastOperation = StencilOperation::kDecrementWrap;
+  return reader.ReadEnum(desc.stencil_compare,
+                         CompareFunction::kGreaterEqual) &&
+         reader.ReadEnum(desc.stencil_failure, kLastOperation) &&
+         reader.ReadEnum(desc.depth_failure, kLastOperation) &&
+         reader.ReadEnum(desc.depth_stencil_pass, kLastOperation) &&
+         reader.Read(desc.read_mask) && reader.Read(desc.write_mask);
+}
+
+static void WriteBindings(CaptureWriter& writer,
+                          const FrameCapture::BindingsInfo& bindings) {
+  for (const auto* map :
+       {&bindings.buffers, &bindings.textures, &bindings.samplers}) {
+    writer.WriteSize(map->size());
+    for (const auto& [slot, index] : *map) {
+      writer.WriteSize(slot);
+      writer.WriteSize(index);
+    }
+  }
+}
+
+static bool ReadBindings(CaptureReader& reader,
+                         FrameCapture::BindingsInfo& bindings) {
+  for (auto* map :
+       {&bindings.buffers, &bindings.textures, &bindings.samplers}) {
+    size_t count = 0u;
+    if (!reader.ReadSize(count)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      size_t slot = 0u, index = 0u;
+      if (!reader.ReadSize(slot) || !reader.ReadSize(index)) {
+        return false;
+      }
+      (*map)[slot] = index;
+    }
+  }
+  return true;
+}
+
+static void WriteAttachment(CaptureWriter& writer,
+                            const FrameCapture::AttachmentInfo& attachment) {
+  writer.WriteSize(attachment.texture);
+  writer.WriteSize(attachment.resolve_texture);
+  writer.WriteEnum(attachment.load_action);
+  writer.WriteEnum(attachment.store_action);
+  WriteValue(writer, attachment.clear_color);
+  writer.Write(attachment.clear_depth);
+  writer.Write(attachment.clear_stencil);
+}
+
+static bool ReadAttachment(CaptureReader& reader,
+                           FrameCapture::AttachmentInfo& attachment) {
+  return reader.ReadSize(attachment.texture) &&
+         reader.ReadSize(attachment.resolve_texture) &&
+         reader.ReadEnum(attachment.load_action, LoadAction::kClear) &&
+         reader.ReadEnum(attachment.store_action,
+                         StoreAction::kMultisampleResolve) &&
+         ReadValue(reader, attachment.clear_color) &&
+         reader.Read(attachment.clear_depth) &&
+         reader.Read(attachment.clear_stencil);
+}
+
+template <class T>
+static void WriteOptional(CaptureWriter& writer,
+                          const std::optional<T>& value) {
+  writer.Write(value.has_value());
+  if (value.has_value()) {
+    WriteValue(writer, value.value());
+  }
+}
+
+template <class T>
+static bool ReadOptional(CaptureReader& reader, std::optional<T>& value) {
+  bool has_value = false;
+  if (!reader.Read(has_value)) {
+    return false;
+  }
+  if (!has_value) {
+    value = std::nullopt;
+    return true;
+  }
+  T read_value;
+  if (!ReadValue(reader, read_value)) {
+    return false;
+  }
+  value = read_value;
+  return true;
+}
+
+std::shared_ptr<fml::Mapping> FrameCapture::CreateMapping() const {
+  std::scoped_lock lock(mutex_);
+
+  CaptureWriter writer;
+  writer.Write(kCaptureMagic);
+  writer.Write(kCaptureVersion);
+
+  writer.WriteSize(pipelines_.size());
+  for (const auto& pipeline : pipelines_) {
+    writer.WriteString(pipeline.label);
+    writer.WriteEnum(pipeline.sample_count);
+    writer.WriteSize(pipeline.entrypoints.size());
+    for (const auto& [stage, name] : pipeline.entrypoints) {
+      writer.WriteEnum(stage);
+      writer.WriteString(name);
+    }
+    writer.WriteSize(pipeline.stage_inputs.size());
+    for (const auto& input : pipeline.stage_inputs) {
+      writer.WriteString(input.name);
+      writer.WriteSize(input.location);
+      writer.WriteSize(input.set);
+      writer.WriteSize(input.binding);
+      writer.WriteEnum(input.type);
+      writer.WriteSize(input.bit_width);
+      writer.WriteSize(input.vec_size);
+      writer.WriteSize(input.columns);
+    }
+    writer.WriteSize(pipeline.color_attachments.size());
+    for (const auto& [index, color] : pipeline.color_attachments) {
+      writer.WriteSize(index);
+      WriteValue(writer, color);
+    }
+    writer.WriteEnum(pipeline.depth_format);
+    writer.WriteEnum(pipeline.stencil_format);
+    WriteOptional(writer, pipeline.depth);
+    WriteOptional(writer, pipeline.front_stencil);
+    WriteOptional(writer, pipeline.back_stencil);
+  }
+
+  writer.WriteSize(textures_.size());
+  for (const auto& texture : textures_) {
+    WriteValue(writer, texture.desc);
+    writer.WriteBytes(texture.contents);
+  }
+
+  writer.WriteSize(samplers_.size());
+  for (const auto& sampler : samplers_) {
+    writer.WriteEnum(sampler.min_filter);
+    writer.WriteEnum(sampler.mag_filter);
+    writer.WriteEnum(sampler.width_address_mode);
+    writer.WriteEnum(sampler.height_address_mode);
+    writer.WriteEnum(sampler.depth_address_mode);
+  }
+
+  writer.WriteSize(buffers_.size());
+  for (const auto& buffer : buffers_) {
+    writer.WriteBytes(buffer);
+  }
+
+  writer.WriteSize(passes_.size());
+  for (const auto& pass : passes_) {
+    writer.WriteSize(pass.colors.size());
+    for (const auto& [index, color] : pass.colors) {
+      writer.WriteSize(index);
+      WriteAttachment(writer, color);
+    }
+    writer.Write(pass.depth.has_value());
+    if (pass.depth.has_value()) {
+      WriteAttachment(writer, pass.depth.value());
+    }
+    writer.Write(pass.stencil.has_value());
+    if (pass.stencil.has_value()) {
+      WriteAttachment(writer, pass.stencil.value());
+    }
+    writer.WriteSize(pass.commands.size());
+    for (const auto& command : pass.commands) {
+      writer.WriteString(command.label);
+      writer.WriteSize(command.pipeline);
+      WriteBindings(writer, command.vertex_bindings);
+      WriteBindings(writer, command.fragment_bindings);
+      writer.WriteSize(command.index_buffer);
+      writer.WriteSize(command.index_count);
+      writer.WriteEnum(command.primitive_type);
+      writer.WriteEnum(command.winding);
+      writer.Write(command.stencil_reference);
+      WriteOptional(writer, command.scissor);
+    }
+  }
+
+  return std::make_shared<fml::DataMapping>(writer.TakeData());
+}
+
+static bool IsValidIndex(size_t index, size_t count) {
+  return index == FrameCapture::kInvalidIndex || index < count;
+}
+
+static bool ValidateBindings(const FrameCapture::BindingsInfo& bindings,
+                             const FrameCapture& capture) {
+  for (const auto& [slot, index] : bindings.buffers) {
+    if (!IsValidIndex(index, capture.GetBuffers().size())) {
+      return false;
+    }
+  }
+  for (const auto& [slot, index] : bindings.textures) {
+    if (!IsValidIndex(index, capture.GetTextures().size())) {
+      return false;
+    }
+  }
+  for (const auto& [slot, index] : bindings.samplers) {
+    if (!IsValidIndex(index, capture.GetSamplers().size())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<FrameCapture> FrameCapture::CreateFromMapping(
+    const fml::Mapping& mapping) {
+  CaptureReader reader(mapping.GetMapping(), mapping.GetSize());
+
+  uint32_t magic = 0u, version = 0u;
+  if (!reader.Read(magic) || magic != kCaptureMagic) {
+    VALIDATION_LOG << "Mapping is not a frame capture.";
+    return nullptr;
+  }
+  if (!reader.Read(version) || version != kCaptureVersion) {
+    VALIDATION_LOG << "Unsupported frame capture version " << version << ".";
+    return nullptr;
+  }
+
+  auto capture = std::make_shared<FrameCapture>();
+
+  auto read_pipelines = [&]() -> bool {
+    size_t count = 0u;
+    if (!reader.ReadSize(count)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      PipelineInfo pipeline;
+      size_t entrypoint_count = 0u;
+      if (!reader.ReadString(pipeline.label) ||
+          !ReadSampleCount(reader, pipeline.sample_count) ||
+          !reader.ReadSize(entrypoint_count)) {
+        return false;
+      }
+      for (size_t j = 0; j < entrypoint_count; j++) {
+        ShaderStage stage = ShaderStage::kUnknown;
+        std::string name;
+        if (!reader.ReadEnum(stage, ShaderStage::kFragment) ||
+            !reader.ReadString(name)) {
+          return false;
+        }
+        pipeline.entrypoints.emplace_back(stage, std::move(name));
+      }
+      size_t input_count = 0u;
+      if (!reader.ReadSize(input_count)) {
+        return false;
+      }
+      for (size_t j = 0; j < input_count; j++) {
+        StageInput input;
+        if (!reader.ReadString(input.name) ||
+            !reader.ReadSize(input.location) || !reader.ReadSize(input.set) ||
+            !reader.ReadSize(input.binding) ||
+            !reader.ReadEnum(input.type, ShaderType::kSampler) ||
+            !reader.ReadSize(input.bit_width) ||
+            !reader.ReadSize(input.vec_size) ||
+            !reader.ReadSize(input.columns)) {
+          return false;
+        }
+        pipeline.stage_inputs.emplace_back(std::move(input));
+      }
+      size_t color_count = 0u;
+      if (!reader.ReadSize(color_count)) {
+        return false;
+      }
+      for (size_t j = 0; j < color_count; j++) {
+        size_t index = 0u;
+        ColorAttachmentDescriptor color;
+        if (!reader.ReadSize(index) || !ReadValue(reader, color)) {
+          return false;
+        }
+        pipeline.color_attachments[index] = color;
+      }
+      if (!reader.ReadEnum(pipeline.depth_format, PixelFormat::kS8UInt) ||
+          !reader.ReadEnum(pipeline.stencil_format, PixelFormat::kS8UInt) ||
+          !ReadOptional(reader, pipeline.depth) ||
+          !ReadOptional(reader, pipeline.front_stencil) ||
+          !ReadOptional(reader, pipeline.back_stencil)) {
+        return false;
+      }
+      capture->pipelines_.emplace_back(std::move(pipeline));
+    }
+    return true;
+  };
+
+  auto read_textures = [&]() -> bool {
+    size_t count = 0u;
+    if (!reader.ReadSize(count)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      TextureInfo texture;
+      if (!ReadValue(reader, texture.desc) ||
+          !reader.ReadBytes(texture.contents)) {
+        return false;
+      }
+      if (!texture.contents.empty() &&
+          texture.contents.size() != texture.desc.GetSizeOfBaseMipLevel()) {
+        return false;
+      }
+      capture->textures_.emplace_back(std::move(texture));
+    }
+    return true;
+  };
+
+  auto read_samplers = [&]() -> bool {
+    size_t count = 0u;
+    if (!reader.ReadSize(count)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      SamplerDescriptor sampler;
+      constexpr auto kLastFilter = MinMagFilter::kLinear;
+      constexpr auto kLastMode = SamplerAddressMode::kMirror;
+      if (!reader.ReadEnum(sampler.min_filter, kLastFilter) ||
+          !reader.ReadEnum(sampler.mag_filter, kLastFilter) ||
+          !reader.ReadEnum(sampler.width_address_mode, kLastMode) ||
+          !reader.ReadEnum(sampler.height_address_mode, kLastMode) ||
+          !reader.ReadEnum(sampler.depth_address_mode, kLastMode)) {
+        return false;
+      }
+      capture->samplers_.emplace_back(std::move(sampler));
+    }
+    return true;
+  };
+
+  auto read_buffers = [&]() -> bool {
+    size_t count = 0u;
+    if (!reader.ReadSize(count)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      std::vector<uint8_t> buffer;
+      if (!reader.ReadBytes(buffer)) {
+        return false;
+      }
+      capture->buffers_.emplace_back(std::move(buffer));
+    }
+    return true;
+  };
+
+  auto read_passes = [&]() -> bool {
+    size_t count = 0u;
+    if (!reader.ReadSize(count)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      PassInfo pass;
+      size_t color_count = 0u;
+      if (!reader.ReadSize(color_count)) {
+        return false;
+      }
+      for (size_t j = 0; j < color_count; j++) {
+        size_t index = 0u;
+        AttachmentInfo color;
+        if (!reader.ReadSize(index) || !ReadAttachment(reader, color)) {
+          return false;
+        }
+        pass.colors[index] = color;
+      }
+      for (auto* attachment : {&pass.depth, &pass.stencil}) {
+        bool has_attachment = false;
+        if (!reader.Read(has_attachment)) {
+          return false;
+        }
+        if (has_attachment) {
+          AttachmentInfo info;
+          if (!ReadAttachment(reader, info)) {
+            return false;
+          }
+          *attachment = info;
+        }
+      }
+      size_t command_count = 0u;
+      if (!reader.ReadSize(command_count)) {
+        return false;
+      }
+      for (size_t j = 0; j < command_count; j++) {
+        CommandInfo command;
+        if (!reader.ReadString(command.label) ||
+            !reader.ReadSize(command.pipeline) ||
+            !ReadBindings(reader, command.vertex_bindings) ||
+            !ReadBindings(reader, command.fragment_bindings) ||
+            !reader.ReadSize(command.index_buffer) ||
+            !reader.ReadSize(command.index_count) ||
+            !reader.ReadEnum(command.primitive_type, PrimitiveType::kPoint) ||
+            !reader.ReadEnum(command.winding,
+                             WindingOrder::kCounterClockwise) ||
+            !reader.Read(command.stencil_reference) ||
+            !ReadOptional(reader, command.scissor)) {
+          return false;
+        }
+        pass.commands.emplace_back(std::move(command));
+      }
+      capture->passes_.emplace_back(std::move(pass));
+    }
+    return true;
+  };
+
+  if (!read_pipelines() || !read_textures() || !read_samplers() ||
+      !read_buffers() || !read_passes() || !reader.IsAtEnd()) {
+    VALIDATION_LOG << "Frame capture was truncated or corrupt.";
+    return nullptr;
+  }
+
+  // Make sure all references are in bounds so that replays don't have to
+  // check.
+  const auto texture_count = capture->textures_.size();
+  for (const auto& pass : capture->passes_) {
+    std::vector<const AttachmentInfo*> attachments;
+    for (const auto& [index, color] : pass.colors) {
+      attachments.push_back(&color);
+    }
+    if (pass.depth.has_value()) {
+      attachments.push_back(&pass.depth.value());
+    }
+    if (pass.stencil.has_value()) {
+      attachments.push_back(&pass.stencil.value());
+    }
+    for (const auto* attachment : attachments) {
+      if (!IsValidIndex(attachment->texture, texture_count) ||
+          !IsValidIndex(attachment->resolve_texture, texture_count)) {
+        VALIDATION_LOG << "Frame capture references an invalid texture.";
+        return nullptr;
+      }
+    }
+    for (const auto& command : pass.commands) {
+      if (command.pipeline >= capture->pipelines_.size() ||
+          !IsValidIndex(command.index_buffer, capture->buffers_.size()) ||
+          !ValidateBindings(command.vertex_bindings, *capture) ||
+          !ValidateBindings(command.fragment_bindings, *capture)) {
+        VALIDATION_LOG << "Frame capture references an invalid resource.";
+        return nullptr;
+      }
+    }
+  }
+
+  return capture;
+}
+
+}  // namespace impeller
@@ -0,0 +1,188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/renderer/command.h"
+#include "impeller/renderer/formats.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/renderer/sampler_descriptor.h"
+#include "impeller/renderer/shader_types.h"
+#include "impeller/renderer/texture_descriptor.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A self contained record of the render passes encoded for a
+///             frame. This includes the pipeline descriptors, the contents of
+///             the buffers referenced by the commands, and the textures sampled
+///             or rendered to by them.
+///
+///             Captures are recorded by attaching them to a render pass (see
+///             `RenderPass::SetCapture`). Each pass is recorded when its
+///             commands are encoded. Since passes that are sampled by others
+///             are encoded first, the recorded order is a valid submission
+///             order. Captures can be serialized into a compact binary form
+///             and replayed against any context using `FrameReplay`.
+///
+///             Buffers and textures whose contents reside in device private
+///             memory are recorded without their contents.
+///
+class FrameCapture {
+ public:
+  static constexpr size_t kInvalidIndex = ~size_t{0u};
+
+  struct StageInput {
+    std::string name;
+    size_t location = 0u;
+    size_t set = 0u;
+    size_t binding = 0u;
+    ShaderType type = ShaderType::kUnknown;
+    size_t bit_width = 0u;
+    size_t vec_size = 0u;
+    size_t columns = 0u;
+  };
+
+  struct PipelineInfo {
+    std::string label;
+    SampleCount sample_count = SampleCount::kCount1;
+    std::vector<std::pair<ShaderStage, std::string>> entrypoints;
+    std::vector<StageInput> stage_inputs;
+    std::map<size_t, ColorAttachmentDescriptor> color_attachments;
+    PixelFormat depth_format = PixelFormat::kUnknown;
+    PixelFormat stencil_format = PixelFormat::kUnknown;
+    std::optional<DepthAttachmentDescriptor> depth;
+    std::optional<StencilAttachmentDescriptor> front_stencil;
+    std::optional<StencilAttachmentDescriptor> back_stencil;
+  };
+
+  struct TextureInfo {
+    TextureDescriptor desc;
+    /// The contents of the base mip level. Empty if the texture is rendered
+    /// to by a captured pass or if its contents could not be read back.
+    std::vector<uint8_t> contents;
+  };
+
+  struct BindingsInfo {
+    std::map<size_t, size_t> buffers;
+    std::map<size_t, size_t> textures;
+    std::map<size_t, size_t> samplers;
+  };
+
+  struct CommandInfo {
+    std::string label;
+    size_t pipeline = kInvalidIndex;
+    BindingsInfo vertex_bindings;
+    BindingsInfo fragment_bindings;
+    size_t index_buffer = kInvalidIndex;
+    size_t index_count = 0u;
+    PrimitiveType primitive_type = PrimitiveType::kTriangle;
+    WindingOrder winding = WindingOrder::kClockwise;
+    uint32_t stencil_reference = 0u;
+    std::optional<IRect> scissor;
+  };
+
+  struct AttachmentInfo {
+    size_t texture = kInvalidIndex;
+    size_t resolve_texture = kInvalidIndex;
+    LoadAction load_action = LoadAction::kDontCare;
+    StoreAction store_action = StoreAction::kStore;
+    Color clear_color;
+    double clear_depth = 0.0;
+    uint32_t clear_stencil = 0u;
+  };
+
+  struct PassInfo {
+    std::map<size_t, AttachmentInfo> colors;
+    std::optional<AttachmentInfo> depth;
+    std::optional<AttachmentInfo> stencil;
+    std::vector<CommandInfo> commands;
+  };
+
+  FrameCapture();
+
+  ~FrameCapture();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a capture from one previously serialized using
+  ///             `CreateMapping`.
+  ///
+  /// @param[in]  mapping  The serialized capture.
+  ///
+  /// @return     The capture or null if the mapping was not a valid capture.
+  ///
+  static std::shared_ptr<FrameCapture> CreateFromMapping(
+      const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serialize the capture into a compact binary form suitable for
+  ///             writing to disk.
+  ///
+  std::shared_ptr<fml::Mapping> CreateMapping() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the commands of a render pass. Render passes with an
+  ///             attached capture call this when their commands are encoded.
+  ///             Resources referenced by the commands are kept alive for the
+  ///             lifetime of the capture so that their identity is stable.
+  ///
+  /// @param[in]  target    The render target of the pass.
+  /// @param[in]  commands  The commands recorded into the pass.
+  ///
+  void RecordPass(const RenderTarget& target,
+                  const std::vector<Command>& commands);
+
+  const std::vector<PipelineInfo>& GetPipelines() const;
+
+  const std::vector<TextureInfo>& GetTextures() const;
+
+  const std::vector<SamplerDescriptor>& GetSamplers() const;
+
+  const std::vector<std::vector<uint8_t>>& GetBuffers() const;
+
+  const std::vector<PassInfo>& GetPasses() const;
+
+ private:
+  using BufferKey = std::tuple<std::shared_ptr<const Buffer>, size_t, size_t>;
+
+  mutable std::mutex mutex_;
+  std::vector<PipelineInfo> pipelines_;
+  std::vector<TextureInfo> textures_;
+  std::vector<SamplerDescriptor> samplers_;
+  std::vector<std::vector<uint8_t>> buffers_;
+  std::vector<PassInfo> passes_;
+
+  // Only used while recording.
+  std::map<std::shared_ptr<Pipeline>, size_t> pipeline_indices_;
+  std::map<std::shared_ptr<const Texture>, size_t> texture_indices_;
+  std::map<std::shared_ptr<const Sampler>, size_t> sampler_indices_;
+  std::map<BufferKey, size_t> buffer_indices_;
+
+  size_t RecordPipeline(const std::shared_ptr<Pipeline>& pipeline);
+
+  size_t RecordTexture(const std::shared_ptr<const Texture>& texture,
+                       bool read_contents);
+
+  size_t RecordSampler(const std::shared_ptr<const Sampler>& sampler);
+
+  size_t RecordBuffer(const BufferView& view);
+
+  BindingsInfo RecordBindings(const Bindings& bindings);
+
+  AttachmentInfo RecordAttachment(const Attachment& attachment);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameCapture);
+};
+
+}  // namespace impeller
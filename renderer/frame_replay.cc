@@ -0,0 +1,252 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/frame_replay.h"
+
+#include <map>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/platform.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/shader_library.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+static std::shared_ptr<Pipeline> CreatePipeline(
+    Context& context,
+    const FrameCapture::PipelineInfo& info) {
+  auto library = context.GetShaderLibrary();
+  auto pipeline_library = context.GetPipelineLibrary();
+
+  PipelineDescriptor desc;
+  desc.SetLabel(info.label);
+  desc.SetSampleCount(info.sample_count);
+  for (const auto& [stage, name] : info.entrypoints) {
+    auto function = library->GetFunction(name, stage);
+    if (!function) {
+      VALIDATION_LOG << "Could not find shader function '" << name
+                     << "' to replay pipeline '" << info.label << "'.";
+      return nullptr;
+    }
+    desc.AddStageEntrypoint(std::move(function));
+  }
+
+  // The pipeline library caches the descriptors beyond the lifetime of the
+  // capture and the replay. So the names of the slots are owned by the library.
+  std::vector<ShaderStageIOSlot> slots;
+  for (const auto& input : info.stage_inputs) {
+    slots.push_back(ShaderStageIOSlot{
+        pipeline_library->InternString(input.name),  // name
+        input.location,                              // location
+        input.set,                                   // set
+        input.binding,                               // binding
+        input.type,                                  // type
+        input.bit_width,                             // bit width
+        input.vec_size,                              // vec size
+        input.columns,                               // columns
+    });
+  }
+  std::vector<const ShaderStageIOSlot*> slot_pointers;
+  for (const auto& slot : slots) {
+    slot_pointers.push_back(&slot);
+  }
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  if (!vertex_descriptor->SetStageInputs(slot_pointers.data(),
+                                         slot_pointers.size())) {
+    return nullptr;
+  }
+  desc.SetVertexDescriptor(std::move(vertex_descriptor));
+
+  desc.SetColorAttachmentDescriptors(info.color_attachments);
+  desc.SetDepthPixelFormat(info.depth_format);
+  desc.SetStencilPixelFormat(info.stencil_format);
+  if (info.depth.has_value()) {
+    desc.SetDepthStencilAttachmentDescriptor(info.depth.value());
+  }
+  if (info.front_stencil.has_value() && info.back_stencil.has_value()) {
+    desc.SetStencilAttachmentDescriptors(info.front_stencil.value(),
+                                         info.back_stencil.value());
+  }
+
+  return pipeline_library->GetRenderPipeline(std::move(desc)).get();
+}
+
+FrameReplay::FrameReplay(std::shared_ptr<Context> context,
+                         std::shared_ptr<const FrameCapture> capture)
+    : context_(std::move(context)), capture_(std::move(capture)) {
+  if (!context_ || !context_->IsValid() || !capture_) {
+    return;
+  }
+
+  for (const auto& info : capture_->GetPipelines()) {
+    auto pipeline = CreatePipeline(*context_, info);
+    if (!pipeline || !pipeline->IsValid()) {
+      VALIDATION_LOG << "Could not create pipeline '" << info.label
+                     << "' for replay.";
+      return;
+    }
+    pipelines_.emplace_back(std::move(pipeline));
+  }
+
+  auto allocator = context_->GetPermanentsAllocator();
+  for (const auto& info : capture_->GetTextures()) {
+    auto texture =
+        allocator->CreateTexture(StorageMode::kHostVisible, info.desc);
+    if (!texture) {
+      VALIDATION_LOG << "Could not create texture for replay.";
+      return;
+    }
+    if (!info.contents.empty() &&
+        !texture->SetContents(info.contents.data(), info.contents.size())) {
+      VALIDATION_LOG << "Could not set the contents of a replay texture.";
+      return;
+    }
+    textures_.emplace_back(std::move(texture));
+  }
+
+  auto sampler_library = context_->GetSamplerLibrary();
+  for (const auto& desc : capture_->GetSamplers()) {
+    auto sampler = sampler_library->GetSampler(desc);
+    if (!sampler) {
+      VALIDATION_LOG << "Could not create sampler for replay.";
+      return;
+    }
+    samplers_.emplace_back(std::move(sampler));
+  }
+
+  is_valid_ = true;
+}
+
+FrameReplay::~FrameReplay() = default;
+
+bool FrameReplay::IsValid() const {
+  return is_valid_;
+}
+
+std::shared_ptr<Texture> FrameReplay::GetTexture(size_t index) const {
+  if (index >= textures_.size()) {
+    return nullptr;
+  }
+  return textures_[index];
+}
+
+bool FrameReplay::Replay() const {
+  TRACE_EVENT0("impeller", "FrameReplay::Replay");
+  if (!IsValid()) {
+    return false;
+  }
+
+  for (const auto& pass : capture_->GetPasses()) {
+    if (!ReplayPass(pass)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FrameReplay::ReplayPass(const FrameCapture::PassInfo& pass_info) const {
+  auto make_attachment = [&](auto attachment,
+                             const FrameCapture::AttachmentInfo& info) {
+    attachment.texture = GetTexture(info.texture);
+    attachment.resolve_texture = GetTexture(info.resolve_texture);
+    attachment.load_action = info.load_action;
+    attachment.store_action = info.store_action;
+    return attachment;
+  };
+
+  RenderTarget target;
+  for (const auto& [index, info] : pass_info.colors) {
+    auto color = make_attachment(ColorAttachment{}, info);
+    color.clear_color = info.clear_color;
+    target.SetColorAttachment(color, index);
+  }
+  if (pass_info.depth.has_value()) {
+    auto depth = make_attachment(DepthAttachment{}, pass_info.depth.value());
+    depth.clear_depth = pass_info.depth->clear_depth;
+    target.SetDepthAttachment(depth);
+  }
+  if (pass_info.stencil.has_value()) {
+    auto stencil =
+        make_attachment(StencilAttachment{}, pass_info.stencil.value());
+    stencil.clear_stencil = pass_info.stencil->clear_stencil;
+    target.SetStencilAttachment(stencil);
+  }
+
+  auto command_buffer = context_->CreateRenderCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("Replay Command Buffer");
+
+  auto pass = command_buffer->CreateRenderPass(target);
+  if (!pass) {
+    return false;
+  }
+  pass->SetLabel("Replay Pass");
+
+  // Like in the original frame, buffer contents are transient and emplaced
+  // into the pass once no matter how many commands reference them.
+  auto& transients = pass->GetTransientsBuffer();
+  std::map<size_t, BufferView> views;
+  auto buffer_view = [&](size_t index) -> BufferView {
+    if (index == FrameCapture::kInvalidIndex) {
+      return {};
+    }
+    if (auto found = views.find(index); found != views.end()) {
+      return found->second;
+    }
+    const auto& contents = capture_->GetBuffers()[index];
+    auto view = transients.Emplace(contents.data(), contents.size(),
+                                   DefaultUniformAlignment());
+    views[index] = view;
+    return view;
+  };
+  auto bindings = [&](Bindings& bindings,
+                      const FrameCapture::BindingsInfo& info) {
+    for (const auto& [slot, index] : info.buffers) {
+      bindings.buffers[slot] = buffer_view(index);
+    }
+    for (const auto& [slot, index] : info.textures) {
+      bindings.textures[slot] = GetTexture(index);
+    }
+    for (const auto& [slot, index] : info.samplers) {
+      if (index < samplers_.size()) {
+        bindings.samplers[slot] = samplers_[index];
+      }
+    }
+  };
+
+  for (const auto& info : pass_info.commands) {
+    Command command;
+    command.label = info.label;
+    command.pipeline = pipelines_[info.pipeline];
+    bindings(command.vertex_bindings, info.vertex_bindings);
+    bindings(command.fragment_bindings, info.fragment_bindings);
+    command.index_buffer = buffer_view(info.index_buffer);
+    command.index_count = info.index_count;
+    command.primitive_type = info.primitive_type;
+    command.winding = info.winding;
+    command.stencil_reference = info.stencil_reference;
+    command.scissor = info.scissor;
+    if (!pass->AddCommand(std::move(command))) {
+      return false;
+    }
+  }
+
+  if (!pass->EncodeCommands(*context_->GetTransientsAllocator())) {
+    return false;
+  }
+
+  return command_buffer->SubmitCommands();
+}
+
+}  // namespace impeller
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/frame_capture.h"
+#include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/sampler.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Re-issues the render passes of a frame capture against a
+///             context.
+///
+///             All pipelines, textures and samplers referenced by the capture
+///             are created up front. Each call to `Replay` then records,
+///             encodes and submits the captured passes just like the original
+///             frame did, including emplacing the buffer contents into the
+///             transients buffer of each pass. Calling `Replay` in a loop
+///             makes for a repeatable benchmark of the encoding and backend
+///             costs of real frames.
+///
+///             Pipelines are looked up by their entrypoint names in the shader
+///             library of the context. The context must have all the shaders
+///             used by the captured frame.
+///
+class FrameReplay {
+ public:
+  FrameReplay(std::shared_ptr<Context> context,
+              std::shared_ptr<const FrameCapture> capture);
+
+  ~FrameReplay();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record, encode and submit all the passes of the capture.
+  ///
+  /// @return     If all passes were submitted.
+  ///
+  [[nodiscard]] bool Replay() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the texture created for the texture at the given index
+  ///             in the capture. Useful to inspect the results of a replay.
+  ///
+  std::shared_ptr<Texture> GetTexture(size_t index) const;
+
+ private:
+  std::shared_ptr<Context> context_;
+  std::shared_ptr<const FrameCapture> capture_;
+  std::vector<std::shared_ptr<Pipeline>> pipelines_;
+  std::vector<std::shared_ptr<Texture>> textures_;
+  std::vector<std::shared_ptr<const Sampler>> samplers_;
+  bool is_valid_ = false;
+
+  bool ReplayPass(const FrameCapture::PassInfo& pass) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameReplay);
+};
+
+}  // namespace impeller
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/frame_stats.h"
+
+namespace impeller {
+
+bool FrameStats::IsComplete() const {
+  return draws_skipped == 0u;
+}
+
+FrameStats& FrameStats::operator+=(const FrameStats& other) {
+  commands_recorded += other.commands_recorded;
+  draw_calls += other.draw_calls;
+  index_count += other.index_count;
+  vertex_count += other.vertex_count;
+  transient_bytes += other.transient_bytes;
+  device_buffers_created += other.device_buffers_created;
+  textures_created += other.textures_created;
+  pipeline_switches += other.pipeline_switches;
+  textures_bound += other.textures_bound;
+  offscreen_subpasses += other.offscreen_subpasses;
+  offscreen_pixel_area += other.offscreen_pixel_area;
+  command_buffers_submitted += other.command_buffers_submitted;
+  pipeline_fallbacks += other.pipeline_fallbacks;
+  draws_skipped += other.draws_skipped;
+  entities_culled += other.entities_culled;
+  entities_occluded += other.entities_occluded;
+  entities_trimmed += other.entities_trimmed;
+  pixels_drawn += other.pixels_drawn;
+  pixels_occluded += other.pixels_occluded;
+  raster_cache_hits += other.raster_cache_hits;
+  subpasses_folded += other.subpasses_folded;
+  tessellation_time = tessellation_time + other.tessellation_time;
+  return *this;
+}
+
+std::ostream& operator<<(std::ostream& out, const FrameStats& stats) {
+  out << "Commands: " << stats.commands_recorded
+      << ", Draw Calls: " << stats.draw_calls
+      << ", Indices: " << stats.index_count
+      << ", Vertices: " << stats.vertex_count
+      << ", Transient Bytes: " << stats.transient_bytes
+      << ", Buffers Created: " << stats.device_buffers_created
+      << ", Textures Created: " << stats.textures_created
+      << ", Pipeline Switches: " << stats.pipeline_switches
+      << ", Textures Bound: " << stats.textures_bound
+      << ", Offscreen Passes: " << stats.offscreen_subpasses
+      << ", Offscreen Pixels: " << stats.offscreen_pixel_area
+      << ", Command Buffers: " << stats.command_buffers_submitted
+      << ", Pipeline Fallbacks: " << stats.pipeline_fallbacks
+      << ", Skipped Draws: " << stats.draws_skipped
+      << ", Culled Entities: " << stats.entities_culled
+      << ", Occluded Entities: " << stats.entities_occluded
+      << ", Trimmed Entities: " << stats.entities_trimmed
+      << ", Pixels Drawn: " << stats.pixels_drawn
+      << ", Pixels Occluded: " << stats.pixels_occluded
+      << ", Raster Cache Hits: " << stats.raster_cache_hits
+      << ", Folded Subpasses: " << stats.subpasses_folded
+      << ", Tessellation: " << stats.tessellation_time.ToMillisecondsF()
+      << "ms";
+  return out;
+}
+
+}  // namespace impeller
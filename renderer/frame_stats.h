@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Counters describing the work recorded for a single frame.
+///
+///             Render passes collect these as commands are recorded and the
+///             renderer folds in the allocator activity for the frame. Only
+///             plain counters are updated on the recording path so the
+///             collection is cheap enough to be always on. None of these
+///             depend on the backend in use.
+///
+struct FrameStats {
+  /// The number of valid commands recorded into render passes.
+  size_t commands_recorded = 0u;
+  /// The number of recorded commands that will result in a draw call.
+  size_t draw_calls = 0u;
+  /// The sum of the index counts of all draw calls.
+  size_t index_count = 0u;
+  /// The number of vertices in the vertex buffers bound by all draw calls.
+  size_t vertex_count = 0u;
+  /// The number of bytes emplaced into the transients buffers of the passes,
+  /// not counting alignment padding.
+  size_t transient_bytes = 0u;
+  /// The number of device buffers created by the context allocators.
+  size_t device_buffers_created = 0u;
+  /// The number of textures created by the context allocators.
+  size_t textures_created = 0u;
+  /// The number of times consecutive commands used different pipelines.
+  size_t pipeline_switches = 0u;
+  /// The number of texture bindings across all stages of all commands.
+  size_t textures_bound = 0u;
+  /// The number of offscreen render passes created to render the frame.
+  size_t offscreen_subpasses = 0u;
+  /// The number of pixels covered by the render targets of offscreen passes.
+  size_t offscreen_pixel_area = 0u;
+  /// The number of command buffers submitted to render the frame.
+  size_t command_buffers_submitted = 0u;
+  /// The number of draws that used a cheaper fallback pipeline because their
+  /// own pipeline was still being created.
+  size_t pipeline_fallbacks = 0u;
+  /// The number of draws that were skipped because their pipeline was still
+  /// being created and they declared no fallback.
+  size_t draws_skipped = 0u;
+  /// The number of entities and subpasses that were not rendered because
+  /// their coverage was entirely outside the render target.
+  size_t entities_culled = 0u;
+  /// The number of entities that were not rendered because opaque entities
+  /// drawn after them hid them entirely.
+  size_t entities_occluded = 0u;
+  /// The number of entities that were only partially rendered because opaque
+  /// entities drawn after them hid the rest.
+  size_t entities_trimmed = 0u;
+  /// The number of render target pixels covered by the bounds of rendered
+  /// entities. Divided by the area of the render target, this is an upper
+  /// bound on the overdraw.
+  size_t pixels_drawn = 0u;
+  /// The number of render target pixels that would have been covered by the
+  /// bounds of entities but were hidden by opaque entities drawn after them.
+  size_t pixels_occluded = 0u;
+  /// The number of offscreen passes whose render targets were taken from the
+  /// raster cache instead of being rendered again.
+  size_t raster_cache_hits = 0u;
+  /// The number of subpasses drawn directly into their parent with the
+  /// opacity of the subpass applied to each of their entities, instead of
+  /// being composited from an offscreen target.
+  size_t subpasses_folded = 0u;
+  /// The time spent tessellating paths on the recording thread.
+  fml::TimeDelta tessellation_time;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether every recorded draw made it into the frame. Frames
+  ///             with skipped draws should be rendered again once the missing
+  ///             pipelines are ready.
+  ///
+  bool IsComplete() const;
+
+  FrameStats& operator+=(const FrameStats& other);
+};
+
+std::ostream& operator<<(std::ostream& out, const FrameStats& stats);
+
+}  // namespace impeller
@@ -29,18 +29,22 @@ void HostBuffer::SetLabel(std::string label) {
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
                                size_t align) {
-  if (align == 0 || (GetLength() % align) == 0) {
-    return Emplace(buffer, length);
-  }
-
-  {
+  if (align != 0 && (GetLength() % align) != 0) {
     auto pad = Emplace(nullptr, align - (GetLength() % align));
     if (!pad) {
       return {};
     }
   }
 
-  return Emplace(buffer, length);
+  auto view = Emplace(buffer, length);
+  if (view) {
+    emplaced_length_ += length;
+  }
+  return view;
+}
+
+size_t HostBuffer::GetEmplacedLength() const {
+  return emplaced_length_;
 }
 
 BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
@@ -70,4 +74,8 @@ std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
   return device_buffer_;
 }
 
+const uint8_t* HostBuffer::GetHostContents() const {
+  return GetBuffer();
+}
+
 }  // namespace impeller
@@ -72,16 +72,27 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
                                    size_t length,
                                    size_t align);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes emplaced onto this buffer since it was
+  ///             created. Unlike the length of the buffer, this doesn't count
+  ///             the padding inserted to align the emplaced data.
+  ///
+  size_t GetEmplacedLength() const;
+
  private:
   mutable std::shared_ptr<DeviceBuffer> device_buffer_;
   mutable size_t device_buffer_generation_ = 0u;
   size_t generation_ = 1u;
+  size_t emplaced_length_ = 0u;
   std::string label_;
 
   // |Buffer|
   std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
       Allocator& allocator) const override;
 
+  // |Buffer|
+  const uint8_t* GetHostContents() const override;
+
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
   HostBuffer();
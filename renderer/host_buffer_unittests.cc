@@ -75,5 +75,22 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST(HostBufferTest, EmplacedLengthDoesNotCountPadding) {
+  struct Length2 {
+    uint8_t pad[2];
+  };
+  struct alignas(16) Align16 {
+    uint8_t pad[2];
+  };
+
+  auto buffer = HostBuffer::Create();
+  ASSERT_TRUE(buffer);
+  ASSERT_EQ(buffer->GetEmplacedLength(), 0u);
+  ASSERT_TRUE(buffer->Emplace(Length2{}));
+  ASSERT_TRUE(buffer->Emplace(Align16{}));
+  ASSERT_EQ(buffer->GetLength(), 32u);
+  ASSERT_EQ(buffer->GetEmplacedLength(), 18u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
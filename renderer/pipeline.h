@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <future>
+#include <mutex>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/context.h"
@@ -92,21 +95,46 @@ class PipelineT {
   explicit PipelineT(PipelineFuture future)
       : pipeline_future_(std::move(future)) {}
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the pipeline, waiting for it to be created if necessary.
+  ///             This may be called from multiple threads.
+  ///
   std::shared_ptr<Pipeline> WaitAndGet() {
-    if (did_wait_) {
-      return pipeline_;
-    }
-    did_wait_ = true;
-    if (pipeline_future_.valid()) {
-      pipeline_ = pipeline_future_.get();
+    if (!did_wait_.load(std::memory_order_acquire)) {
+      std::call_once(wait_once_, [this]() {
+        if (pipeline_future_.valid()) {
+          pipeline_ = pipeline_future_.get();
+        }
+        did_wait_.store(true, std::memory_order_release);
+      });
     }
     return pipeline_;
   }
 
+  const PipelineFuture& GetFuture() const { return pipeline_future_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the pipeline without blocking the calling thread. This
+  ///             may be called from multiple threads.
+  ///
+  /// @return     The pipeline or null if it is still being created or could
+  ///             not be created.
+  ///
+  std::shared_ptr<Pipeline> GetIfReady() {
+    if (!did_wait_.load(std::memory_order_acquire) &&
+        pipeline_future_.valid() &&
+        pipeline_future_.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready) {
+      return nullptr;
+    }
+    return WaitAndGet();
+  }
+
  private:
-  PipelineFuture pipeline_future_;
+  const PipelineFuture pipeline_future_;
   std::shared_ptr<Pipeline> pipeline_;
-  bool did_wait_ = false;
+  std::once_flag wait_once_;
+  std::atomic_bool did_wait_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineT);
 };
@@ -14,6 +14,30 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Whether every input of the fragment shader has a vertex shader
+///             output of the same type at the same location.
+///
+template <class VertexShader, class FragmentShader>
+constexpr bool StageInterfacesMatch() {
+  for (const auto* input : FragmentShader::kAllShaderStageInputs) {
+    bool matched = false;
+    for (const auto* output : VertexShader::kAllShaderStageOutputs) {
+      if (output->location == input->location) {
+        matched = output->type == input->type &&
+                  output->bit_width == input->bit_width &&
+                  output->vec_size == input->vec_size &&
+                  output->columns == input->columns;
+        break;
+      }
+    }
+    if (!matched) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 /// @brief      An optional (but highly recommended) utility for creating
 ///             pipelines from reflected shader information.
@@ -58,6 +82,10 @@ struct PipelineBuilder {
   [[nodiscard]] static bool InitializePipelineDescriptorDefaults(
       const Context& context,
       PipelineDescriptor& desc) {
+    static_assert(StageInterfacesMatch<VertexShader, FragmentShader>(),
+                  "Every input of the fragment shader must have a vertex "
+                  "shader output of the same type at the same location.");
+
     // Setup debug instrumentation.
     desc.SetLabel(SPrintF("%s Pipeline", VertexShader::kLabel.data()));
 
@@ -83,15 +111,14 @@ struct PipelineBuilder {
 
     // Setup the vertex descriptor from reflected information.
     {
-      auto vertex_descriptor = std::make_shared<VertexDescriptor>();
-      if (!vertex_descriptor->SetStageInputs(
-              VertexShader::kAllShaderStageInputs)) {
+      const auto& vertex_descriptor = GetVertexDescriptor();
+      if (!vertex_descriptor) {
         VALIDATION_LOG
             << "Could not configure vertex descriptor for pipeline named '"
             << VertexShader::kLabel << "'.";
         return false;
       }
-      desc.SetVertexDescriptor(std::move(vertex_descriptor));
+      desc.SetVertexDescriptor(vertex_descriptor);
     }
 
     // Setup fragment shader output descriptions.
@@ -114,6 +141,24 @@ struct PipelineBuilder {
 
     return true;
   }
+
+ private:
+  //----------------------------------------------------------------------------
+  /// @brief      The vertex descriptor only depends on the reflected stage
+  ///             inputs of the vertex shader. So it is created once and shared
+  ///             by all the descriptors created by this builder.
+  ///
+  static const std::shared_ptr<VertexDescriptor>& GetVertexDescriptor() {
+    static const auto vertex_descriptor = []() {
+      auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+      if (!vertex_descriptor->SetStageInputs(
+              VertexShader::kAllShaderStageInputs)) {
+        vertex_descriptor.reset();
+      }
+      return vertex_descriptor;
+    }();
+    return vertex_descriptor;
+  }
 };
 
 }  // namespace impeller
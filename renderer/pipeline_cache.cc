@@ -0,0 +1,256 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/pipeline_cache.h"
+
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+
+#include "impeller/archivist/archive.h"
+#include "impeller/archivist/archive_location.h"
+#include "impeller/base/allocation.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// The names of the shader functions of a descriptor. Unlike the hash of the
+/// functions, this is stable across process launches.
+///
+static std::string GetShaderIdentity(const PipelineDescriptor& desc) {
+  std::stringstream stream;
+  for (const auto& entry : desc.GetStageEntrypoints()) {
+    if (!entry.second) {
+      continue;
+    }
+    stream << static_cast<int>(entry.first) << ":" << entry.second->GetName()
+           << ";";
+  }
+  return stream.str();
+}
+
+//------------------------------------------------------------------------------
+/// @brief      A 64-bit FNV-1a hash. Unlike `std::hash` and the hashes of the
+///             descriptors, it only depends on the values hashed and not on
+///             the process. Pointers must not be hashed.
+///
+class StableHash {
+ public:
+  template <class T,
+            class =
+                std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+  StableHash& Add(T value) {
+    // Little endian regardless of the host.
+    auto bits = static_cast<uint64_t>(value);
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+      AddByte(static_cast<uint8_t>(bits >> (i * 8u)));
+    }
+    return *this;
+  }
+
+  StableHash& Add(std::string_view string) {
+    Add(string.size());
+    for (auto c : string) {
+      AddByte(static_cast<uint8_t>(c));
+    }
+    return *this;
+  }
+
+  StableHash& Add(const char* string) {
+    return Add(std::string_view{string ? string : ""});
+  }
+
+  int64_t Get() const { return static_cast<int64_t>(hash_); }
+
+ private:
+  static constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+  static constexpr uint64_t kPrime = 1099511628211ull;
+
+  uint64_t hash_ = kOffsetBasis;
+
+  void AddByte(uint8_t byte) {
+    hash_ ^= byte;
+    hash_ *= kPrime;
+  }
+};
+
+static void AddStencilAttachment(
+    StableHash& hash,
+    const std::optional<StencilAttachmentDescriptor>& stencil) {
+  hash.Add(stencil.has_value());
+  if (!stencil.has_value()) {
+    return;
+  }
+  hash.Add(stencil->stencil_compare)
+      .Add(stencil->stencil_failure)
+      .Add(stencil->depth_failure)
+      .Add(stencil->depth_stencil_pass)
+      .Add(stencil->read_mask)
+      .Add(stencil->write_mask);
+}
+
+int64_t PipelineCache::GetKey(const PipelineDescriptor& desc) {
+  // The label is only used for debugging and variants are frequently labelled
+  // by their creation order. So it is ignored.
+  StableHash hash;
+  hash.Add(GetShaderIdentity(desc));
+  hash.Add(desc.GetSampleCount());
+  const auto& colors = desc.GetColorAttachmentDescriptors();
+  hash.Add(colors.size());
+  for (const auto& [index, color] : colors) {
+    hash.Add(index)
+        .Add(color.format)
+        .Add(color.blending_enabled)
+        .Add(color.src_color_blend_factor)
+        .Add(color.color_blend_op)
+        .Add(color.dst_color_blend_factor)
+        .Add(color.src_alpha_blend_factor)
+        .Add(color.alpha_blend_op)
+        .Add(color.dst_alpha_blend_factor)
+        .Add(color.write_mask);
+  }
+  const auto& vertex_descriptor = desc.GetVertexDescriptor();
+  hash.Add(vertex_descriptor != nullptr);
+  if (vertex_descriptor) {
+    const auto& inputs = vertex_descriptor->GetStageInputs();
+    hash.Add(inputs.size());
+    for (const auto& input : inputs) {
+      // The names are hashed by value. Their addresses differ between launches.
+      hash.Add(input.name)
+          .Add(input.location)
+          .Add(input.set)
+          .Add(input.binding)
+          .Add(input.type)
+          .Add(input.bit_width)
+          .Add(input.vec_size)
+          .Add(input.columns);
+    }
+  }
+  hash.Add(desc.GetDepthPixelFormat());
+  hash.Add(desc.GetStencilPixelFormat());
+  const auto depth = desc.GetDepthStencilAttachmentDescriptor();
+  hash.Add(depth.has_value());
+  if (depth.has_value()) {
+    hash.Add(depth->depth_compare).Add(depth->depth_write_enabled);
+  }
+  AddStencilAttachment(hash, desc.GetFrontStencilAttachmentDescriptor());
+  AddStencilAttachment(hash, desc.GetBackStencilAttachmentDescriptor());
+  return hash.Get();
+}
+
+class PipelineCacheEntry : public Archivable {
+ public:
+  PipelineCacheEntry() = default;
+
+  PipelineCacheEntry(int64_t key,
+                     std::string identity,
+                     const uint8_t* data,
+                     size_t length)
+      : key_(key), identity_(std::move(identity)) {
+    if (data_.Truncate(length, false /* npot */)) {
+      ::memmove(data_.GetBuffer(), data, length);
+    }
+  }
+
+  const std::string& GetIdentity() const { return identity_; }
+
+  const Allocation& GetData() const { return data_; }
+
+  // |Archivable|
+  PrimaryKey GetPrimaryKey() const override { return key_; }
+
+  // |Archivable|
+  bool Write(ArchiveLocation& item) const override {
+    return item.Write("identity", identity_) && item.Write("data", data_);
+  }
+
+  // |Archivable|
+  bool Read(ArchiveLocation& item) override {
+    key_ = item.GetPrimaryKey();
+    return item.Read("identity", identity_) && item.Read("data", data_);
+  }
+
+  static const ArchiveDef kArchiveDefinition;
+
+ private:
+  PrimaryKey key_;
+  std::string identity_;
+  Allocation data_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineCacheEntry);
+};
+
+const ArchiveDef PipelineCacheEntry::kArchiveDefinition = {
+    .table_name = "PipelineCacheEntry",
+    .members = {"identity", "data"},
+};
+
+PipelineCache::PipelineCache(const std::string& path)
+    : archive_(std::make_unique<Archive>(path)) {}
+
+PipelineCache::~PipelineCache() = default;
+
+bool PipelineCache::IsValid() const {
+  return archive_->IsValid();
+}
+
+std::shared_ptr<fml::Mapping> PipelineCache::Load(
+    const PipelineDescriptor& desc) const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  auto entry = std::make_shared<PipelineCacheEntry>();
+  {
+    std::scoped_lock lock(archive_mutex_);
+    if (!archive_->Read(GetKey(desc), *entry)) {
+      miss_count_++;
+      return nullptr;
+    }
+  }
+
+  // Guard against hash collisions between pipelines using different shaders.
+  if (entry->GetIdentity() != GetShaderIdentity(desc)) {
+    miss_count_++;
+    return nullptr;
+  }
+
+  hit_count_++;
+  const auto& data = entry->GetData();
+  return std::make_shared<fml::NonOwnedMapping>(
+      data.GetBuffer(),                    // bytes
+      data.GetLength(),                    // byte size
+      [entry](const uint8_t*, size_t) {}  // release proc
+  );
+}
+
+bool PipelineCache::Store(const PipelineDescriptor& desc,
+                          const fml::Mapping& data) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  PipelineCacheEntry entry(GetKey(desc), GetShaderIdentity(desc),
+                           data.GetMapping(), data.GetSize());
+  if (entry.GetData().GetLength() != data.GetSize()) {
+    VALIDATION_LOG << "Could not allocate pipeline cache entry.";
+    return false;
+  }
+
+  std::scoped_lock lock(archive_mutex_);
+  return archive_->Write(entry);
+}
+
+size_t PipelineCache::GetHitCount() const {
+  return hit_count_;
+}
+
+size_t PipelineCache::GetMissCount() const {
+  return miss_count_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+
+namespace impeller {
+
+class Archive;
+
+//------------------------------------------------------------------------------
+/// @brief      A persistent cache of backend specific pipeline data stored in
+///             an archive on disk.
+///
+///             Pipeline libraries that have a cache attached to them (see
+///             `PipelineLibrary::SetPipelineCache`) look up the data for a
+///             descriptor before creating a pipeline and store the data for
+///             pipelines they had to create from scratch. What the data is
+///             depends on the backend. For instance, the Metal backend stores
+///             binary archives of the compiled pipeline state.
+///
+///             Entries are keyed by the names of the shader functions of the
+///             descriptor and the remaining state that affects compilation.
+///             Keys are computed from the values of that state, including the
+///             names of the vertex stage inputs, with a hash that is stable
+///             across process launches.
+///             The contents of the shader libraries are not part of the key.
+///             So caches must not be shared between versions of an
+///             application whose shaders differ.
+///
+///             The cache may be accessed from multiple threads.
+///
+class PipelineCache {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Open or create a pipeline cache.
+  ///
+  /// @param[in]  path  The path of the archive on disk.
+  ///
+  PipelineCache(const std::string& path);
+
+  ~PipelineCache();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Load the data previously stored for a compatible descriptor.
+  ///
+  /// @param[in]  desc  The pipeline descriptor.
+  ///
+  /// @return     The data or null if there was none.
+  ///
+  std::shared_ptr<fml::Mapping> Load(const PipelineDescriptor& desc) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Store the data for a descriptor, replacing any data
+  ///             previously stored for compatible descriptors.
+  ///
+  /// @param[in]  desc  The pipeline descriptor.
+  /// @param[in]  data  The backend specific pipeline data.
+  ///
+  /// @return     If the data was written to the archive.
+  ///
+  [[nodiscard]] bool Store(const PipelineDescriptor& desc,
+                           const fml::Mapping& data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of loads that found data since the cache was
+  ///             opened.
+  ///
+  size_t GetHitCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of loads that found no data since the cache was
+  ///             opened.
+  ///
+  size_t GetMissCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The key the data for a descriptor is stored under. It only
+  ///             depends on the values in the descriptor and not on the
+  ///             process that computes it.
+  ///
+  static int64_t GetKey(const PipelineDescriptor& desc);
+
+ private:
+  mutable std::mutex archive_mutex_;
+  std::unique_ptr<Archive> archive_;
+  mutable std::atomic_size_t hit_count_ = 0u;
+  mutable std::atomic_size_t miss_count_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineCache);
+};
+
+}  // namespace impeller
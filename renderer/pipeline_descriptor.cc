@@ -17,8 +17,14 @@ PipelineDescriptor::~PipelineDescriptor() = default;
 
 // Comparable<PipelineDescriptor>
 std::size_t PipelineDescriptor::GetHash() const {
+  if (!hash_.has_value()) {
+    hash_ = ComputeHash();
+  }
+  return hash_.value();
+}
+
+std::size_t PipelineDescriptor::ComputeHash() const {
   auto seed = fml::HashCombine();
-  fml::HashCombineSeed(seed, label_);
   fml::HashCombineSeed(seed, sample_count_);
   for (const auto& entry : entrypoints_) {
     fml::HashCombineSeed(seed, entry.first);
@@ -43,7 +49,10 @@ std::size_t PipelineDescriptor::GetHash() const {
 
 // Comparable<PipelineDescriptor>
 bool PipelineDescriptor::IsEqual(const PipelineDescriptor& other) const {
-  return label_ == other.label_ && sample_count_ == other.sample_count_ &&
+  if (GetHash() != other.GetHash()) {
+    return false;
+  }
+  return sample_count_ == other.sample_count_ &&
          DeepCompareMap(entrypoints_, other.entrypoints_) &&
          color_attachment_descriptors_ == other.color_attachment_descriptors_ &&
          DeepComparePointer(vertex_descriptor_, other.vertex_descriptor_) &&
@@ -63,6 +72,7 @@ PipelineDescriptor& PipelineDescriptor::SetLabel(std::string label) {
 
 PipelineDescriptor& PipelineDescriptor::SetSampleCount(SampleCount samples) {
   sample_count_ = samples;
+  hash_.reset();
   return *this;
 }
 
@@ -77,6 +87,7 @@ PipelineDescriptor& PipelineDescriptor::AddStageEntrypoint(
   }
 
   entrypoints_[function->GetStage()] = std::move(function);
+  hash_.reset();
 
   return *this;
 }
@@ -84,6 +95,7 @@ PipelineDescriptor& PipelineDescriptor::AddStageEntrypoint(
 PipelineDescriptor& PipelineDescriptor::SetVertexDescriptor(
     std::shared_ptr<VertexDescriptor> vertex_descriptor) {
   vertex_descriptor_ = std::move(vertex_descriptor);
+  hash_.reset();
   return *this;
 }
 
@@ -91,12 +103,14 @@ PipelineDescriptor& PipelineDescriptor::SetColorAttachmentDescriptor(
     size_t index,
     ColorAttachmentDescriptor desc) {
   color_attachment_descriptors_[index] = std::move(desc);
+  hash_.reset();
   return *this;
 }
 
 PipelineDescriptor& PipelineDescriptor::SetColorAttachmentDescriptors(
     std::map<size_t /* index */, ColorAttachmentDescriptor> descriptors) {
   color_attachment_descriptors_ = std::move(descriptors);
+  hash_.reset();
   return *this;
 }
 
@@ -110,18 +124,21 @@ PipelineDescriptor::GetColorAttachmentDescriptor(size_t index) const {
 PipelineDescriptor& PipelineDescriptor::SetDepthPixelFormat(
     PixelFormat format) {
   depth_pixel_format_ = format;
+  hash_.reset();
   return *this;
 }
 
 PipelineDescriptor& PipelineDescriptor::SetStencilPixelFormat(
     PixelFormat format) {
   stencil_pixel_format_ = format;
+  hash_.reset();
   return *this;
 }
 
 PipelineDescriptor& PipelineDescriptor::SetDepthStencilAttachmentDescriptor(
     DepthAttachmentDescriptor desc) {
   depth_attachment_descriptor_ = desc;
+  hash_.reset();
   return *this;
 }
 
@@ -135,6 +152,7 @@ PipelineDescriptor& PipelineDescriptor::SetStencilAttachmentDescriptors(
     StencilAttachmentDescriptor back) {
   front_stencil_attachment_descriptor_ = front;
   back_stencil_attachment_descriptor_ = back;
+  hash_.reset();
   return *this;
 }
 
@@ -143,6 +161,7 @@ void PipelineDescriptor::ResetAttachments() {
   depth_attachment_descriptor_.reset();
   front_stencil_attachment_descriptor_.reset();
   back_stencil_attachment_descriptor_.reset();
+  hash_.reset();
 }
 
 PixelFormat PipelineDescriptor::GetStencilPixelFormat() const {
@@ -7,6 +7,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -22,6 +23,17 @@ namespace impeller {
 class ShaderFunction;
 class VertexDescriptor;
 
+//------------------------------------------------------------------------------
+/// @brief      Describes the state a pipeline is created with.
+///
+///             The label is only used for debugging and is not part of the
+///             identity of the descriptor. The hash is computed lazily and
+///             cached until the descriptor is modified. Equality checks
+///             compare the cached hashes before comparing any state.
+///
+///             A vertex descriptor must not be modified after it has been
+///             set on a pipeline descriptor.
+///
 class PipelineDescriptor final : public Comparable<PipelineDescriptor> {
  public:
   PipelineDescriptor();
@@ -109,6 +121,9 @@ class PipelineDescriptor final : public Comparable<PipelineDescriptor> {
       front_stencil_attachment_descriptor_;
   std::optional<StencilAttachmentDescriptor>
       back_stencil_attachment_descriptor_;
+  mutable std::optional<std::size_t> hash_;
+
+  std::size_t ComputeHash() const;
 };
 
 }  // namespace impeller
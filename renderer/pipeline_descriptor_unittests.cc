@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(PipelineDescriptorTest, LabelsAreNotPartOfTheIdentity) {
+  PipelineDescriptor a;
+  a.SetLabel("A");
+  PipelineDescriptor b;
+  b.SetLabel("B");
+  ASSERT_EQ(a.GetHash(), b.GetHash());
+  ASSERT_TRUE(a.IsEqual(b));
+}
+
+TEST(PipelineDescriptorTest, MutationsInvalidateTheHash) {
+  PipelineDescriptor a;
+  PipelineDescriptor b;
+  ASSERT_TRUE(a.IsEqual(b));
+
+  b.SetSampleCount(SampleCount::kCount4);
+  ASSERT_NE(a.GetHash(), b.GetHash());
+  ASSERT_FALSE(a.IsEqual(b));
+  a.SetSampleCount(SampleCount::kCount4);
+  ASSERT_TRUE(a.IsEqual(b));
+
+  ColorAttachmentDescriptor color0;
+  color0.format = PixelFormat::kDefaultColor;
+  a.SetColorAttachmentDescriptor(0u, color0);
+  ASSERT_FALSE(a.IsEqual(b));
+  b.SetColorAttachmentDescriptor(0u, color0);
+  ASSERT_TRUE(a.IsEqual(b));
+
+  // Copies keep the cached hash until they are modified.
+  auto c = a;
+  ASSERT_EQ(c.GetHash(), a.GetHash());
+  c.ResetAttachments();
+  ASSERT_NE(c.GetHash(), a.GetHash());
+  ASSERT_FALSE(c.IsEqual(a));
+}
+
+}  // namespace testing
+}  // namespace impeller
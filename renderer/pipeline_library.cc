@@ -20,4 +20,19 @@ PipelineFuture PipelineLibrary::GetRenderPipeline(
   return promise->get_future();
 }
 
+void PipelineLibrary::SetPipelineCache(std::shared_ptr<PipelineCache> cache) {
+  cache_ = std::move(cache);
+}
+
+const std::shared_ptr<PipelineCache>& PipelineLibrary::GetPipelineCache()
+    const {
+  return cache_;
+}
+
+const char* PipelineLibrary::InternString(const std::string& string) {
+  std::scoped_lock lock(interned_strings_mutex_);
+  // The nodes of the set, and hence the strings, don't move on rehashes.
+  return interned_strings_.insert(string).first->c_str();
+}
+
 }  // namespace impeller
@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <unordered_set>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/pipeline.h"
@@ -13,6 +17,7 @@
 namespace impeller {
 
 class Context;
+class PipelineCache;
 
 class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
  public:
@@ -23,10 +28,40 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
 
   virtual PipelineFuture GetRenderPipeline(PipelineDescriptor descriptor) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Attach a persistent cache that backends may use to avoid
+  ///             compiling pipelines created by previous launches. Backends
+  ///             that have nothing to compile ignore the cache. This must be
+  ///             done before any pipelines are requested from the library.
+  ///
+  /// @param[in]  cache  The cache or null to detach the current one.
+  ///
+  void SetPipelineCache(std::shared_ptr<PipelineCache> cache);
+
+  const std::shared_ptr<PipelineCache>& GetPipelineCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a copy of the string that lives as long as the library.
+  ///             The names of stage input slots are expected to be static
+  ///             strings because the library caches the descriptors of its
+  ///             pipelines. Descriptors assembled at runtime use this for
+  ///             their slot names instead.
+  ///
+  /// @param[in]  string  The string to copy.
+  ///
+  /// @return     A null terminated copy of the string. Equal strings share a
+  ///             copy.
+  ///
+  const char* InternString(const std::string& string);
+
  protected:
   PipelineLibrary();
 
  private:
+  std::shared_ptr<PipelineCache> cache_;
+  std::mutex interned_strings_mutex_;
+  std::unordered_set<std::string> interned_strings_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineLibrary);
 };
 
@@ -4,6 +4,11 @@
 
 #include "impeller/renderer/render_pass.h"
 
+#include "impeller/renderer/frame_capture.h"
+#include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
 namespace impeller {
 
 RenderPass::RenderPass(RenderTarget target)
@@ -19,4 +24,82 @@ ISize RenderPass::GetRenderTargetSize() const {
   return render_target_.GetRenderTargetSize();
 }
 
+bool RenderPass::AddCommand(Command command) {
+  if (command.scissor.has_value()) {
+    // Backends may assume that the scissor is within the render target.
+    auto scissor = command.scissor->Intersection(
+        IRect::MakeSize(render_target_.GetRenderTargetSize()));
+    if (!scissor.has_value()) {
+      // Nothing would be drawn. This isn't an error.
+      return true;
+    }
+    command.scissor = scissor;
+  }
+
+  const auto* pipeline = command.pipeline.get();
+  const auto index_count = command.index_count;
+  const auto textures_bound = command.vertex_bindings.textures.size() +
+                              command.fragment_bindings.textures.size();
+  size_t vertex_count = 0u;
+  if (auto found = command.vertex_bindings.buffers.find(
+          VertexDescriptor::kReservedVertexBufferIndex);
+      pipeline && found != command.vertex_bindings.buffers.end()) {
+    const auto& vertex_desc = pipeline->GetDescriptor().GetVertexDescriptor();
+    if (vertex_desc && vertex_desc->GetStride() > 0u) {
+      vertex_count = found->second.range.length / vertex_desc->GetStride();
+    }
+  }
+
+  if (capture_) {
+    captured_commands_.push_back(command);
+  }
+
+  if (!OnAddCommand(std::move(command))) {
+    if (capture_) {
+      captured_commands_.pop_back();
+    }
+    return false;
+  }
+
+  stats_.commands_recorded++;
+  if (index_count > 0u) {
+    stats_.draw_calls++;
+    stats_.index_count += index_count;
+  }
+  stats_.vertex_count += vertex_count;
+  stats_.textures_bound += textures_bound;
+  if (pipeline != last_pipeline_) {
+    stats_.pipeline_switches++;
+    last_pipeline_ = pipeline;
+  }
+  return true;
+}
+
+bool RenderPass::EncodeCommands(Allocator& transients_allocator) const {
+  if (!OnEncodeCommands(transients_allocator)) {
+    return false;
+  }
+  if (capture_) {
+    capture_->RecordPass(render_target_, captured_commands_);
+  }
+  return true;
+}
+
+FrameStats& RenderPass::GetStats() {
+  // Data may be emplaced into the transients buffer without ever being bound
+  // to a command. Account for whatever was emplaced since the last call.
+  const auto emplaced_length = GetTransientsBuffer().GetEmplacedLength();
+  stats_.transient_bytes += emplaced_length - transients_emplaced_length_;
+  transients_emplaced_length_ = emplaced_length;
+  return stats_;
+}
+
+void RenderPass::SetCapture(std::shared_ptr<FrameCapture> capture) {
+  capture_ = std::move(capture);
+}
+
+const std::shared_ptr<FrameCapture>& RenderPass::GetCapture() const {
+  return capture_;
+}
+
 }  // namespace impeller
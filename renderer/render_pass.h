@@ -4,15 +4,19 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "impeller/renderer/command.h"
+#include "impeller/renderer/frame_stats.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
 class HostBuffer;
 class Allocator;
+class FrameCapture;
 
 //------------------------------------------------------------------------------
 /// @brief      Render passes encode render commands directed as one specific
@@ -40,13 +44,15 @@ class RenderPass {
   //----------------------------------------------------------------------------
   /// @brief      Record a command for subsequent encoding to the underlying
   ///             command buffer. No work is encoded into the command buffer at
-  ///             this time.
+  ///             this time. Scissors are clamped to the render target and
+  ///             commands whose scissor doesn't overlap the render target are
+  ///             dropped.
   ///
   /// @param[in]  command  The command
   ///
   /// @return     If the command was valid for subsequent commitment.
   ///
-  virtual bool AddCommand(Command command) = 0;
+  bool AddCommand(Command command);
 
   //----------------------------------------------------------------------------
   /// @brief      Encode the recorded commands to the underlying command buffer.
@@ -56,14 +62,45 @@ class RenderPass {
   /// @return     If the commands were encoded to the underlying command
   ///             buffer.
   ///
-  virtual bool EncodeCommands(Allocator& transients_allocator) const = 0;
+  bool EncodeCommands(Allocator& transients_allocator) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The statistics of the commands recorded into this pass so far.
+  ///             Collaborators that render into other passes on behalf of
+  ///             this one (offscreen subpasses for instance) may fold their
+  ///             statistics into these.
+  ///
+  /// @return     The frame statistics of this pass.
+  ///
+  FrameStats& GetStats();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the commands of this pass into the given capture when
+  ///             they are encoded. Collaborators that create render passes on
+  ///             behalf of this one should propagate the capture to them.
+  ///
+  /// @param[in]  capture  The capture or null to stop capturing.
+  ///
+  void SetCapture(std::shared_ptr<FrameCapture> capture);
+
+  const std::shared_ptr<FrameCapture>& GetCapture() const;
 
  protected:
   const RenderTarget render_target_;
 
   RenderPass(RenderTarget target);
 
+  virtual bool OnAddCommand(Command command) = 0;
+
+  virtual bool OnEncodeCommands(Allocator& transients_allocator) const = 0;
+
  private:
+  FrameStats stats_;
+  const Pipeline* last_pipeline_ = nullptr;
+  size_t transients_emplaced_length_ = 0u;
+  std::shared_ptr<FrameCapture> capture_;
+  std::vector<Command> captured_commands_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(RenderPass);
 };
 
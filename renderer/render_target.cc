@@ -8,6 +8,7 @@
 #include "impeller/renderer/allocator.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/texture.h"
+#include "impeller/renderer/texture_pool.h"
 
 namespace impeller {
 
@@ -177,6 +178,27 @@ const std::optional<StencilAttachment>& RenderTarget::GetStencilAttachment()
 RenderTarget RenderTarget::CreateOffscreen(const Context& context,
                                            ISize size,
                                            std::string label) {
+  auto allocator = context.GetPermanentsAllocator();
+  return CreateOffscreen(
+      [&allocator](StorageMode mode, const TextureDescriptor& desc) {
+        return allocator->CreateTexture(mode, desc);
+      },
+      size, label);
+}
+
+RenderTarget RenderTarget::CreateOffscreen(TexturePool& pool,
+                                           ISize size,
+                                           std::string label) {
+  return CreateOffscreen(
+      [&pool](StorageMode mode, const TextureDescriptor& desc) {
+        return pool.CreateTexture(mode, desc);
+      },
+      size, label);
+}
+
+RenderTarget RenderTarget::CreateOffscreen(const TextureFactory& create_texture,
+                                           ISize size,
+                                           const std::string& label) {
   if (size.IsEmpty()) {
     return {};
   }
@@ -197,8 +219,7 @@ RenderTarget RenderTarget::CreateOffscreen(const Context& context,
   color0.clear_color = Color::BlackTransparent();
   color0.load_action = LoadAction::kClear;
   color0.store_action = StoreAction::kStore;
-  color0.texture = context.GetPermanentsAllocator()->CreateTexture(
-      StorageMode::kDevicePrivate, color_tex0);
+  color0.texture = create_texture(StorageMode::kDevicePrivate, color_tex0);
 
   if (!color0.texture) {
     return {};
@@ -210,8 +231,8 @@ RenderTarget RenderTarget::CreateOffscreen(const Context& context,
   stencil0.load_action = LoadAction::kClear;
   stencil0.store_action = StoreAction::kDontCare;
   stencil0.clear_stencil = 0u;
-  stencil0.texture = context.GetPermanentsAllocator()->CreateTexture(
-      StorageMode::kDeviceTransient, stencil_tex0);
+  stencil0.texture =
+      create_texture(StorageMode::kDeviceTransient, stencil_tex0);
 
   if (!stencil0.texture) {
     return {};
@@ -10,11 +10,14 @@
 
 #include "flutter/fml/macros.h"
 #include "impeller/geometry/size.h"
+#include "impeller/renderer/allocator.h"
 #include "impeller/renderer/formats.h"
+#include "impeller/renderer/texture_descriptor.h"
 
 namespace impeller {
 
 class Context;
+class TexturePool;
 
 class RenderTarget {
  public:
@@ -22,6 +25,15 @@ class RenderTarget {
                                       ISize size,
                                       std::string label = "Offscreen");
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create an offscreen render target whose attachments are
+  ///             recycled by a texture pool. The render target may be larger
+  ///             than the requested size.
+  ///
+  static RenderTarget CreateOffscreen(TexturePool& pool,
+                                      ISize size,
+                                      std::string label = "Offscreen");
+
   static RenderTarget CreateMSAA(const Context& context,
                                  std::shared_ptr<Texture> resolve_texture,
                                  std::string label = "Offscreen");
@@ -61,6 +73,14 @@ class RenderTarget {
 
   void IterateAllAttachments(
       std::function<bool(const Attachment& attachment)> iterator) const;
+
+  using TextureFactory = std::function<std::shared_ptr<Texture>(
+      StorageMode mode,
+      const TextureDescriptor& desc)>;
+
+  static RenderTarget CreateOffscreen(const TextureFactory& create_texture,
+                                      ISize size,
+                                      const std::string& label);
 };
 
 }  // namespace impeller
@@ -33,7 +33,7 @@ bool Renderer::IsValid() const {
 }
 
 bool Renderer::Render(std::unique_ptr<Surface> surface,
-                      RenderCallback render_callback) const {
+                      RenderCallback render_callback) {
   TRACE_EVENT0("impeller", "Renderer::Render");
   if (!IsValid()) {
     return false;
@@ -57,14 +57,47 @@ bool Renderer::Render(std::unique_ptr<Surface> surface,
     return false;
   }
 
+  {
+    std::scoped_lock lock(frame_state_mutex_);
+    render_pass->SetCapture(std::move(next_frame_capture_));
+    next_frame_capture_ = nullptr;
+  }
+
+  const auto transients_allocator = context_->GetTransientsAllocator();
+  const auto permanents_allocator = context_->GetPermanentsAllocator();
+  const auto buffers_created = [&]() {
+    return transients_allocator->GetDeviceBuffersCreated() +
+           permanents_allocator->GetDeviceBuffersCreated();
+  };
+  const auto textures_created = [&]() {
+    return transients_allocator->GetTexturesCreated() +
+           permanents_allocator->GetTexturesCreated();
+  };
+  const auto buffers_created_before_frame = buffers_created();
+  const auto textures_created_before_frame = textures_created();
+
   if (render_callback && !render_callback(*render_pass)) {
     return false;
   }
 
-  if (!render_pass->EncodeCommands(*GetContext()->GetTransientsAllocator())) {
+  if (!render_pass->EncodeCommands(*transients_allocator)) {
     return false;
   }
 
+  {
+    // Allocations made on other threads while this frame was being recorded
+    // are also attributed to it.
+    auto stats = render_pass->GetStats();
+    // The onscreen command buffer is submitted below.
+    stats.command_buffers_submitted++;
+    stats.device_buffers_created +=
+        buffers_created() - buffers_created_before_frame;
+    stats.textures_created +=
+        textures_created() - textures_created_before_frame;
+    std::scoped_lock lock(frame_state_mutex_);
+    last_frame_stats_ = stats;
+  }
+
   if (!frames_in_flight_sema_->Wait()) {
     return false;
   }
@@ -86,4 +119,17 @@ std::shared_ptr<Context> Renderer::GetContext() const {
   return context_;
 }
 
+FrameStats Renderer::GetLastFrameStats() const {
+  std::scoped_lock lock(frame_state_mutex_);
+  return last_frame_stats_;
+}
+
+std::shared_ptr<FrameCapture> Renderer::CaptureNextFrame() {
+  std::scoped_lock lock(frame_state_mutex_);
+  if (!next_frame_capture_) {
+    next_frame_capture_ = std::make_shared<FrameCapture>();
+  }
+  return next_frame_capture_;
+}
+
 }  // namespace impeller
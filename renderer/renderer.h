@@ -8,11 +8,14 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "impeller/geometry/size.h"
 #include "impeller/renderer/context.h"
+#include "impeller/renderer/frame_capture.h"
+#include "impeller/renderer/frame_stats.h"
 
 namespace impeller {
 
@@ -32,13 +35,35 @@ class Renderer {
 
   bool IsValid() const;
 
-  bool Render(std::unique_ptr<Surface> surface, RenderCallback callback) const;
+  bool Render(std::unique_ptr<Surface> surface, RenderCallback callback);
 
   std::shared_ptr<Context> GetContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The statistics of the last frame successfully encoded by this
+  ///             renderer. These include the statistics of the onscreen pass
+  ///             and the buffers and textures created by the context
+  ///             allocators while the frame was being recorded.
+  ///
+  /// @return     The statistics of the last frame.
+  ///
+  FrameStats GetLastFrameStats() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Capture the render passes of the next frame rendered by this
+  ///             renderer. The capture is complete once the call to `Render`
+  ///             for that frame returns.
+  ///
+  /// @return     The capture that will be recorded into.
+  ///
+  std::shared_ptr<FrameCapture> CaptureNextFrame();
+
  private:
   std::shared_ptr<fml::Semaphore> frames_in_flight_sema_;
   std::shared_ptr<Context> context_;
+  mutable std::mutex frame_state_mutex_;
+  FrameStats last_frame_stats_;
+  std::shared_ptr<FrameCapture> next_frame_capture_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Renderer);
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/sampler_descriptor.h"
 
 namespace impeller {
 
@@ -14,10 +15,14 @@ class Sampler {
 
   virtual bool IsValid() const = 0;
 
+  const SamplerDescriptor& GetDescriptor() const;
+
  protected:
-  Sampler();
+  Sampler(SamplerDescriptor desc);
 
  private:
+  const SamplerDescriptor desc_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Sampler);
 };
 
@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/shader_bundle.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+struct BundleHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t reserved;
+};
+
+struct BundleEntry {
+  uint32_t stage;
+  uint32_t name_offset;
+  uint32_t name_length;
+  uint32_t reserved;
+  uint64_t data_offset;
+  uint64_t data_length;
+};
+
+static_assert(sizeof(BundleHeader) == 16u);
+static_assert(sizeof(BundleEntry) == 32u);
+
+static ShaderStage ToShaderStage(uint32_t stage) {
+  switch (stage) {
+    case 1u:
+      return ShaderStage::kVertex;
+    case 2u:
+      return ShaderStage::kFragment;
+  }
+  return ShaderStage::kUnknown;
+}
+
+static bool IsInBounds(uint64_t offset, uint64_t length, size_t size) {
+  return offset <= size && length <= size - offset;
+}
+
+std::shared_ptr<ShaderBundle> ShaderBundle::Open(const std::string& path) {
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  if (!mapping) {
+    VALIDATION_LOG << "Could not map shader bundle at '" << path << "'.";
+    return nullptr;
+  }
+  return Create(std::move(mapping));
+}
+
+std::shared_ptr<ShaderBundle> ShaderBundle::Create(
+    std::shared_ptr<const fml::Mapping> mapping) {
+  if (!mapping || mapping->GetMapping() == nullptr) {
+    return nullptr;
+  }
+  auto bundle = std::shared_ptr<ShaderBundle>(new ShaderBundle(mapping));
+  if (!bundle->ReadIndex()) {
+    return nullptr;
+  }
+  return bundle;
+}
+
+ShaderBundle::ShaderBundle(std::shared_ptr<const fml::Mapping> mapping)
+    : mapping_(std::move(mapping)) {}
+
+ShaderBundle::~ShaderBundle() = default;
+
+bool ShaderBundle::ReadIndex() {
+  const auto* data = mapping_->GetMapping();
+  const auto size = mapping_->GetSize();
+
+  BundleHeader header = {};
+  if (size < sizeof(header)) {
+    VALIDATION_LOG << "Mapping is not a shader bundle.";
+    return false;
+  }
+  ::memcpy(&header, data, sizeof(header));
+  if (header.magic != kBundleMagic) {
+    VALIDATION_LOG << "Mapping is not a shader bundle.";
+    return false;
+  }
+  if (header.version != kBundleVersion) {
+    VALIDATION_LOG << "Unsupported shader bundle version " << header.version
+                   << ".";
+    return false;
+  }
+  if (!IsInBounds(sizeof(header),
+                  uint64_t{header.entry_count} * sizeof(BundleEntry), size)) {
+    VALIDATION_LOG << "Shader bundle index is truncated.";
+    return false;
+  }
+
+  for (size_t i = 0; i < header.entry_count; i++) {
+    BundleEntry entry = {};
+    ::memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+    const auto stage = ToShaderStage(entry.stage);
+    if (stage == ShaderStage::kUnknown ||
+        !IsInBounds(entry.name_offset, entry.name_length, size) ||
+        !IsInBounds(entry.data_offset, entry.data_length, size)) {
+      VALIDATION_LOG << "Shader bundle entry " << i << " is invalid.";
+      return false;
+    }
+    std::string name(reinterpret_cast<const char*>(data + entry.name_offset),
+                     entry.name_length);
+    functions_[{stage, std::move(name)}] = {
+        static_cast<size_t>(entry.data_offset),
+        static_cast<size_t>(entry.data_length)};
+  }
+  return true;
+}
+
+size_t ShaderBundle::GetFunctionCount() const {
+  return functions_.size();
+}
+
+std::shared_ptr<fml::Mapping> ShaderBundle::GetFunctionData(
+    std::string_view name,
+    ShaderStage stage) const {
+  auto found = functions_.find({stage, std::string{name}});
+  if (found == functions_.end()) {
+    return nullptr;
+  }
+  const auto& range = found->second;
+  return std::make_shared<fml::NonOwnedMapping>(
+      mapping_->GetMapping() + range.offset,  // bytes
+      range.length,                           // byte size
+      [mapping = mapping_](const uint8_t*, size_t) {}  // release proc
+  );
+}
+
+}  // namespace impeller
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/renderer/shader_types.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A collection of individually compiled shader functions stored
+///             in a single file.
+///
+///             Bundles are created by `tools/create_shader_bundle.py`. The
+///             file starts with an index of the functions in it. The data of
+///             each function is aligned to `kFunctionAlignment` so that a
+///             memory mapped bundle only pages in the functions that are
+///             actually used. Opening a bundle only reads the index.
+///
+///             All integers are little endian. The layout is:
+///             ```
+///             uint32_t magic;        // kBundleMagic
+///             uint32_t version;      // kBundleVersion
+///             uint32_t entry_count;
+///             uint32_t reserved;
+///             struct {
+///               uint32_t stage;      // 1 for vertex, 2 for fragment.
+///               uint32_t name_offset;
+///               uint32_t name_length;
+///               uint32_t reserved;
+///               uint64_t data_offset;
+///               uint64_t data_length;
+///             } entries[entry_count];
+///             ```
+///             Offsets are from the start of the file. What the data of a
+///             function is depends on the backend. For instance, each Metal
+///             function is a Metal library of its own.
+///
+class ShaderBundle {
+ public:
+  static constexpr uint32_t kBundleMagic = 0x42535049;  // "IPSB"
+  static constexpr uint32_t kBundleVersion = 1u;
+  static constexpr size_t kFunctionAlignment = 4096u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Memory map the bundle at the given path and read its index.
+  ///
+  /// @return     The bundle or null if the file could not be mapped or is not
+  ///             a valid bundle.
+  ///
+  static std::shared_ptr<ShaderBundle> Open(const std::string& path);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Read the index of a bundle already in memory.
+  ///
+  /// @return     The bundle or null if the mapping is not a valid bundle.
+  ///
+  static std::shared_ptr<ShaderBundle> Create(
+      std::shared_ptr<const fml::Mapping> mapping);
+
+  ~ShaderBundle();
+
+  size_t GetFunctionCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the data of a function. The returned mapping refers to
+  ///             the bundle contents and keeps them alive. Nothing is copied.
+  ///
+  /// @param[in]  name   The entrypoint name of the function.
+  /// @param[in]  stage  The stage of the function.
+  ///
+  /// @return     The function data or null if the bundle has no such
+  ///             function.
+  ///
+  std::shared_ptr<fml::Mapping> GetFunctionData(std::string_view name,
+                                                ShaderStage stage) const;
+
+ private:
+  struct Range {
+    size_t offset = 0u;
+    size_t length = 0u;
+  };
+
+  const std::shared_ptr<const fml::Mapping> mapping_;
+  std::map<std::pair<ShaderStage, std::string>, Range> functions_;
+
+  explicit ShaderBundle(std::shared_ptr<const fml::Mapping> mapping);
+
+  bool ReadIndex();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShaderBundle);
+};
+
+}  // namespace impeller
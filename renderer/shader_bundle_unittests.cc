@@ -0,0 +1,201 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/shader_bundle.h"
+#include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/shader_library.h"
+
+namespace impeller {
+namespace testing {
+
+template <class T>
+static void Append(std::vector<uint8_t>& bytes, T value) {
+  const auto offset = bytes.size();
+  bytes.resize(offset + sizeof(T));
+  ::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+// Lays out a bundle the way tools/create_shader_bundle.py does.
+static std::vector<uint8_t> CreateBundle(
+    const std::vector<std::tuple<uint32_t, std::string, std::string>>&
+        functions) {
+  std::vector<uint8_t> bytes;
+  Append<uint32_t>(bytes, ShaderBundle::kBundleMagic);
+  Append<uint32_t>(bytes, ShaderBundle::kBundleVersion);
+  Append<uint32_t>(bytes, functions.size());
+  Append<uint32_t>(bytes, 0u);
+
+  const size_t index_size = 16u + functions.size() * 32u;
+  size_t names_size = 0u;
+  for (const auto& function : functions) {
+    names_size += std::get<1>(function).size();
+  }
+  auto align = [](size_t offset) {
+    const auto alignment = ShaderBundle::kFunctionAlignment;
+    return (offset + alignment - 1) / alignment * alignment;
+  };
+
+  size_t name_offset = index_size;
+  size_t data_offset = align(index_size + names_size);
+  std::vector<size_t> data_offsets;
+  for (const auto& [stage, name, data] : functions) {
+    Append<uint32_t>(bytes, stage);
+    Append<uint32_t>(bytes, name_offset);
+    Append<uint32_t>(bytes, name.size());
+    Append<uint32_t>(bytes, 0u);
+    Append<uint64_t>(bytes, data_offset);
+    Append<uint64_t>(bytes, data.size());
+    data_offsets.push_back(data_offset);
+    name_offset += name.size();
+    data_offset = align(data_offset + data.size());
+  }
+  for (const auto& function : functions) {
+    const auto& name = std::get<1>(function);
+    bytes.insert(bytes.end(), name.begin(), name.end());
+  }
+  for (size_t i = 0; i < functions.size(); i++) {
+    const auto& data = std::get<2>(functions[i]);
+    bytes.resize(data_offsets[i]);
+    bytes.insert(bytes.end(), data.begin(), data.end());
+  }
+  return bytes;
+}
+
+static std::string ToString(const std::shared_ptr<fml::Mapping>& mapping) {
+  return {reinterpret_cast<const char*>(mapping->GetMapping()),
+          mapping->GetSize()};
+}
+
+TEST(ShaderBundleTest, CanLoadFunctionsFromMappedFile) {
+  const auto bytes = CreateBundle({
+      {1u, "solid_fill_vertex_main", "vertex data"},
+      {2u, "solid_fill_fragment_main", "fragment data"},
+  });
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(fml::WriteAtomically(
+      temp_dir.fd(), "shaders.bundle",
+      fml::NonOwnedMapping(bytes.data(), bytes.size())));
+
+  auto bundle = ShaderBundle::Open(
+      fml::paths::JoinPaths({temp_dir.path(), "shaders.bundle"}));
+  ASSERT_TRUE(bundle);
+  ASSERT_EQ(bundle->GetFunctionCount(), 2u);
+
+  auto vertex =
+      bundle->GetFunctionData("solid_fill_vertex_main", ShaderStage::kVertex);
+  ASSERT_TRUE(vertex);
+  ASSERT_EQ(ToString(vertex), "vertex data");
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(vertex->GetMapping()) %
+                ShaderBundle::kFunctionAlignment,
+            0u);
+
+  auto fragment = bundle->GetFunctionData("solid_fill_fragment_main",
+                                          ShaderStage::kFragment);
+  ASSERT_TRUE(fragment);
+  ASSERT_EQ(ToString(fragment), "fragment data");
+
+  ASSERT_FALSE(bundle->GetFunctionData("solid_fill_vertex_main",
+                                       ShaderStage::kFragment));
+  ASSERT_FALSE(bundle->GetFunctionData("missing", ShaderStage::kVertex));
+
+  // Function data keeps the bundle mapped.
+  bundle.reset();
+  ASSERT_EQ(ToString(vertex), "vertex data");
+}
+
+TEST(ShaderBundleTest, RejectsInvalidBundles) {
+  auto bytes = CreateBundle({{1u, "main", "data"}});
+  ASSERT_TRUE(ShaderBundle::Create(
+      std::make_shared<fml::NonOwnedMapping>(bytes.data(), bytes.size())));
+
+  // Truncated function data.
+  ASSERT_FALSE(ShaderBundle::Create(
+      std::make_shared<fml::NonOwnedMapping>(bytes.data(), bytes.size() - 1)));
+
+  // Not a bundle.
+  bytes[0] = 0u;
+  ASSERT_FALSE(ShaderBundle::Create(
+      std::make_shared<fml::NonOwnedMapping>(bytes.data(), bytes.size())));
+}
+
+class TestShaderFunction final : public ShaderFunction {
+ public:
+  TestShaderFunction(std::string name,
+                     ShaderStage stage,
+                     std::shared_ptr<fml::Mapping> data)
+      : ShaderFunction(UniqueID{}, std::move(name), stage),
+        data_(std::move(data)) {}
+
+  const std::shared_ptr<fml::Mapping>& GetData() const { return data_; }
+
+ private:
+  std::shared_ptr<fml::Mapping> data_;
+};
+
+// Creates functions from bundles only. Backends also cache them.
+class TestShaderLibrary final : public ShaderLibrary {
+ public:
+  explicit TestShaderLibrary(
+      std::vector<std::shared_ptr<ShaderBundle>> bundles)
+      : ShaderLibrary(std::move(bundles)) {}
+
+  // |ShaderLibrary|
+  bool IsValid() const override { return HasBundles(); }
+
+  // |ShaderLibrary|
+  std::shared_ptr<const ShaderFunction> GetFunction(
+      const std::string_view& name,
+      ShaderStage stage) override {
+    return CreateFunctionFromBundles(name, stage);
+  }
+
+ private:
+  // |ShaderLibrary|
+  std::shared_ptr<const ShaderFunction> OnCreateFunctionFromData(
+      const std::string_view& name,
+      ShaderStage stage,
+      std::shared_ptr<fml::Mapping> data) override {
+    return std::make_shared<TestShaderFunction>(
+        std::string{name}, stage, std::move(data));
+  }
+};
+
+TEST(ShaderBundleTest, LibrariesCreateFunctionsFromTheFirstBundleWithThem) {
+  const auto first_bytes = CreateBundle({{1u, "vertex_main", "first"}});
+  const auto second_bytes = CreateBundle({
+      {1u, "vertex_main", "second"},
+      {2u, "fragment_main", "fragment data"},
+  });
+  TestShaderLibrary library({
+      ShaderBundle::Create(std::make_shared<fml::NonOwnedMapping>(
+          first_bytes.data(), first_bytes.size())),
+      ShaderBundle::Create(std::make_shared<fml::NonOwnedMapping>(
+          second_bytes.data(), second_bytes.size())),
+  });
+  ASSERT_TRUE(library.IsValid());
+
+  auto vertex = std::static_pointer_cast<const TestShaderFunction>(
+      library.GetFunction("vertex_main", ShaderStage::kVertex));
+  ASSERT_TRUE(vertex);
+  ASSERT_EQ(vertex->GetName(), "vertex_main");
+  ASSERT_EQ(ToString(vertex->GetData()), "first");
+
+  auto fragment = std::static_pointer_cast<const TestShaderFunction>(
+      library.GetFunction("fragment_main", ShaderStage::kFragment));
+  ASSERT_TRUE(fragment);
+  ASSERT_EQ(ToString(fragment->GetData()), "fragment data");
+
+  ASSERT_FALSE(library.GetFunction("fragment_main", ShaderStage::kVertex));
+}
+
+}  // namespace testing
+}  // namespace impeller
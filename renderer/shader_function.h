@@ -18,6 +18,8 @@ class ShaderFunction : public Comparable<ShaderFunction> {
 
   ShaderStage GetStage() const;
 
+  const std::string& GetName() const;
+
   // |Comparable<ShaderFunction>|
   std::size_t GetHash() const override;
 
@@ -4,10 +4,42 @@
 
 #include "impeller/renderer/shader_library.h"
 
+#include "impeller/base/validation.h"
+#include "impeller/renderer/shader_bundle.h"
+
 namespace impeller {
 
 ShaderLibrary::ShaderLibrary() = default;
 
+ShaderLibrary::ShaderLibrary(
+    std::vector<std::shared_ptr<ShaderBundle>> bundles)
+    : bundles_(std::move(bundles)) {}
+
 ShaderLibrary::~ShaderLibrary() = default;
 
+bool ShaderLibrary::HasBundles() const {
+  return !bundles_.empty();
+}
+
+std::shared_ptr<const ShaderFunction> ShaderLibrary::CreateFunctionFromBundles(
+    const std::string_view& name,
+    ShaderStage stage) {
+  for (const auto& bundle : bundles_) {
+    if (auto data = bundle->GetFunctionData(name, stage)) {
+      return OnCreateFunctionFromData(name, stage, std::move(data));
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const ShaderFunction> ShaderLibrary::OnCreateFunctionFromData(
+    const std::string_view& name,
+    ShaderStage stage,
+    std::shared_ptr<fml::Mapping> data) {
+  VALIDATION_LOG << "Shader function '" << name
+                 << "' is bundled but this backend can't create functions "
+                    "from bundles.";
+  return nullptr;
+}
+
 }  // namespace impeller
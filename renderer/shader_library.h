@@ -6,13 +6,16 @@
 
 #include <memory>
 #include <string_view>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "impeller/renderer/shader_types.h"
 
 namespace impeller {
 
 class Context;
+class ShaderBundle;
 class ShaderFunction;
 
 class ShaderLibrary {
@@ -28,7 +31,38 @@ class ShaderLibrary {
  protected:
   ShaderLibrary();
 
+  explicit ShaderLibrary(std::vector<std::shared_ptr<ShaderBundle>> bundles);
+
+  bool HasBundles() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a function from the first bundle of this library that
+  ///             has it. Only the data of that function is paged in. Backends
+  ///             call this for functions they don't have otherwise and are
+  ///             responsible for caching the result.
+  ///
+  /// @return     The function or null if no bundle has it or the backend could
+  ///             not create it from its data.
+  ///
+  std::shared_ptr<const ShaderFunction> CreateFunctionFromBundles(
+      const std::string_view& name,
+      ShaderStage stage);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a function from its data in a bundle. The data refers
+  ///             to the mapped bundle and must be referenced for as long as
+  ///             the backend needs it. The format of the data depends on the
+  ///             backend. Backends that can't create functions from data
+  ///             don't override this and reject every bundled function.
+  ///
+  virtual std::shared_ptr<const ShaderFunction> OnCreateFunctionFromData(
+      const std::string_view& name,
+      ShaderStage stage,
+      std::shared_ptr<fml::Mapping> data);
+
  private:
+  std::vector<std::shared_ptr<ShaderBundle>> bundles_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ShaderLibrary);
 };
 
@@ -6,7 +6,13 @@
 
 namespace impeller {
 
-Texture::Texture(TextureDescriptor desc) : desc_(std::move(desc)) {}
+static size_t NextContentsGeneration() {
+  static std::atomic_size_t next_generation = 1u;
+  return next_generation.fetch_add(1u, std::memory_order_relaxed);
+}
+
+Texture::Texture(TextureDescriptor desc)
+    : desc_(std::move(desc)), contents_generation_(NextContentsGeneration()) {}
 
 Texture::~Texture() = default;
 
@@ -14,4 +20,29 @@ const TextureDescriptor& Texture::GetTextureDescriptor() const {
   return desc_;
 }
 
+void Texture::SetIsOpaque(bool is_opaque) {
+  is_opaque_ = is_opaque;
+}
+
+bool Texture::IsOpaque() const {
+  return is_opaque_;
+}
+
+bool Texture::SetContents(const uint8_t* contents, size_t length) {
+  if (!OnSetContents(contents, length)) {
+    return false;
+  }
+  MarkContentsModified();
+  return true;
+}
+
+size_t Texture::GetContentsGeneration() const {
+  return contents_generation_.load(std::memory_order_relaxed);
+}
+
+void Texture::MarkContentsModified() {
+  contents_generation_.store(NextContentsGeneration(),
+                             std::memory_order_relaxed);
+}
+
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string_view>
 
 #include "flutter/fml/macros.h"
@@ -19,8 +20,26 @@ class Texture {
 
   virtual void SetLabel(const std::string_view& label) = 0;
 
-  [[nodiscard]] virtual bool SetContents(const uint8_t* contents,
-                                         size_t length) = 0;
+  //----------------------------------------------------------------------------
+  /// @brief      Replace the contents of the base mip level. This starts a new
+  ///             contents generation.
+  ///
+  [[nodiscard]] bool SetContents(const uint8_t* contents, size_t length);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Read back the contents of the base mip level into host memory.
+  ///             This is used to capture frames for replay and is not meant
+  ///             to be used on the hot path.
+  ///
+  /// @param      contents  The destination of the read back.
+  /// @param[in]  length    The length of the destination. This must be the
+  ///                       size of the base mip level.
+  ///
+  /// @return     If the contents could be read back. Textures in device
+  ///             private memory cannot be read back.
+  ///
+  [[nodiscard]] virtual bool GetContents(uint8_t* contents,
+                                         size_t length) const = 0;
 
   virtual bool IsValid() const = 0;
 
@@ -28,11 +47,43 @@ class Texture {
 
   const TextureDescriptor& GetTextureDescriptor() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Declare that every pixel of the texture is opaque. This lets
+  ///             draws of the texture hide whatever is beneath them. It is
+  ///             the responsibility of the caller to only set this for
+  ///             contents without an alpha channel. Textures are not opaque
+  ///             by default.
+  ///
+  void SetIsOpaque(bool is_opaque);
+
+  bool IsOpaque() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Identifies the current contents of the texture. A generation
+  ///             that is unique across all textures is assigned when the
+  ///             texture is created and whenever its contents are modified
+  ///             from the host. So a texture that is modified in place, or a
+  ///             new texture at the address of a discarded one, never has the
+  ///             generation of an earlier texture.
+  ///
+  size_t GetContentsGeneration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start a new contents generation. Copies into the texture do
+  ///             this when they are encoded.
+  ///
+  void MarkContentsModified();
+
  protected:
   Texture(TextureDescriptor desc);
 
+  [[nodiscard]] virtual bool OnSetContents(const uint8_t* contents,
+                                           size_t length) = 0;
+
  private:
   const TextureDescriptor desc_;
+  bool is_opaque_ = false;
+  std::atomic_size_t contents_generation_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
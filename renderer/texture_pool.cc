@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/texture_pool.h"
+
+#include <algorithm>
+
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+static bool DescriptorsMatch(const TextureDescriptor& a,
+                             const TextureDescriptor& b) {
+  return a.type == b.type &&                  //
+         a.format == b.format &&              //
+         a.size == b.size &&                  //
+         a.mip_count == b.mip_count &&        //
+         a.usage == b.usage &&                //
+         a.sample_count == b.sample_count;
+}
+
+static size_t GetTextureBytes(const TextureDescriptor& desc) {
+  return desc.GetSizeOfBaseMipLevel() * static_cast<size_t>(desc.sample_count);
+}
+
+TexturePool::TexturePool(std::shared_ptr<Allocator> allocator, size_t budget)
+    : allocator_(std::move(allocator)), budget_(budget) {}
+
+TexturePool::~TexturePool() = default;
+
+bool TexturePool::Entry::IsIdle() const {
+  // Only the pool holds a reference.
+  return texture.use_count() == 1;
+}
+
+ISize TexturePool::RoundUpSize(ISize size) {
+  auto round_up = [](ISize::Type value) {
+    return (value + kSizeGranularity - 1) / kSizeGranularity *
+           kSizeGranularity;
+  };
+  return {round_up(size.width), round_up(size.height)};
+}
+
+std::shared_ptr<Texture> TexturePool::CreateTexture(
+    StorageMode mode,
+    const TextureDescriptor& p_desc) {
+  if (!allocator_ || !p_desc.IsValid()) {
+    return nullptr;
+  }
+
+  auto desc = p_desc;
+  desc.size = RoundUpSize(desc.size);
+
+  std::scoped_lock lock(mutex_);
+
+  for (auto& entry : entries_) {
+    if (entry.mode == mode && DescriptorsMatch(entry.desc, desc) &&
+        entry.IsIdle()) {
+      entry.last_used_frame = frame_;
+      textures_reused_++;
+      return entry.texture;
+    }
+  }
+
+  auto texture = allocator_->CreateTexture(mode, desc);
+  if (!texture) {
+    return nullptr;
+  }
+  textures_created_++;
+
+  const auto bytes = GetTextureBytes(desc);
+  while (pooled_bytes_ + bytes > budget_ && EvictLeastRecentlyUsed()) {
+  }
+
+  // The texture is still handed out if it doesn't fit in the budget. It just
+  // won't be recycled.
+  if (pooled_bytes_ + bytes <= budget_) {
+    Entry entry;
+    entry.mode = mode;
+    entry.desc = desc;
+    entry.texture = texture;
+    entry.bytes = bytes;
+    entry.last_used_frame = frame_;
+    entries_.emplace_back(std::move(entry));
+    pooled_bytes_ += bytes;
+  }
+
+  return texture;
+}
+
+bool TexturePool::Release(const std::shared_ptr<Texture>& texture) {
+  std::scoped_lock lock(mutex_);
+  auto found = std::find_if(
+      entries_.begin(), entries_.end(),
+      [&](const Entry& entry) { return entry.texture == texture; });
+  if (found == entries_.end()) {
+    return false;
+  }
+  pooled_bytes_ -= found->bytes;
+  entries_.erase(found);
+  return true;
+}
+
+bool TexturePool::EvictLeastRecentlyUsed() {
+  auto found = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->IsIdle() && (found == entries_.end() ||
+                         it->last_used_frame < found->last_used_frame)) {
+      found = it;
+    }
+  }
+  if (found == entries_.end()) {
+    return false;
+  }
+  pooled_bytes_ -= found->bytes;
+  textures_evicted_++;
+  entries_.erase(found);
+  return true;
+}
+
+void TexturePool::EndFrame() {
+  std::scoped_lock lock(mutex_);
+  frame_++;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->IsIdle() && frame_ - it->last_used_frame > kMaxUnusedFrames) {
+      pooled_bytes_ -= it->bytes;
+      textures_evicted_++;
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+size_t TexturePool::GetTexturesCreated() const {
+  std::scoped_lock lock(mutex_);
+  return textures_created_;
+}
+
+size_t TexturePool::GetTexturesReused() const {
+  std::scoped_lock lock(mutex_);
+  return textures_reused_;
+}
+
+size_t TexturePool::GetTexturesEvicted() const {
+  std::scoped_lock lock(mutex_);
+  return textures_evicted_;
+}
+
+size_t TexturePool::GetPooledBytes() const {
+  std::scoped_lock lock(mutex_);
+  return pooled_bytes_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/size.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/texture_descriptor.h"
+
+namespace impeller {
+
+class Texture;
+
+//------------------------------------------------------------------------------
+/// @brief      Recycles textures that would otherwise be created and discarded
+///             every frame, like the render targets of offscreen passes.
+///
+///             Textures are matched by storage mode and descriptor. Sizes are
+///             rounded up to a multiple of `kSizeGranularity` so that a texture
+///             can be reused while the requested size changes slightly from
+///             frame to frame. Callers must only use the region of the texture
+///             they asked for.
+///
+///             A texture goes back to the pool once the last reference to it
+///             outside the pool is dropped. Idle textures are evicted if they
+///             have not been used for `kMaxUnusedFrames` frames. The least
+///             recently used idle textures are also evicted to keep the
+///             textures held by the pool within the memory budget. Textures
+///             that are released from the pool no longer count against it.
+///
+///             The pool may be used from multiple threads.
+///
+class TexturePool {
+ public:
+  static constexpr ISize::Type kSizeGranularity = 64;
+
+  static constexpr size_t kMaxUnusedFrames = 3u;
+
+  static constexpr size_t kDefaultBudget = 256u * 1024u * 1024u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a texture pool.
+  ///
+  /// @param[in]  allocator  The allocator used to create textures that cannot
+  ///                        be recycled.
+  /// @param[in]  budget     The number of bytes of texture memory the pool may
+  ///                        hold on to.
+  ///
+  TexturePool(std::shared_ptr<Allocator> allocator,
+              size_t budget = kDefaultBudget);
+
+  ~TexturePool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get an idle texture matching the descriptor or create a new
+  ///             one.
+  ///
+  /// @param[in]  mode  The storage mode of the texture.
+  /// @param[in]  desc  The description of the texture. The size of the
+  ///                   texture may be larger than the size requested here.
+  ///
+  /// @return     The texture or null if one could not be created.
+  ///
+  std::shared_ptr<Texture> CreateTexture(StorageMode mode,
+                                         const TextureDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stop tracking a texture handed out by the pool. The texture
+  ///             will never be recycled and no longer counts against the
+  ///             budget of the pool. Owners that keep textures across frames
+  ///             within a budget of their own, like the raster cache, release
+  ///             them so that they are not accounted for twice.
+  ///
+  /// @return     Whether the texture was tracked by the pool.
+  ///
+  bool Release(const std::shared_ptr<Texture>& texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame and evict textures that have been
+  ///             idle for too long.
+  ///
+  void EndFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of textures created by the pool over its lifetime.
+  ///             This stops growing once the frames rendered reach a steady
+  ///             state.
+  ///
+  size_t GetTexturesCreated() const;
+
+  size_t GetTexturesReused() const;
+
+  size_t GetTexturesEvicted() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of bytes of texture memory held by the pool. This
+  ///             includes textures that are currently in use.
+  ///
+  size_t GetPooledBytes() const;
+
+  static ISize RoundUpSize(ISize size);
+
+ private:
+  struct Entry {
+    StorageMode mode;
+    TextureDescriptor desc;
+    std::shared_ptr<Texture> texture;
+    size_t bytes = 0u;
+    size_t last_used_frame = 0u;
+
+    bool IsIdle() const;
+  };
+
+  const std::shared_ptr<Allocator> allocator_;
+  const size_t budget_;
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+  size_t frame_ = 0u;
+  size_t pooled_bytes_ = 0u;
+  size_t textures_created_ = 0u;
+  size_t textures_reused_ = 0u;
+  size_t textures_evicted_ = 0u;
+
+  bool EvictLeastRecentlyUsed();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TexturePool);
+};
+
+}  // namespace impeller
@@ -0,0 +1,255 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/texture_upload_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+
+#include "impeller/base/validation.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/formats.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+// Copies out of staging buffers must start at offsets aligned to the texel
+// size. This is a multiple of the texel size of all pixel formats.
+static constexpr size_t kStagingAlignment = 256u;
+
+static constexpr size_t AlignStagingOffset(size_t offset) {
+  return (offset + kStagingAlignment - 1u) / kStagingAlignment *
+         kStagingAlignment;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The staging buffers not referenced by an in-flight command
+///             buffer. This is shared with the completion callbacks of
+///             submitted uploads as those may outlive the queue.
+///
+class TextureUploadQueue::StagingPool {
+ public:
+  explicit StagingPool(std::shared_ptr<Allocator> allocator)
+      : allocator_(std::move(allocator)) {}
+
+  std::optional<StagingBuffer> Acquire(size_t length) {
+    {
+      std::scoped_lock lock(mutex_);
+      // Pick the smallest free buffer that fits.
+      auto found = free_buffers_.end();
+      for (auto it = free_buffers_.begin(); it != free_buffers_.end(); ++it) {
+        if (it->size >= length &&
+            (found == free_buffers_.end() || it->size < found->size)) {
+          found = it;
+        }
+      }
+      if (found != free_buffers_.end()) {
+        auto buffer = std::move(*found);
+        free_buffers_.erase(found);
+        return buffer;
+      }
+    }
+
+    StagingBuffer buffer;
+    buffer.size = std::max(kStagingBufferSize, length);
+    buffer.buffer =
+        allocator_->CreateBuffer(StorageMode::kHostVisible, buffer.size);
+    if (!buffer.buffer) {
+      VALIDATION_LOG << "Could not allocate texture staging buffer.";
+      return std::nullopt;
+    }
+    buffer.buffer->SetLabel("Impeller Texture Staging Buffer");
+    buffers_created_.fetch_add(1u, std::memory_order_relaxed);
+    return buffer;
+  }
+
+  void Release(std::vector<StagingBuffer> buffers) {
+    std::scoped_lock lock(mutex_);
+    for (auto& buffer : buffers) {
+      buffer.used = 0u;
+      free_buffers_.emplace_back(std::move(buffer));
+    }
+  }
+
+  size_t GetBuffersCreated() const {
+    return buffers_created_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const std::shared_ptr<Allocator> allocator_;
+  std::mutex mutex_;
+  std::vector<StagingBuffer> free_buffers_;
+  std::atomic_size_t buffers_created_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StagingPool);
+};
+
+TextureUploadQueue::TextureUploadQueue(std::shared_ptr<Context> context)
+    : context_(std::move(context)),
+      staging_pool_(std::make_shared<StagingPool>(
+          context_ ? context_->GetPermanentsAllocator() : nullptr)) {
+  if (!context_ || !context_->IsValid() ||
+      !context_->GetPermanentsAllocator()) {
+    return;
+  }
+  is_valid_ = true;
+}
+
+TextureUploadQueue::~TextureUploadQueue() {
+  std::scoped_lock lock(mutex_);
+  for (auto& upload : pending_uploads_) {
+    upload.promise.set_value(false);
+  }
+}
+
+bool TextureUploadQueue::IsValid() const {
+  return is_valid_;
+}
+
+static TextureUploadQueue::UploadFuture MakeFailedUpload() {
+  std::promise<bool> promise;
+  promise.set_value(false);
+  return promise.get_future().share();
+}
+
+TextureUploadQueue::UploadFuture TextureUploadQueue::EnqueueUpload(
+    std::shared_ptr<Texture> texture,
+    const uint8_t* contents,
+    size_t length) {
+  if (!texture) {
+    return MakeFailedUpload();
+  }
+  const auto region = IRect::MakeSize(texture->GetSize());
+  return EnqueueUpload(std::move(texture), contents, length, region);
+}
+
+TextureUploadQueue::UploadFuture TextureUploadQueue::EnqueueUpload(
+    std::shared_ptr<Texture> texture,
+    const uint8_t* contents,
+    size_t length,
+    IRect region) {
+  if (!IsValid() || !texture || !texture->IsValid() || !contents) {
+    VALIDATION_LOG << "Invalid texture upload.";
+    return MakeFailedUpload();
+  }
+
+  if (region.IsEmpty() ||
+      !(IRect::MakeSize(texture->GetSize()).Intersection(region) == region)) {
+    VALIDATION_LOG << "Texture upload region is out of bounds of the texture.";
+    return MakeFailedUpload();
+  }
+
+  const auto bytes_per_pixel =
+      BytesPerPixelForPixelFormat(texture->GetTextureDescriptor().format);
+  if (length != region.size.width * region.size.height * bytes_per_pixel) {
+    VALIDATION_LOG << "Texture upload contents do not match the region size.";
+    return MakeFailedUpload();
+  }
+
+  std::scoped_lock lock(mutex_);
+
+  std::shared_ptr<DeviceBuffer> staging_buffer;
+  Range staging_range;
+  if (!AllocateStagingRange(length, staging_buffer, staging_range) ||
+      !staging_buffer->CopyHostBuffer(contents, Range{0u, length},
+                                      staging_range.offset)) {
+    return MakeFailedUpload();
+  }
+
+  PendingUpload upload;
+  upload.staging_buffer = std::move(staging_buffer);
+  upload.staging_range = staging_range;
+  upload.texture = std::move(texture);
+  upload.region = region;
+  auto future = upload.promise.get_future().share();
+  pending_uploads_.emplace_back(std::move(upload));
+  return future;
+}
+
+bool TextureUploadQueue::AllocateStagingRange(
+    size_t length,
+    std::shared_ptr<DeviceBuffer>& buffer,
+    Range& range) {
+  if (!pending_staging_buffers_.empty()) {
+    auto& staging = pending_staging_buffers_.back();
+    const auto offset = AlignStagingOffset(staging.used);
+    if (offset + length <= staging.size) {
+      staging.used = offset + length;
+      buffer = staging.buffer;
+      range = Range{offset, length};
+      return true;
+    }
+  }
+
+  auto staging = staging_pool_->Acquire(length);
+  if (!staging.has_value()) {
+    return false;
+  }
+  staging->used = length;
+  buffer = staging->buffer;
+  range = Range{0u, length};
+  pending_staging_buffers_.emplace_back(std::move(staging.value()));
+  return true;
+}
+
+bool TextureUploadQueue::Flush() {
+  std::vector<PendingUpload> uploads;
+  auto staging_buffers = std::make_shared<std::vector<StagingBuffer>>();
+  {
+    std::scoped_lock lock(mutex_);
+    std::swap(uploads, pending_uploads_);
+    std::swap(*staging_buffers, pending_staging_buffers_);
+  }
+
+  if (uploads.empty()) {
+    staging_pool_->Release(std::move(*staging_buffers));
+    return true;
+  }
+
+  auto command_buffer = context_->CreateTransferCommandBuffer();
+  if (!command_buffer) {
+    VALIDATION_LOG << "Could not create transfer command buffer.";
+    for (auto& upload : uploads) {
+      upload.promise.set_value(false);
+    }
+    staging_pool_->Release(std::move(*staging_buffers));
+    return false;
+  }
+  command_buffer->SetLabel("Texture Uploads");
+
+  auto promises = std::make_shared<std::vector<std::promise<bool>>>();
+  for (auto& upload : uploads) {
+    if (!command_buffer->CopyBufferToTexture(
+            std::move(upload.staging_buffer), upload.staging_range,
+            std::move(upload.texture), upload.region)) {
+      upload.promise.set_value(false);
+      continue;
+    }
+    promises->emplace_back(std::move(upload.promise));
+  }
+
+  return command_buffer->SubmitCommands(
+      [promises, staging_buffers,
+       staging_pool = staging_pool_](CommandBuffer::Status status) {
+        for (auto& promise : *promises) {
+          promise.set_value(status == CommandBuffer::Status::kCompleted);
+        }
+        staging_pool->Release(std::move(*staging_buffers));
+      });
+}
+
+size_t TextureUploadQueue::GetPendingUploadCount() const {
+  std::scoped_lock lock(mutex_);
+  return pending_uploads_.size();
+}
+
+size_t TextureUploadQueue::GetStagingBuffersCreated() const {
+  return staging_pool_->GetBuffersCreated();
+}
+
+}  // namespace impeller
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/range.h"
+
+namespace impeller {
+
+class Context;
+class DeviceBuffer;
+class Texture;
+
+//------------------------------------------------------------------------------
+/// @brief      Uploads texture contents using the transfer queue of a context
+///             instead of stalling the thread that updates the texture.
+///
+///             Contents are copied into host visible staging buffers when an
+///             upload is enqueued. All pending uploads are encoded into a
+///             single transfer command buffer when the queue is flushed. The
+///             staging buffers are reused once that command buffer has
+///             completed.
+///
+///             Each upload returns a future that resolves once the device has
+///             finished the copy. Draws referencing the texture may check the
+///             future and skip the texture till it is resident.
+///
+///             Uploads may be enqueued and flushed on any thread.
+///
+class TextureUploadQueue {
+ public:
+  using UploadFuture = std::shared_future<bool>;
+
+  //----------------------------------------------------------------------------
+  /// The minimum size of a staging buffer. Small uploads share a staging
+  /// buffer. Uploads larger than this get a staging buffer of their own.
+  ///
+  static constexpr size_t kStagingBufferSize = 4u * 1024u * 1024u;
+
+  explicit TextureUploadQueue(std::shared_ptr<Context> context);
+
+  ~TextureUploadQueue();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enqueue an upload of tightly packed texels into a region of
+  ///             the base mip level of a texture. The contents are copied
+  ///             before this call returns.
+  ///
+  /// @param[in]  texture   The texture to update.
+  /// @param[in]  contents  The texels of the region.
+  /// @param[in]  length    The length of the contents. This must be the size
+  ///                       of the region in the pixel format of the texture.
+  /// @param[in]  region    The region of the texture to update.
+  ///
+  /// @return     A future that resolves to true once the texture has been
+  ///             updated and false if the upload failed. Uploads are only
+  ///             submitted to the device when the queue is flushed.
+  ///
+  UploadFuture EnqueueUpload(std::shared_ptr<Texture> texture,
+                             const uint8_t* contents,
+                             size_t length,
+                             IRect region);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enqueue an upload of the entire base mip level of a texture.
+  ///
+  /// @see        `EnqueueUpload(texture, contents, length, region)`
+  ///
+  UploadFuture EnqueueUpload(std::shared_ptr<Texture> texture,
+                             const uint8_t* contents,
+                             size_t length);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submit all pending uploads in a single transfer command
+  ///             buffer.
+  ///
+  /// @return     If the uploads could be submitted. The futures of uploads
+  ///             that could not be submitted resolve to false.
+  ///
+  bool Flush();
+
+  size_t GetPendingUploadCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of staging buffers created over the lifetime of
+  ///             this queue. This only grows when uploads are enqueued faster
+  ///             than the device completes them.
+  ///
+  size_t GetStagingBuffersCreated() const;
+
+ private:
+  struct StagingBuffer {
+    std::shared_ptr<DeviceBuffer> buffer;
+    size_t size = 0u;
+    size_t used = 0u;
+  };
+
+  struct PendingUpload {
+    std::shared_ptr<const DeviceBuffer> staging_buffer;
+    Range staging_range;
+    std::shared_ptr<Texture> texture;
+    IRect region;
+    std::promise<bool> promise;
+  };
+
+  class StagingPool;
+
+  const std::shared_ptr<Context> context_;
+  const std::shared_ptr<StagingPool> staging_pool_;
+  mutable std::mutex mutex_;
+  std::vector<PendingUpload> pending_uploads_;
+  std::vector<StagingBuffer> pending_staging_buffers_;
+  bool is_valid_ = false;
+
+  bool AllocateStagingRange(size_t length,
+                            std::shared_ptr<DeviceBuffer>& buffer,
+                            Range& range);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextureUploadQueue);
+};
+
+}  // namespace impeller
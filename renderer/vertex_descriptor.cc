@@ -15,7 +15,9 @@ bool VertexDescriptor::SetStageInputs(
     size_t count) {
   inputs_.reserve(inputs_.size() + count);
   for (size_t i = 0; i < count; i++) {
-    inputs_.emplace_back(*stage_inputs[i]);
+    const auto& input = *stage_inputs[i];
+    inputs_.emplace_back(input);
+    stride_ += input.bit_width * input.vec_size * input.columns / 8u;
   }
   return true;
 }
@@ -38,4 +40,8 @@ const std::vector<ShaderStageIOSlot>& VertexDescriptor::GetStageInputs() const {
   return inputs_;
 }
 
+size_t VertexDescriptor::GetStride() const {
+  return stride_;
+}
+
 }  // namespace impeller
@@ -41,6 +41,12 @@ class VertexDescriptor final : public Comparable<VertexDescriptor> {
 
   const std::vector<ShaderStageIOSlot>& GetStageInputs() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes between consecutive vertices in the
+  ///             vertex buffer. The stage inputs are tightly packed.
+  ///
+  size_t GetStride() const;
+
   // |Comparable<VertexDescriptor>|
   std::size_t GetHash() const override;
 
@@ -49,6 +55,7 @@ class VertexDescriptor final : public Comparable<VertexDescriptor> {
 
  private:
   std::vector<ShaderStageIOSlot> inputs_;
+  size_t stride_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(VertexDescriptor);
 };
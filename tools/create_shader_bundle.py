@@ -0,0 +1,90 @@
+# Copyright 2013 The Flutter Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+import sys
+
+import argparse
+import errno
+import os
+import struct
+
+# These must match the constants in impeller/renderer/shader_bundle.h.
+BUNDLE_MAGIC = 0x42535049
+BUNDLE_VERSION = 1
+FUNCTION_ALIGNMENT = 4096
+
+HEADER_FORMAT = "<IIII"
+ENTRY_FORMAT = "<IIIIQQ"
+
+STAGES = {
+  ".vert": (1, "vertex"),
+  ".frag": (2, "fragment"),
+}
+
+def MakeDirectories(path):
+  try:
+    os.makedirs(path)
+  except OSError as exc:
+    if exc.errno == errno.EEXIST and os.path.isdir(path):
+      pass
+    else:
+      raise
+
+def Align(offset, alignment):
+  return (offset + alignment - 1) // alignment * alignment
+
+# Entrypoint names are derived from the shader file names the same way
+# impellerc does it. See Compiler::EntryPointFromSourceName.
+def FunctionFromShaderName(shader_name):
+  stem, extension = os.path.splitext(shader_name)
+  if extension not in STAGES:
+    raise Exception("Unknown shader stage for '%s'." % shader_name)
+  stage, stage_name = STAGES[extension]
+  return stage, "%s_%s_main" % (stem, stage_name)
+
+def Main():
+  parser = argparse.ArgumentParser()
+  parser.add_argument("--output",
+                    type=str, required=True,
+                    help="The location to generate the shader bundle to.")
+  parser.add_argument("--shader",
+                    type=str, action="append", required=True,
+                    help="A shader file name and the path of its compiled data "
+                         "separated by a colon. Can be specified multiple times.")
+
+  args = parser.parse_args()
+
+  functions = []
+  for shader in args.shader:
+    shader_name, data_path = shader.split(":", 1)
+    stage, name = FunctionFromShaderName(os.path.basename(shader_name))
+    with open(data_path, "rb") as data_file:
+      functions.append((stage, name.encode("utf-8"), data_file.read()))
+
+  index_size = struct.calcsize(HEADER_FORMAT) + \
+      len(functions) * struct.calcsize(ENTRY_FORMAT)
+  names_size = sum(len(name) for _, name, _ in functions)
+
+  entries = []
+  name_offset = index_size
+  data_offset = Align(index_size + names_size, FUNCTION_ALIGNMENT)
+  for stage, name, data in functions:
+    entries.append((stage, name_offset, len(name), 0, data_offset, len(data)))
+    name_offset += len(name)
+    data_offset = Align(data_offset + len(data), FUNCTION_ALIGNMENT)
+
+  MakeDirectories(os.path.dirname(os.path.abspath(args.output)))
+  with open(args.output, "wb") as bundle:
+    bundle.write(struct.pack(HEADER_FORMAT, BUNDLE_MAGIC, BUNDLE_VERSION,
+                             len(functions), 0))
+    for entry in entries:
+      bundle.write(struct.pack(ENTRY_FORMAT, *entry))
+    for _, name, _ in functions:
+      bundle.write(name)
+    for entry, (_, _, data) in zip(entries, functions):
+      bundle.write(b"\0" * (entry[4] - bundle.tell()))
+      bundle.write(data)
+
+if __name__ == '__main__':
+  Main()